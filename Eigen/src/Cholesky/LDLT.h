@@ -401,6 +401,150 @@ template<> struct ldlt_inplace<Lower>
     return ret;
   }
 
+  template<typename MatrixType, typename TranspositionType, typename Workspace>
+  static bool blocked(MatrixType& mat, TranspositionType& transpositions, Workspace& temp, SignMatrix& sign)
+  {
+    using std::abs;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef typename TranspositionType::StorageIndex IndexType;
+    eigen_assert(mat.rows()==mat.cols());
+    const Index size = mat.rows();
+    if(size<32)
+      return unblocked(mat, transpositions, temp, sign);
+
+    Index blockSize = size/8;
+    blockSize = (blockSize/16)*16;
+    blockSize = (std::min)((std::max)(blockSize,Index(8)), Index(128));
+
+    // The pivots are chosen exactly as in unblocked(), i.e., on the magnitude of the
+    // original diagonal entries. Since the trailing updates overwrite the diagonal,
+    // its magnitude is saved beforehand and permuted along with the matrix.
+    Matrix<RealScalar,Dynamic,1> pivot_keys = mat.diagonal().cwiseAbs();
+    Matrix<Scalar,Dynamic,Dynamic> W(size, blockSize);
+    bool found_zero_pivot = false;
+    bool ret = true;
+
+    for (Index k0 = 0; k0 < size; k0 += blockSize)
+    {
+      const Index bs = (std::min)(blockSize, size-k0);
+
+      // Left-looking factorization of the panel mat(k0:size, k0:k0+bs): each column
+      // only has to catch up with the updates of the previous columns of the panel,
+      // the ones of the previous panels having been applied to the trailing matrix.
+      for (Index k = k0; k < k0+bs; ++k)
+      {
+        Index index_of_biggest_in_corner;
+        pivot_keys.tail(size-k).maxCoeff(&index_of_biggest_in_corner);
+        index_of_biggest_in_corner += k;
+
+        transpositions.coeffRef(k) = IndexType(index_of_biggest_in_corner);
+        if(k != index_of_biggest_in_corner)
+        {
+          // apply the transposition while taking care to consider only
+          // the lower triangular part
+          Index s = size-index_of_biggest_in_corner-1; // trailing size after the biggest element
+          mat.row(k).head(k).swap(mat.row(index_of_biggest_in_corner).head(k));
+          mat.col(k).tail(s).swap(mat.col(index_of_biggest_in_corner).tail(s));
+          std::swap(mat.coeffRef(k,k),mat.coeffRef(index_of_biggest_in_corner,index_of_biggest_in_corner));
+          for(Index i=k+1;i<index_of_biggest_in_corner;++i)
+          {
+            Scalar tmp = mat.coeffRef(i,k);
+            mat.coeffRef(i,k) = numext::conj(mat.coeffRef(index_of_biggest_in_corner,i));
+            mat.coeffRef(index_of_biggest_in_corner,i) = numext::conj(tmp);
+          }
+          if(NumTraits<Scalar>::IsComplex)
+            mat.coeffRef(index_of_biggest_in_corner,k) = numext::conj(mat.coeff(index_of_biggest_in_corner,k));
+          std::swap(pivot_keys.coeffRef(k), pivot_keys.coeffRef(index_of_biggest_in_corner));
+        }
+
+        // partition the panel:
+        //       A00 |  -  |  -
+        // lu  = A10 | A11 |  -
+        //       A20 | A21 | A22
+        // where A10 and A20 only span the already factorized columns of the panel.
+        Index rs = size - k - 1;
+        Index ks = k - k0;
+        Block<MatrixType,Dynamic,1> A21(mat,k+1,k,rs,1);
+        Block<MatrixType,1,Dynamic> A10(mat,k,k0,1,ks);
+        Block<MatrixType,Dynamic,Dynamic> A20(mat,k+1,k0,rs,ks);
+
+        if(ks>0)
+        {
+          temp.head(ks) = mat.diagonal().real().segment(k0,ks).asDiagonal() * A10.adjoint();
+          mat.coeffRef(k,k) -= (A10 * temp.head(ks)).value();
+          if(rs>0)
+            A21.noalias() -= A20 * temp.head(ks);
+        }
+
+        RealScalar realAkk = numext::real(mat.coeffRef(k,k));
+        bool pivot_is_valid = (abs(realAkk) > RealScalar(0));
+
+        if(k==0 && !pivot_is_valid)
+        {
+          // The entire diagonal is zero, there is nothing more to do
+          // except filling the transpositions, and checking whether the matrix is zero.
+          sign = ZeroSign;
+          for(Index j = 0; j<size; ++j)
+          {
+            transpositions.coeffRef(j) = IndexType(j);
+            ret = ret && (mat.col(j).tail(size-j-1).array()==Scalar(0)).all();
+          }
+          return ret;
+        }
+
+        if((rs>0) && pivot_is_valid)
+          A21 /= realAkk;
+        else if(rs>0)
+          ret = ret && (A21.array()==Scalar(0)).all();
+
+        if(found_zero_pivot && pivot_is_valid) ret = false; // factorization failed
+        else if(!pivot_is_valid) found_zero_pivot = true;
+
+        if (sign == PositiveSemiDef) {
+          if (realAkk < static_cast<RealScalar>(0)) sign = Indefinite;
+        } else if (sign == NegativeSemiDef) {
+          if (realAkk > static_cast<RealScalar>(0)) sign = Indefinite;
+        } else if (sign == ZeroSign) {
+          if (realAkk > static_cast<RealScalar>(0)) sign = PositiveSemiDef;
+          else if (realAkk < static_cast<RealScalar>(0)) sign = NegativeSemiDef;
+        }
+      }
+
+      // Right-looking update of the trailing matrix: A22 -= L21 * D1 * L21^*
+      const Index k1 = k0 + bs;
+      const Index rs = size - k1;
+      if(rs>0)
+      {
+        W.topLeftCorner(rs,bs).noalias() = mat.block(k1,k0,rs,bs) * mat.diagonal().real().segment(k0,bs).asDiagonal();
+        trailing_update(mat, W, k0, bs, k1, rs);
+      }
+    }
+
+    return ret;
+  }
+
+  // Applies mat(start:start+n, start:start+n) -= W * L^* to the lower triangular part,
+  // where L = mat(start:start+n, k0:k0+bs) and W holds L * D row-wise from row k0+bs.
+  // The triangle is split recursively so that most of the flops are performed by
+  // general matrix products, which can be parallelized, rather than by the
+  // triangular product kernel.
+  template<typename MatrixType, typename WorkspaceType>
+  static void trailing_update(MatrixType& mat, const WorkspaceType& W, Index k0, Index bs, Index start, Index n)
+  {
+    const Index w0 = start - (k0 + bs);
+    if(n <= 256)
+    {
+      mat.block(start,start,n,n).template triangularView<Lower>()
+        -= W.block(w0,0,n,bs) * mat.block(start,k0,n,bs).adjoint();
+      return;
+    }
+    const Index h = (n/2/16)*16;
+    trailing_update(mat, W, k0, bs, start, h);
+    mat.block(start+h,start,n-h,h).noalias() -= W.block(w0+h,0,n-h,bs) * mat.block(start,k0,h,bs).adjoint();
+    trailing_update(mat, W, k0, bs, start+h, n-h);
+  }
+
   // Reference for the algorithm: Davis and Hager, "Multiple Rank
   // Modifications of a Sparse Cholesky Factorization" (Algorithm 1)
   // Trivial rearrangements of their computations (Timothy E. Holy)
@@ -465,6 +609,13 @@ template<> struct ldlt_inplace<Upper>
     return ldlt_inplace<Lower>::unblocked(matt, transpositions, temp, sign);
   }
 
+  template<typename MatrixType, typename TranspositionType, typename Workspace>
+  static EIGEN_STRONG_INLINE bool blocked(MatrixType& mat, TranspositionType& transpositions, Workspace& temp, SignMatrix& sign)
+  {
+    Transpose<MatrixType> matt(mat);
+    return ldlt_inplace<Lower>::blocked(matt, transpositions, temp, sign);
+  }
+
   template<typename MatrixType, typename TranspositionType, typename Workspace, typename WType>
   static EIGEN_STRONG_INLINE bool update(MatrixType& mat, TranspositionType& transpositions, Workspace& tmp, WType& w, const typename MatrixType::RealScalar& sigma=1)
   {
@@ -520,7 +671,7 @@ LDLT<MatrixType,UpLo_>& LDLT<MatrixType,UpLo_>::compute(const EigenBase<InputTyp
   m_temporary.resize(size);
   m_sign = internal::ZeroSign;
 
-  m_info = internal::ldlt_inplace<UpLo>::unblocked(m_matrix, m_transpositions, m_temporary, m_sign) ? Success : NumericalIssue;
+  m_info = internal::ldlt_inplace<UpLo>::blocked(m_matrix, m_transpositions, m_temporary, m_sign) ? Success : NumericalIssue;
 
   m_isInitialized = true;
   return *this;
@@ -369,6 +369,7 @@ template<typename Derived> class DenseBase
     EIGEN_DEVICE_FUNC Derived& setZero();
     EIGEN_DEVICE_FUNC Derived& setOnes();
     EIGEN_DEVICE_FUNC Derived& setRandom();
+    Derived& setCounterRandom(numext::uint64_t seed);
 
     template<typename OtherDerived> EIGEN_DEVICE_FUNC
     bool isApprox(const DenseBase<OtherDerived>& other,
@@ -433,6 +434,9 @@ template<typename Derived> class DenseBase
       call_assignment(derived(), other.derived(), internal::swap_assign_op<Scalar>());
     }
 
+    inline ParallelAssign<Derived> parallel();
+    inline ParallelAssign<const Derived> parallel() const;
+
     EIGEN_DEVICE_FUNC inline const NestByValue<Derived> nestByValue() const;
     EIGEN_DEVICE_FUNC inline const ForceAlignedAccess<Derived> forceAlignedAccess() const;
     EIGEN_DEVICE_FUNC inline ForceAlignedAccess<Derived> forceAlignedAccess();
@@ -567,6 +571,11 @@ template<typename Derived> class DenseBase
     static const RandomReturnType Random(Index size);
     static const RandomReturnType Random();
 
+    typedef CwiseNullaryOp<internal::scalar_counter_random_op<Scalar>,PlainObject> CounterRandomReturnType;
+    static const CounterRandomReturnType CounterRandom(Index rows, Index cols, numext::uint64_t seed);
+    static const CounterRandomReturnType CounterRandom(Index size, numext::uint64_t seed);
+    static const CounterRandomReturnType CounterRandom(numext::uint64_t seed);
+
     template <typename ThenDerived, typename ElseDerived>
     inline EIGEN_DEVICE_FUNC
         CwiseTernaryOp<internal::scalar_boolean_select_op<typename DenseBase<ThenDerived>::Scalar,
@@ -0,0 +1,501 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_PARALLEL_ASSIGN_H
+#define EIGEN_PARALLEL_ASSIGN_H
+
+#include "./InternalHeaderCheck.h"
+
+namespace Eigen {
+
+namespace internal {
+
+// Minimal amount of work, in units of functor_traits<>::Cost, given to each task of a parallel assignment.
+enum { ParallelAssignMinTaskCost = 1<<16 };
+
+// parallel_dense_assignment_loop splits the loops of dense_assignment_loop over parallelize_tasks().
+// maxTasks() bounds the number of independent pieces of work, and run() processes them with \a tasks tasks.
+// Unrolled loops are only generated for small fixed sizes, and are never split.
+
+template<typename Kernel,
+         int Traversal = Kernel::AssignmentTraits::Traversal,
+         int Unrolling = Kernel::AssignmentTraits::Unrolling>
+struct parallel_dense_assignment_loop
+{
+  static Index maxTasks(const Kernel&) { return 1; }
+  static void run(Kernel &kernel, Index) { dense_assignment_loop<Kernel>::run(kernel); }
+};
+
+// The packets of the aligned part are shared among the tasks, so that each chunk starts on an aligned address,
+// while the first and the last tasks also take the unaligned head and tail.
+template<typename Kernel>
+struct parallel_dense_assignment_loop<Kernel, LinearVectorizedTraversal, NoUnrolling>
+{
+  typedef typename Kernel::Scalar Scalar;
+  typedef typename Kernel::PacketType PacketType;
+  enum {
+    requestedAlignment = Kernel::AssignmentTraits::LinearRequiredAlignment,
+    packetSize = unpacket_traits<PacketType>::size,
+    dstIsAligned = int(Kernel::AssignmentTraits::DstAlignment)>=int(requestedAlignment),
+    dstAlignment = packet_traits<Scalar>::AlignedOnScalar ? int(requestedAlignment)
+                                                          : int(Kernel::AssignmentTraits::DstAlignment),
+    srcAlignment = Kernel::AssignmentTraits::JointAlignment
+  };
+
+  static Index maxTasks(const Kernel& kernel) { return kernel.size()/packetSize; }
+
+  static void run(Kernel &kernel, Index tasks)
+  {
+    const Index size = kernel.size();
+    const Index alignedStart = dstIsAligned ? 0 : internal::first_aligned<requestedAlignment>(kernel.dstDataPtr(), size);
+    const Index packets = (size-alignedStart)/packetSize;
+    const Index alignedEnd = alignedStart + packets*packetSize;
+
+    parallelize_tasks(tasks, [&](Index t) {
+      if(t==0)
+        unaligned_dense_assignment_loop<dstIsAligned!=0>::run(kernel, 0, alignedStart);
+
+      const Index begin = alignedStart + ((packets*t)/tasks)*packetSize;
+      const Index end = alignedStart + ((packets*(t+1))/tasks)*packetSize;
+      for(Index index = begin; index < end; index += packetSize)
+        kernel.template assignPacket<dstAlignment, srcAlignment, PacketType>(index);
+
+      if(t==tasks-1)
+        unaligned_dense_assignment_loop<>::run(kernel, alignedEnd, size);
+    });
+  }
+};
+
+template<typename Kernel>
+struct parallel_dense_assignment_loop<Kernel, LinearTraversal, NoUnrolling>
+{
+  static Index maxTasks(const Kernel& kernel) { return kernel.size(); }
+
+  static void run(Kernel &kernel, Index tasks)
+  {
+    const Index size = kernel.size();
+    parallelize_tasks(tasks, [&](Index t) {
+      const Index end = (size*(t+1))/tasks;
+      for(Index i = (size*t)/tasks; i < end; ++i)
+        kernel.assignCoeff(i);
+    });
+  }
+};
+
+// The remaining traversals process the destination by inner vectors, which are shared among the tasks.
+template<typename Kernel>
+struct parallel_dense_assignment_loop<Kernel, DefaultTraversal, NoUnrolling>
+{
+  static Index maxTasks(const Kernel& kernel) { return kernel.outerSize(); }
+
+  static void run(Kernel &kernel, Index tasks)
+  {
+    const Index innerSize = kernel.innerSize();
+    const Index outerSize = kernel.outerSize();
+    parallelize_tasks(tasks, [&](Index t) {
+      const Index end = (outerSize*(t+1))/tasks;
+      for(Index outer = (outerSize*t)/tasks; outer < end; ++outer)
+        for(Index inner = 0; inner < innerSize; ++inner)
+          kernel.assignCoeffByOuterInner(outer, inner);
+    });
+  }
+};
+
+template<typename Kernel>
+struct parallel_dense_assignment_loop<Kernel, InnerVectorizedTraversal, NoUnrolling>
+{
+  typedef typename Kernel::PacketType PacketType;
+  enum {
+    SrcAlignment = Kernel::AssignmentTraits::SrcAlignment,
+    DstAlignment = Kernel::AssignmentTraits::DstAlignment
+  };
+
+  static Index maxTasks(const Kernel& kernel) { return kernel.outerSize(); }
+
+  static void run(Kernel &kernel, Index tasks)
+  {
+    const Index innerSize = kernel.innerSize();
+    const Index outerSize = kernel.outerSize();
+    const Index packetSize = unpacket_traits<PacketType>::size;
+    parallelize_tasks(tasks, [&](Index t) {
+      const Index end = (outerSize*(t+1))/tasks;
+      for(Index outer = (outerSize*t)/tasks; outer < end; ++outer)
+        for(Index inner = 0; inner < innerSize; inner+=packetSize)
+          kernel.template assignPacketByOuterInner<DstAlignment, SrcAlignment, PacketType>(outer, inner);
+    });
+  }
+};
+
+template<typename Kernel>
+struct parallel_dense_assignment_loop<Kernel, SliceVectorizedTraversal, NoUnrolling>
+{
+  typedef typename Kernel::Scalar Scalar;
+  typedef typename Kernel::PacketType PacketType;
+  enum {
+    packetSize = unpacket_traits<PacketType>::size,
+    requestedAlignment = int(Kernel::AssignmentTraits::InnerRequiredAlignment),
+    alignable = packet_traits<Scalar>::AlignedOnScalar || int(Kernel::AssignmentTraits::DstAlignment)>=sizeof(Scalar),
+    dstIsAligned = int(Kernel::AssignmentTraits::DstAlignment)>=int(requestedAlignment),
+    dstAlignment = alignable ? int(requestedAlignment)
+                             : int(Kernel::AssignmentTraits::DstAlignment)
+  };
+
+  static Index maxTasks(const Kernel& kernel) { return kernel.outerSize(); }
+
+  static void run(Kernel &kernel, Index tasks)
+  {
+    const Scalar *dst_ptr = kernel.dstDataPtr();
+    if((!bool(dstIsAligned)) && (std::uintptr_t(dst_ptr) % sizeof(Scalar))>0)
+    {
+      // the pointer is not aligned-on scalar, so alignment is not possible
+      return parallel_dense_assignment_loop<Kernel,DefaultTraversal,NoUnrolling>::run(kernel, tasks);
+    }
+    const Index packetAlignedMask = packetSize - 1;
+    const Index innerSize = kernel.innerSize();
+    const Index outerSize = kernel.outerSize();
+    const Index alignedStep = alignable ? (packetSize - kernel.outerStride() % packetSize) & packetAlignedMask : 0;
+    const Index firstAlignedStart = ((!alignable) || bool(dstIsAligned)) ? 0 : internal::first_aligned<requestedAlignment>(dst_ptr, innerSize);
+
+    parallelize_tasks(tasks, [&](Index t) {
+      const Index begin = (outerSize*t)/tasks, end = (outerSize*(t+1))/tasks;
+      // the alignment of the inner vectors repeats every packetSize of them
+      Index alignedStart = numext::mini((firstAlignedStart + (begin%packetSize)*alignedStep)%packetSize, innerSize);
+      for(Index outer = begin; outer < end; ++outer)
+      {
+        const Index alignedEnd = alignedStart + ((innerSize-alignedStart) & ~packetAlignedMask);
+        for(Index inner = 0; inner<alignedStart ; ++inner)
+          kernel.assignCoeffByOuterInner(outer, inner);
+
+        for(Index inner = alignedStart; inner<alignedEnd; inner+=packetSize)
+          kernel.template assignPacketByOuterInner<dstAlignment, Unaligned, PacketType>(outer, inner);
+
+        for(Index inner = alignedEnd; inner<innerSize ; ++inner)
+          kernel.assignCoeffByOuterInner(outer, inner);
+
+        alignedStart = numext::mini((alignedStart+alignedStep)%packetSize, innerSize);
+      }
+    });
+  }
+};
+
+template<typename DstXprType, typename SrcXprType, typename Functor>
+void call_parallel_dense_assignment_loop(DstXprType& dst, const SrcXprType& src, const Functor &func)
+{
+  typedef evaluator<DstXprType> DstEvaluatorType;
+  typedef evaluator<SrcXprType> SrcEvaluatorType;
+
+  SrcEvaluatorType srcEvaluator(src);
+
+  // see call_dense_assignment_loop
+  resize_if_allowed(dst, src, func);
+
+  DstEvaluatorType dstEvaluator(dst);
+
+  typedef generic_dense_assignment_kernel<DstEvaluatorType,SrcEvaluatorType,Functor> Kernel;
+  typedef parallel_dense_assignment_loop<Kernel> Loop;
+  Kernel kernel(dstEvaluator, srcEvaluator, func, dst.const_cast_derived());
+
+  // Split the work into tasks of at least ParallelAssignMinTaskCost, as estimated from the cost of
+  // evaluating one coefficient of the source and of assigning it.
+  enum { CoeffCost = int(SrcEvaluatorType::CoeffReadCost) + int(functor_traits<Functor>::Cost) };
+  const double work = double(dst.size()) * double(CoeffCost);
+  Index tasks = parallel_loop_threads();
+  if(tasks>1)
+    tasks = numext::mini(tasks, numext::mini(static_cast<Index>(work / double(ParallelAssignMinTaskCost)), Loop::maxTasks(kernel)));
+
+  if(tasks<=1)
+    dense_assignment_loop<Kernel>::run(kernel);
+  else
+    Loop::run(kernel, tasks);
+}
+
+// Sources which are not coefficient-wise dense expressions, like products, are assigned as usual.
+template<typename Dst, typename Src, typename Func>
+void call_parallel_assignment(Dst& dst, const Src& src, const Func& func,
+                              std::enable_if_t< evaluator_assume_aliasing<Src>::value
+                                            || !is_same<typename AssignmentKind<typename evaluator_traits<Dst>::Shape,
+                                                                                typename evaluator_traits<Src>::Shape>::Kind,
+                                                        Dense2Dense>::value, void*> = 0)
+{
+  call_assignment(dst, src, func);
+}
+
+template<typename Dst, typename Src, typename Func>
+void call_parallel_assignment(Dst& dst, const Src& src, const Func& func,
+                              std::enable_if_t<!evaluator_assume_aliasing<Src>::value
+                                            && is_same<typename AssignmentKind<typename evaluator_traits<Dst>::Shape,
+                                                                               typename evaluator_traits<Src>::Shape>::Kind,
+                                                       Dense2Dense>::value, void*> = 0)
+{
+  enum {
+    NeedToTranspose = (    (int(Dst::RowsAtCompileTime) == 1 && int(Src::ColsAtCompileTime) == 1)
+                        || (int(Dst::ColsAtCompileTime) == 1 && int(Src::RowsAtCompileTime) == 1)
+                      ) && int(Dst::SizeAtCompileTime) != 1
+  };
+
+  typedef std::conditional_t<NeedToTranspose, Transpose<Dst>, Dst> ActualDstTypeCleaned;
+  typedef std::conditional_t<NeedToTranspose, Transpose<Dst>, Dst&> ActualDstType;
+  ActualDstType actualDst(dst);
+
+  EIGEN_STATIC_ASSERT_LVALUE(Dst)
+  EIGEN_STATIC_ASSERT_SAME_MATRIX_SIZE(ActualDstTypeCleaned,Src)
+  EIGEN_CHECK_BINARY_COMPATIBILIY(Func,typename ActualDstTypeCleaned::Scalar,typename Src::Scalar);
+
+#ifndef EIGEN_NO_DEBUG
+  internal::check_for_aliasing(actualDst, src);
+#endif
+
+  call_parallel_dense_assignment_loop(actualDst, src, func);
+}
+
+} // end namespace internal
+
+/** \class ParallelAssign
+  * \ingroup Core_Module
+  *
+  * \brief Pseudo expression providing assignment operators and reductions evaluated by several threads
+  *
+  * \tparam ExpressionType the type of the object on which to do the assignment or the reduction
+  *
+  * This class represents an expression with special assignment operators which split the
+  * evaluation of the source expression over the threads reserved for %Eigen, and with reductions
+  * which split the evaluation of the expression itself.
+  * It is the return type of DenseBase::parallel()
+  * and most of the time this is the only way it is used.
+  *
+  * \sa DenseBase::parallel()
+  */
+template<typename ExpressionType>
+class ParallelAssign
+{
+  public:
+    typedef typename ExpressionType::Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef std::remove_const_t<ExpressionType> PlainExpressionType;
+
+    explicit ParallelAssign(ExpressionType& expression) : m_expression(expression) {}
+
+    template<typename OtherDerived>
+    EIGEN_STRONG_INLINE ExpressionType& operator=(const DenseBase<OtherDerived>& other)
+    {
+      internal::call_parallel_assignment(m_expression, other.derived(), internal::assign_op<Scalar,typename OtherDerived::Scalar>());
+      return m_expression;
+    }
+
+    template<typename OtherDerived>
+    EIGEN_STRONG_INLINE ExpressionType& operator+=(const DenseBase<OtherDerived>& other)
+    {
+      internal::call_parallel_assignment(m_expression, other.derived(), internal::add_assign_op<Scalar,typename OtherDerived::Scalar>());
+      return m_expression;
+    }
+
+    template<typename OtherDerived>
+    EIGEN_STRONG_INLINE ExpressionType& operator-=(const DenseBase<OtherDerived>& other)
+    {
+      internal::call_parallel_assignment(m_expression, other.derived(), internal::sub_assign_op<Scalar,typename OtherDerived::Scalar>());
+      return m_expression;
+    }
+
+    /** \returns the result of the reduction of the expression with \a func as DenseBase::redux(), computed by blocks
+      * of fixed size which may run on different threads and are combined in a fixed order. */
+    template<typename Func>
+    Scalar redux(const Func& func) const
+    {
+      return internal::parallel_redux(m_expression, func);
+    }
+
+    /** \returns the sum of all coefficients, computed as redux() \sa DenseBase::sum() */
+    Scalar sum() const
+    {
+      if(m_expression.size()==0)
+        return Scalar(0);
+      return internal::parallel_redux(m_expression, internal::scalar_sum_op<Scalar,Scalar>());
+    }
+
+    /** \returns the product of all coefficients, computed as redux() \sa DenseBase::prod() */
+    Scalar prod() const
+    {
+      if(m_expression.size()==0)
+        return Scalar(1);
+      return internal::parallel_redux(m_expression, internal::scalar_product_op<Scalar>());
+    }
+
+    /** \returns the minimum of all coefficients, computed as redux() \sa DenseBase::minCoeff() */
+    template<int NaNPropagation = PropagateFast>
+    Scalar minCoeff() const
+    {
+      return internal::parallel_redux(m_expression, internal::scalar_min_op<Scalar,Scalar,NaNPropagation>());
+    }
+
+    /** \returns the maximum of all coefficients, computed as redux() \sa DenseBase::maxCoeff() */
+    template<int NaNPropagation = PropagateFast>
+    Scalar maxCoeff() const
+    {
+      return internal::parallel_redux(m_expression, internal::scalar_max_op<Scalar,Scalar,NaNPropagation>());
+    }
+
+    /** \returns the minimum of all coefficients and puts in \a *row and \a *col the location of its first occurrence,
+      * computed by blocks as redux() \sa DenseBase::minCoeff(IndexType*,IndexType*) */
+    template<int NaNPropagation = PropagateFast, typename IndexType>
+    Scalar minCoeff(IndexType* row, IndexType* col) const
+    {
+      eigen_assert(m_expression.rows()>0 && m_expression.cols()>0 && "you are using an empty matrix");
+      internal::minmax_coeff_visitor<PlainExpressionType, true, NaNPropagation> minVisitor;
+      internal::parallel_visit(m_expression, minVisitor);
+      *row = IndexType(minVisitor.row);
+      if(col) *col = IndexType(minVisitor.col);
+      return minVisitor.res;
+    }
+
+    /** \returns the maximum of all coefficients and puts in \a *row and \a *col the location of its first occurrence,
+      * computed by blocks as redux() \sa DenseBase::maxCoeff(IndexType*,IndexType*) */
+    template<int NaNPropagation = PropagateFast, typename IndexType>
+    Scalar maxCoeff(IndexType* row, IndexType* col) const
+    {
+      eigen_assert(m_expression.rows()>0 && m_expression.cols()>0 && "you are using an empty matrix");
+      internal::minmax_coeff_visitor<PlainExpressionType, false, NaNPropagation> maxVisitor;
+      internal::parallel_visit(m_expression, maxVisitor);
+      *row = IndexType(maxVisitor.row);
+      if(col) *col = IndexType(maxVisitor.col);
+      return maxVisitor.res;
+    }
+
+    /** \returns the minimum of all coefficients of a vector and puts in \a *index the location of its first
+      * occurrence \sa DenseBase::minCoeff(IndexType*) */
+    template<int NaNPropagation = PropagateFast, typename IndexType>
+    Scalar minCoeff(IndexType* index) const
+    {
+      EIGEN_STATIC_ASSERT_VECTOR_ONLY(PlainExpressionType)
+      IndexType row, col;
+      const Scalar res = minCoeff<NaNPropagation>(&row, &col);
+      *index = (PlainExpressionType::RowsAtCompileTime==1) ? col : row;
+      return res;
+    }
+
+    /** \returns the maximum of all coefficients of a vector and puts in \a *index the location of its first
+      * occurrence \sa DenseBase::maxCoeff(IndexType*) */
+    template<int NaNPropagation = PropagateFast, typename IndexType>
+    Scalar maxCoeff(IndexType* index) const
+    {
+      EIGEN_STATIC_ASSERT_VECTOR_ONLY(PlainExpressionType)
+      IndexType row, col;
+      const Scalar res = maxCoeff<NaNPropagation>(&row, &col);
+      *index = (PlainExpressionType::RowsAtCompileTime==1) ? col : row;
+      return res;
+    }
+
+    /** \returns the dot product of a vector with \a other, computed as redux() \sa MatrixBase::dot() */
+    template<typename OtherDerived>
+    typename ScalarBinaryOpTraits<Scalar, typename internal::traits<OtherDerived>::Scalar>::ReturnType
+    dot(const MatrixBase<OtherDerived>& other) const
+    {
+      EIGEN_STATIC_ASSERT_VECTOR_ONLY(PlainExpressionType)
+      EIGEN_STATIC_ASSERT_VECTOR_ONLY(OtherDerived)
+      EIGEN_STATIC_ASSERT_SAME_VECTOR_SIZE(PlainExpressionType,OtherDerived)
+      typedef internal::scalar_conj_product_op<Scalar, typename OtherDerived::Scalar> ProductOp;
+      typedef typename ProductOp::result_type ResScalar;
+      // see internal::dot_nocheck
+      enum {
+        NeedToTranspose = (int(PlainExpressionType::RowsAtCompileTime) == 1 && int(OtherDerived::ColsAtCompileTime) == 1)
+                       || (int(PlainExpressionType::ColsAtCompileTime) == 1 && int(OtherDerived::RowsAtCompileTime) == 1)
+      };
+      typedef std::conditional_t<NeedToTranspose, Transpose<const PlainExpressionType>, const PlainExpressionType&> Lhs;
+      eigen_assert(m_expression.size() == other.size());
+      if(m_expression.size()==0)
+        return ResScalar(0);
+      Lhs lhs(m_expression);
+      return internal::parallel_redux(lhs.binaryExpr(other.derived(), ProductOp()),
+                                      internal::scalar_sum_op<ResScalar,ResScalar>());
+    }
+
+    /** \returns the squared \em l2 norm, computed as redux() \sa MatrixBase::squaredNorm() */
+    RealScalar squaredNorm() const
+    {
+      if(m_expression.size()==0)
+        return RealScalar(0);
+      return internal::parallel_redux(m_expression.unaryExpr(internal::scalar_abs2_op<Scalar>()),
+                                      internal::scalar_sum_op<RealScalar,RealScalar>());
+    }
+
+    /** \returns the \em l2 norm, computed as redux() \sa MatrixBase::norm() */
+    RealScalar norm() const
+    {
+      return numext::sqrt(squaredNorm());
+    }
+
+    /** \returns the \em l2 norm avoiding underflow and overflow as MatrixBase::stableNorm(), computed by blocks
+      * of fixed size which may run on different threads and are combined in a fixed order. */
+    RealScalar stableNorm() const
+    {
+      RealScalar res;
+      if(internal::parallel_stable_norm_impl(m_expression, res))
+        return res;
+      return internal::stable_norm_impl(m_expression);
+    }
+
+    /** \returns the \em l2 norm computed with the Blue's algorithm as MatrixBase::blueNorm(), whose sums of
+      * squares are computed by blocks as stableNorm(). */
+    RealScalar blueNorm() const
+    {
+      return internal::blueNorm_impl<true>(m_expression);
+    }
+
+    ExpressionType& expression() const
+    {
+      return m_expression;
+    }
+
+  protected:
+    ExpressionType& m_expression;
+};
+
+/** \returns a pseudo expression of \c *this whose assignment operators evaluate the source expression
+  * with several threads, and whose reductions evaluate \c *this with several threads.
+  *
+  * The destination is split into contiguous chunks, one per task, and each chunk is evaluated with the same
+  * vectorized loop as a regular assignment, starting on a packet boundary. The number of tasks is bounded
+  * by nbThreads() and by the estimated cost of the expression, such that small or cheap assignments
+  * still run on the calling thread. As for products, the threads come from OpenMP or from the pool
+  * registered with setGemmThreadPool() (see \ref TopicMultiThreading).
+  * \code
+  * A.parallel()  = (B.array() * C.array()).exp().matrix();
+  * x.parallel() += alpha * y;
+  * \endcode
+  *
+  * Products and other expressions assumed to alias the destination are evaluated as by a regular assignment.
+  * The coefficients of the source expression are evaluated concurrently, in an unspecified order: the source
+  * must not depend on the coefficients of the destination written by other chunks, and must be safe to
+  * evaluate from several threads. In particular, DenseBase::Random() is not, while DenseBase::CounterRandom() is.
+  *
+  * Large dynamic size expressions can also be reduced with several threads, by the reductions of the returned
+  * pseudo expression, e.g. sum(), squaredNorm(), stableNorm(), or minCoeff() and maxCoeff() with their locations:
+  * \code
+  * double s = (x.array() * y.array()).parallel().sum();
+  * double m = A.parallel().maxCoeff(&i, &j);
+  * \endcode
+  * They are computed by blocks of fixed size combined in a fixed order, so that their results do not depend on the
+  * number of threads, but may slightly differ from the ones of the sequential reductions. Expressions which must be
+  * evaluated before nesting, such as DenseBase::Random(), are reduced sequentially.
+  *
+  * \sa class ParallelAssign, setNbThreads()
+  */
+template<typename Derived>
+inline ParallelAssign<Derived> DenseBase<Derived>::parallel()
+{
+  return ParallelAssign<Derived>(derived());
+}
+
+/** This is the const version of parallel(), whose pseudo expression only provides the reductions. */
+template<typename Derived>
+inline ParallelAssign<const Derived> DenseBase<Derived>::parallel() const
+{
+  return ParallelAssign<const Derived>(derived());
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_PARALLEL_ASSIGN_H
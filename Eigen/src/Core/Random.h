@@ -24,6 +24,213 @@ template<typename Scalar>
 struct functor_traits<scalar_random_op<Scalar> >
 { enum { Cost = 5 * NumTraits<Scalar>::MulCost, PacketAccess = false, IsRepeatable = false }; };
 
+/** \internal One round of Threefry-2x32 on \a N independent blocks. */
+template<int N, int R>
+EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void threefry2x32_round(numext::uint32_t* x0, numext::uint32_t* x1)
+{
+  for(int b=0; b<N; ++b)
+  {
+    x0[b] += x1[b];
+    x1[b] = (x1[b] << R) | (x1[b] >> (32-R));
+    x1[b] ^= x0[b];
+  }
+}
+
+/** \internal Four rounds of Threefry-2x32 followed by the injection of the key schedule \a s. */
+template<int N, int R0, int R1, int R2, int R3>
+EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void threefry2x32_rounds4(numext::uint32_t* x0, numext::uint32_t* x1,
+                                                                numext::uint32_t k0, numext::uint32_t k1,
+                                                                numext::uint32_t s)
+{
+  threefry2x32_round<N,R0>(x0, x1);
+  threefry2x32_round<N,R1>(x0, x1);
+  threefry2x32_round<N,R2>(x0, x1);
+  threefry2x32_round<N,R3>(x0, x1);
+  for(int b=0; b<N; ++b)
+  {
+    x0[b] += k0;
+    x1[b] += k1 + s;
+  }
+}
+
+/** \internal
+  * Threefry-2x32-20 counter-based generator (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC'11).
+  * Each of the \a NumBlocks 64-bit counters \a blocks is mapped to two independent 32-bit words by twenty
+  * add-rotate-xor rounds keyed by \a key, and the words of block \c b are written to \c out[2*b..2*b+1].
+  * The blocks are processed as structures of arrays of compile-time size: as the rounds only use 32-bit
+  * additions, shifts and xors, the compiler runs them on full SIMD registers for all the blocks of a packet.
+  */
+template<int NumBlocks>
+EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void threefry2x32_20(const numext::uint64_t* blocks, numext::uint64_t key,
+                                                           numext::uint32_t* out)
+{
+  typedef numext::uint32_t uint32_t;
+  const uint32_t ks0 = static_cast<uint32_t>(key);
+  const uint32_t ks1 = static_cast<uint32_t>(key >> 32);
+  const uint32_t ks2 = 0x1BD11BDAu ^ ks0 ^ ks1;
+  uint32_t x0[NumBlocks], x1[NumBlocks];
+  for(int b=0; b<NumBlocks; ++b)
+  {
+    x0[b] = static_cast<uint32_t>(blocks[b]) + ks0;
+    x1[b] = static_cast<uint32_t>(blocks[b] >> 32) + ks1;
+  }
+  threefry2x32_rounds4<NumBlocks,13,15,26, 6>(x0, x1, ks1, ks2, 1);
+  threefry2x32_rounds4<NumBlocks,17,29,16,24>(x0, x1, ks2, ks0, 2);
+  threefry2x32_rounds4<NumBlocks,13,15,26, 6>(x0, x1, ks0, ks1, 3);
+  threefry2x32_rounds4<NumBlocks,17,29,16,24>(x0, x1, ks1, ks2, 4);
+  threefry2x32_rounds4<NumBlocks,13,15,26, 6>(x0, x1, ks2, ks0, 5);
+  for(int b=0; b<NumBlocks; ++b)
+  {
+    out[2*b+0] = x0[b];
+    out[2*b+1] = x1[b];
+  }
+}
+
+/** \internal Converts the random words of one coefficient to a scalar.
+  * Floating point values are uniform in [0,1), or in [-1,1) if \a Symmetric is true,
+  * and integers take the raw bits so that they span their whole range. */
+template<typename Scalar, bool IsInteger = NumTraits<Scalar>::IsInteger, bool IsComplex = NumTraits<Scalar>::IsComplex>
+struct counter_random_bits
+{
+  enum { Words = 1 };
+  template<bool Symmetric>
+  EIGEN_DEVICE_FUNC static EIGEN_STRONG_INLINE Scalar run(const numext::uint32_t* w)
+  {
+    // Keep as many bits as the mantissa holds, so that the conversion is exact and 1 is never reached.
+    const int digits = NumTraits<Scalar>::digits() < 24 ? NumTraits<Scalar>::digits() : 24;
+    const float u = float(w[0] >> (32-digits)) * (1.f / float(1u << digits));
+    return Scalar(Symmetric ? 2.f*u - 1.f : u);
+  }
+};
+
+template<>
+struct counter_random_bits<double,false,false>
+{
+  enum { Words = 2 };
+  template<bool Symmetric>
+  EIGEN_DEVICE_FUNC static EIGEN_STRONG_INLINE double run(const numext::uint32_t* w)
+  {
+    // Fill the mantissa of a number in [1,2), which needs no integer to floating point conversion.
+    const numext::uint64_t bits = (numext::uint64_t(w[0]) << 20) ^ w[1];
+    const double u = numext::bit_cast<double>((bits & 0xfffffffffffffull) | 0x3ff0000000000000ull) - 1.;
+    return Symmetric ? 2.*u - 1. : u;
+  }
+};
+
+template<typename Scalar>
+struct counter_random_bits<Scalar,true,false>
+{
+  enum { Words = sizeof(Scalar) > 4 ? int(sizeof(Scalar)/4) : 1 };
+  template<bool Symmetric>
+  EIGEN_DEVICE_FUNC static EIGEN_STRONG_INLINE Scalar run(const numext::uint32_t* w)
+  {
+    numext::uint64_t bits = w[0];
+    if(Words>1)
+      bits = (bits << 32) | w[Words-1];
+    return static_cast<Scalar>(bits);
+  }
+};
+
+template<>
+struct counter_random_bits<bool,true,false>
+{
+  enum { Words = 1 };
+  template<bool Symmetric>
+  EIGEN_DEVICE_FUNC static EIGEN_STRONG_INLINE bool run(const numext::uint32_t* w) { return (w[0] >> 31) != 0; }
+};
+
+template<typename Scalar>
+struct counter_random_bits<Scalar,false,true>
+{
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  enum { Words = 2 * counter_random_bits<RealScalar>::Words };
+  template<bool Symmetric>
+  EIGEN_DEVICE_FUNC static EIGEN_STRONG_INLINE Scalar run(const numext::uint32_t* w)
+  {
+    return Scalar(counter_random_bits<RealScalar>::template run<Symmetric>(w),
+                  counter_random_bits<RealScalar>::template run<Symmetric>(w + Words/2));
+  }
+};
+
+/** \internal
+  * Counter-based random generator: coefficient \c i is built from the Threefry blocks of counters
+  * \c i*BlocksPerCoeff to \c (i+1)*BlocksPerCoeff-1, so its value is a pure function of the key and of \c i.
+  * Evaluating an expression by packets, by scalars, or split over any number of threads therefore
+  * always gives the same values. */
+template<typename Scalar, bool Symmetric>
+class counter_random_generator
+{
+    typedef counter_random_bits<Scalar> Bits;
+    typedef numext::uint32_t uint32_t;
+    typedef numext::uint64_t uint64_t;
+    enum { BlocksPerCoeff = (Bits::Words + 1) / 2 };
+
+  public:
+    EIGEN_DEVICE_FUNC explicit counter_random_generator(uint64_t key) : m_key(key) {}
+
+    EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Scalar coeff(uint64_t index) const
+    {
+      uint64_t blocks[BlocksPerCoeff];
+      uint32_t bits[2*BlocksPerCoeff];
+      for(int j=0; j<BlocksPerCoeff; ++j)
+        blocks[j] = index*BlocksPerCoeff + j;
+      threefry2x32_20<BlocksPerCoeff>(blocks, m_key, bits);
+      return Bits::template run<Symmetric>(bits);
+    }
+
+    /** \returns the coefficients \c index, \c index+stride, ..., as a packet. */
+    template<typename Packet>
+    EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Packet packet(uint64_t index, uint64_t stride) const
+    {
+      enum { PacketSize = unpacket_traits<Packet>::size, NumBlocks = PacketSize*BlocksPerCoeff };
+      uint64_t blocks[NumBlocks];
+      uint32_t bits[2*NumBlocks];
+      EIGEN_ALIGN_MAX Scalar values[PacketSize];
+      for(int k=0; k<PacketSize; ++k)
+        for(int j=0; j<BlocksPerCoeff; ++j)
+          blocks[k*BlocksPerCoeff+j] = (index + k*stride)*BlocksPerCoeff + j;
+      threefry2x32_20<NumBlocks>(blocks, m_key, bits);
+      for(int k=0; k<PacketSize; ++k)
+        values[k] = Bits::template run<Symmetric>(bits + 2*BlocksPerCoeff*k);
+      return pload<Packet>(values);
+    }
+
+  protected:
+    uint64_t m_key;
+};
+
+template<typename Scalar> struct scalar_counter_random_op {
+  EIGEN_DEVICE_FUNC scalar_counter_random_op(numext::uint64_t seed, Index rows, bool rowMajor)
+    : m_generator(seed), m_rows(rows), m_innerStride(rowMajor ? rows : 1) {}
+
+  // Coefficients are numbered in column-major order whatever the storage order is.
+  template<typename IndexType>
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE const Scalar operator() (IndexType i) const
+  { return m_generator.coeff(numext::uint64_t(i)); }
+  template<typename IndexType>
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE const Scalar operator() (IndexType i, IndexType j) const
+  { return m_generator.coeff(numext::uint64_t(i) + numext::uint64_t(j) * numext::uint64_t(m_rows)); }
+
+  template<typename Packet, typename IndexType>
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE const Packet packetOp(IndexType i) const
+  { return m_generator.template packet<Packet>(numext::uint64_t(i), 1); }
+  template<typename Packet, typename IndexType>
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE const Packet packetOp(IndexType i, IndexType j) const
+  {
+    return m_generator.template packet<Packet>(numext::uint64_t(i) + numext::uint64_t(j) * numext::uint64_t(m_rows),
+                                               numext::uint64_t(m_innerStride));
+  }
+
+  counter_random_generator<Scalar,true> m_generator;
+  Index m_rows;
+  Index m_innerStride;
+};
+
+template<typename Scalar>
+struct functor_traits<scalar_counter_random_op<Scalar> >
+{ enum { Cost = (counter_random_bits<Scalar>::Words + 1) / 2 * 90 * NumTraits<int>::AddCost,
+         PacketAccess = packet_traits<Scalar>::Vectorizable, IsRepeatable = true }; };
+
 } // end namespace internal
 
 /** \returns a random matrix expression
@@ -134,6 +341,61 @@ EIGEN_DEVICE_FUNC inline Derived& DenseBase<Derived>::setRandom()
   return *this = Random(rows(), cols());
 }
 
+/** \returns a reproducible random matrix expression generated by a counter-based generator
+  *
+  * The coefficient (i,j) is a function of \a seed and of its column-major index \c i+j*rows only.
+  * Unlike Random(), the result is thus independent of any global state, of the storage order, and of
+  * the way the expression is evaluated, and the coefficients are generated by whole packets.
+  *
+  * Numbers are uniformly spread through their whole definition range for integer types,
+  * and in the [-1:1) range for floating point scalar types.
+  *
+  * The generator is Threefry-2x32-20, keyed by \a seed.
+  *
+  * \sa setCounterRandom(), CounterRandom(Index,uint64_t), CounterRandom(uint64_t), Random(Index,Index)
+  */
+template<typename Derived>
+inline const typename DenseBase<Derived>::CounterRandomReturnType
+DenseBase<Derived>::CounterRandom(Index rows, Index cols, numext::uint64_t seed)
+{
+  return NullaryExpr(rows, cols, internal::scalar_counter_random_op<Scalar>(seed, rows, bool(PlainObject::IsRowMajor)));
+}
+
+/** \returns a reproducible random vector expression generated by a counter-based generator
+  *
+  * \only_for_vectors
+  *
+  * \sa CounterRandom(Index,Index,uint64_t), setCounterRandom()
+  */
+template<typename Derived>
+inline const typename DenseBase<Derived>::CounterRandomReturnType
+DenseBase<Derived>::CounterRandom(Index size, numext::uint64_t seed)
+{
+  EIGEN_STATIC_ASSERT_VECTOR_ONLY(Derived)
+  return CounterRandom(RowsAtCompileTime==1 ? 1 : size, RowsAtCompileTime==1 ? size : 1, seed);
+}
+
+/** \returns a fixed-size reproducible random matrix or vector expression generated by a counter-based generator
+  *
+  * \sa CounterRandom(Index,Index,uint64_t), setCounterRandom()
+  */
+template<typename Derived>
+inline const typename DenseBase<Derived>::CounterRandomReturnType
+DenseBase<Derived>::CounterRandom(numext::uint64_t seed)
+{
+  return CounterRandom(RowsAtCompileTime, ColsAtCompileTime, seed);
+}
+
+/** Sets all coefficients in this expression to reproducible random values generated from \a seed.
+  *
+  * \sa CounterRandom(Index,Index,uint64_t), setRandom()
+  */
+template<typename Derived>
+inline Derived& DenseBase<Derived>::setCounterRandom(numext::uint64_t seed)
+{
+  return *this = CounterRandom(rows(), cols(), seed);
+}
+
 /** Resizes to the given \a newSize, and sets all coefficients in this expression to random values.
   *
   * Numbers are uniformly spread through their whole definition range for integer types,
@@ -388,6 +388,144 @@ public:
   
 };
 
+/** \internal Reduces large dynamic size expressions by blocks which may run on different threads, and whose partial
+  * results are combined in a fixed order (see parallel_linear_reduce()), so that the result does not depend on the number
+  * of threads. run() returns false if the expression is too small to be split, or must be evaluated before nesting
+  * (e.g., DenseBase::Random()) and so cannot be safely evaluated from several threads.
+  * \sa ParallelAssign::redux()
+  */
+template<typename Func, typename Evaluator,
+         int Traversal = redux_traits<Func, Evaluator>::Traversal,
+         bool Enable = Evaluator::SizeAtCompileTime==Dynamic && !(int(Evaluator::Flags) & EvalBeforeNestingBit)>
+struct parallel_redux_impl
+{
+  typedef typename Evaluator::Scalar Scalar;
+
+  template<typename XprType>
+  static bool run(const Evaluator&, const Func&, const XprType&, Scalar&) { return false; }
+};
+
+template<typename Func, typename Evaluator>
+struct parallel_redux_impl<Func, Evaluator, LinearVectorizedTraversal, true>
+{
+  typedef typename Evaluator::Scalar Scalar;
+  typedef typename redux_traits<Func, Evaluator>::PacketType PacketScalar;
+
+  template<typename XprType>
+  static bool run(const Evaluator &eval, const Func& func, const XprType& xpr, Scalar& res)
+  {
+    const Index size = xpr.size();
+    if(size<2*Index(ParallelReduxBlockSize))
+      return false;
+
+    const Index packetSize = redux_traits<Func, Evaluator>::PacketSize;
+    const int packetAlignment = unpacket_traits<PacketScalar>::alignment;
+    enum {
+      alignment0 = (bool(Evaluator::Flags & DirectAccessBit) && bool(packet_traits<Scalar>::AlignedOnScalar)) ? int(packetAlignment) : int(Unaligned),
+      alignment = plain_enum_max(alignment0, Evaluator::Alignment)
+    };
+    const Index alignedStart = internal::first_default_aligned(xpr);
+    // all the blocks start at alignedStart plus a multiple of the packet size, except the first one
+    // which also covers [0,alignedStart), and hold at least two packets
+    return parallel_linear_reduce(res, size, alignedStart, double(int(Evaluator::CoeffReadCost) + int(functor_traits<Func>::Cost)),
+      [&](Index begin, Index end) {
+        const Index packetBegin = numext::maxi(begin, alignedStart);
+        const Index alignedEnd2 = packetBegin + ((end-packetBegin)/(2*packetSize))*(2*packetSize);
+        const Index alignedEnd  = packetBegin + ((end-packetBegin)/(packetSize))*(packetSize);
+        PacketScalar packet_res0 = eval.template packet<alignment,PacketScalar>(packetBegin);
+        PacketScalar packet_res1 = eval.template packet<alignment,PacketScalar>(packetBegin+packetSize);
+        for(Index index = packetBegin + 2*packetSize; index < alignedEnd2; index += 2*packetSize)
+        {
+          packet_res0 = func.packetOp(packet_res0, eval.template packet<alignment,PacketScalar>(index));
+          packet_res1 = func.packetOp(packet_res1, eval.template packet<alignment,PacketScalar>(index+packetSize));
+        }
+        packet_res0 = func.packetOp(packet_res0,packet_res1);
+        if(alignedEnd>alignedEnd2)
+          packet_res0 = func.packetOp(packet_res0, eval.template packet<alignment,PacketScalar>(alignedEnd2));
+        Scalar block_res = func.predux(packet_res0);
+        for(Index index = begin; index < packetBegin; ++index)
+          block_res = func(block_res,eval.coeff(index));
+        for(Index index = alignedEnd; index < end; ++index)
+          block_res = func(block_res,eval.coeff(index));
+        return block_res;
+      }, func);
+  }
+};
+
+template<typename Func, typename Evaluator>
+struct parallel_redux_impl<Func, Evaluator, DefaultTraversal, true>
+{
+  typedef typename Evaluator::Scalar Scalar;
+
+  static Scalar run_block(const Evaluator &eval, const Func& func, Index outerStart, Index outerEnd, Index innerStart, Index innerEnd)
+  {
+    Scalar block_res = eval.coeffByOuterInner(outerStart, innerStart);
+    for(Index i = innerStart+1; i < innerEnd; ++i)
+      block_res = func(block_res, eval.coeffByOuterInner(outerStart, i));
+    for(Index j = outerStart+1; j < outerEnd; ++j)
+      for(Index i = innerStart; i < innerEnd; ++i)
+        block_res = func(block_res, eval.coeffByOuterInner(j, i));
+    return block_res;
+  }
+
+  template<typename XprType>
+  static bool run(const Evaluator &eval, const Func& func, const XprType& xpr, Scalar& res)
+  {
+    if(xpr.size()<2*Index(ParallelReduxBlockSize))
+      return false;
+    return parallel_outer_inner_reduce(res, xpr.outerSize(), xpr.innerSize(), double(int(Evaluator::CoeffReadCost) + int(functor_traits<Func>::Cost)),
+      [&](Index outerStart, Index outerEnd, Index innerStart, Index innerEnd) {
+        return run_block(eval, func, outerStart, outerEnd, innerStart, innerEnd);
+      }, func);
+  }
+};
+
+template<typename Func, typename Evaluator>
+struct parallel_redux_impl<Func, Evaluator, SliceVectorizedTraversal, true>
+{
+  typedef typename Evaluator::Scalar Scalar;
+  typedef typename redux_traits<Func, Evaluator>::PacketType PacketType;
+
+  template<typename XprType>
+  static bool run(const Evaluator &eval, const Func& func, const XprType& xpr, Scalar& res)
+  {
+    if(xpr.size()<2*Index(ParallelReduxBlockSize))
+      return false;
+    enum {
+      packetSize = redux_traits<Func, Evaluator>::PacketSize
+    };
+    return parallel_outer_inner_reduce(res, xpr.outerSize(), xpr.innerSize(), double(int(Evaluator::CoeffReadCost) + int(functor_traits<Func>::Cost)),
+      [&](Index outerStart, Index outerEnd, Index innerStart, Index innerEnd) {
+        const Index packetedInnerEnd = innerStart + ((innerEnd-innerStart)/packetSize)*packetSize;
+        if(packetedInnerEnd==innerStart)
+          return parallel_redux_impl<Func, Evaluator, DefaultTraversal, true>::run_block(eval, func, outerStart, outerEnd, innerStart, innerEnd);
+        PacketType packet_res = eval.template packetByOuterInner<Unaligned,PacketType>(outerStart,innerStart);
+        for(Index j=outerStart; j<outerEnd; ++j)
+          for(Index i=(j==outerStart?innerStart+packetSize:innerStart); i<packetedInnerEnd; i+=Index(packetSize))
+            packet_res = func.packetOp(packet_res, eval.template packetByOuterInner<Unaligned,PacketType>(j,i));
+        Scalar block_res = func.predux(packet_res);
+        for(Index j=outerStart; j<outerEnd; ++j)
+          for(Index i=packetedInnerEnd; i<innerEnd; ++i)
+            block_res = func(block_res, eval.coeffByOuterInner(j,i));
+        return block_res;
+      }, func);
+  }
+};
+
+// Reduces \a xpr with \a func, by blocks which may run on different threads if \a xpr can be split.
+template<typename Derived, typename Func>
+typename traits<Derived>::Scalar parallel_redux(const DenseBase<Derived>& xpr, const Func& func)
+{
+  eigen_assert(xpr.rows()>0 && xpr.cols()>0 && "you are using an empty matrix");
+
+  typedef redux_evaluator<Derived> Evaluator;
+  Evaluator eval(xpr.derived());
+  typename traits<Derived>::Scalar res;
+  if(parallel_redux_impl<Func, Evaluator>::run(eval, func, xpr.derived(), res))
+    return res;
+  return redux_impl<Func, Evaluator>::run(eval, func, xpr.derived());
+}
+
 } // end namespace internal
 
 /***************************************************************************
@@ -79,6 +79,72 @@ void stable_norm_impl_inner_step(const VectorType &vec, RealScalar& ssq, RealSca
     internal::stable_norm_kernel(SegmentWrapper(copy.segment(bi,numext::mini(blockSize, n - bi))), ssq, scale, invScale);
 }
 
+// state of a stable norm over a range of coefficients, whose squared norm is scale^2 * ssq
+template<typename RealScalar>
+struct stable_norm_partial
+{
+  RealScalar ssq, scale;
+};
+
+// Computes in norm the stable norm of large dynamic size expressions by blocks which may run on different threads.
+// The blocks are combined in a fixed order (see parallel_outer_inner_reduce()) so that the result does not depend
+// on the number of threads. Returns false if mat is too small to be split, or must be evaluated before nesting
+// (e.g., DenseBase::Random()) and so cannot be safely evaluated from several threads.
+template<typename MatrixType>
+bool parallel_stable_norm_impl(const MatrixType& mat, typename MatrixType::RealScalar& norm)
+{
+  using std::sqrt;
+  typedef typename MatrixType::RealScalar RealScalar;
+  typedef stable_norm_partial<RealScalar> Partial;
+  typedef typename internal::nested_eval<MatrixType,2>::type MatrixTypeCopy;
+  typedef internal::remove_all_t<MatrixTypeCopy> MatrixTypeCopyClean;
+  const bool IsRowMajor = MatrixTypeCopyClean::IsRowMajor;
+  typedef Block<const MatrixTypeCopyClean, IsRowMajor ? 1 : Dynamic, IsRowMajor ? Dynamic : 1> InnerSegment;
+
+  if(MatrixType::SizeAtCompileTime!=Dynamic || (int(evaluator<MatrixType>::Flags) & EvalBeforeNestingBit)
+     || mat.size()<2*Index(ParallelReduxBlockSize))
+    return false;
+  const MatrixTypeCopy copy(mat);
+  const double coeffCost = double(int(evaluator<MatrixTypeCopyClean>::CoeffReadCost) + 2*int(NumTraits<RealScalar>::MulCost) + 2*int(NumTraits<RealScalar>::AddCost));
+  Partial res;
+  if(!parallel_outer_inner_reduce(res, copy.outerSize(), copy.innerSize(), coeffCost,
+      [&](Index outerStart, Index outerEnd, Index innerStart, Index innerEnd) {
+        Partial block_res;
+        block_res.ssq = RealScalar(0);
+        block_res.scale = RealScalar(0);
+        RealScalar invScale(1);
+        for(Index j=outerStart; j<outerEnd; ++j)
+          stable_norm_impl_inner_step(InnerSegment(copy, IsRowMajor ? j : innerStart, IsRowMajor ? innerStart : j,
+                                                   IsRowMajor ? 1 : innerEnd-innerStart, IsRowMajor ? innerEnd-innerStart : 1),
+                                      block_res.ssq, block_res.scale, invScale);
+        return block_res;
+      },
+      [](const Partial& a, const Partial& b) {
+        // the sum of squares with the smaller scale is rescaled to the larger one, and NaNs are propagated
+        if((numext::isnan)(a.scale) || b.scale==RealScalar(0))
+          return a;
+        if((numext::isnan)(b.scale) || a.scale==RealScalar(0))
+          return b;
+        Partial sum;
+        if(a.scale==b.scale)
+        {
+          sum.ssq = a.ssq + b.ssq;
+          sum.scale = a.scale;
+        }
+        else
+        {
+          const Partial& big = a.scale>b.scale ? a : b;
+          const Partial& small = a.scale>b.scale ? b : a;
+          sum.ssq = big.ssq + small.ssq * numext::abs2(small.scale/big.scale);
+          sum.scale = big.scale;
+        }
+        return sum;
+      }))
+    return false;
+  norm = res.scale * sqrt(res.ssq);
+  return true;
+}
+
 template<typename VectorType>
 typename VectorType::RealScalar
 stable_norm_impl(const VectorType &vec, std::enable_if_t<VectorType::IsVectorAtCompileTime>* = 0 )
@@ -117,7 +183,98 @@ stable_norm_impl(const MatrixType &mat, std::enable_if_t<!MatrixType::IsVectorAt
   return scale * sqrt(ssq);
 }
 
-template<typename Derived>
+// accumulates the squares of the small (below b1), medium and big (above ab2) coefficients of vec,
+// scaled by s1m, 1 and s2m respectively, into asml, amed and abig
+template<typename Derived, typename RealScalar>
+inline void blue_norm_accumulate(const Derived& vec, RealScalar ab2, RealScalar b1, RealScalar s1m, RealScalar s2m,
+                                 RealScalar& asml, RealScalar& amed, RealScalar& abig)
+{
+  using std::abs;
+  for(Index j=0; j<vec.outerSize(); ++j)
+  {
+    for(typename Derived::InnerIterator iter(vec, j); iter; ++iter)
+    {
+      RealScalar ax = abs(iter.value());
+      if(ax > ab2)     abig += numext::abs2(ax*s2m);
+      else if(ax < b1) asml += numext::abs2(ax*s1m);
+      else             amed += numext::abs2(ax);
+    }
+  }
+}
+
+template<typename RealScalar>
+struct blue_norm_partial
+{
+  RealScalar asml, amed, abig;
+};
+
+// Same as blue_norm_accumulate() for large dynamic size dense expressions, by blocks which may run on different
+// threads and are summed in a fixed order (see parallel_outer_inner_reduce()). Returns false if vec is too small
+// to be split, or must be evaluated before nesting.
+template<typename Derived, typename RealScalar>
+bool parallel_blue_norm_accumulate(const DenseBase<Derived>& vec, RealScalar ab2, RealScalar b1, RealScalar s1m, RealScalar s2m,
+                                   RealScalar& asml, RealScalar& amed, RealScalar& abig)
+{
+  typedef blue_norm_partial<RealScalar> Partial;
+  typedef typename internal::nested_eval<Derived,2>::type MatrixTypeCopy;
+  typedef internal::remove_all_t<MatrixTypeCopy> MatrixTypeCopyClean;
+  const bool IsRowMajor = Derived::IsRowMajor;
+
+  if(Derived::SizeAtCompileTime!=Dynamic || (int(evaluator<Derived>::Flags) & EvalBeforeNestingBit)
+     || vec.size()<2*Index(ParallelReduxBlockSize))
+    return false;
+  const MatrixTypeCopy copy(vec.derived());
+  const double coeffCost = double(int(evaluator<MatrixTypeCopyClean>::CoeffReadCost) + int(NumTraits<RealScalar>::MulCost) + 2*int(NumTraits<RealScalar>::AddCost));
+  Partial res;
+  if(!parallel_outer_inner_reduce(res, copy.outerSize(), copy.innerSize(), coeffCost,
+      [&](Index outerStart, Index outerEnd, Index innerStart, Index innerEnd) {
+        Partial block_res;
+        block_res.asml = block_res.amed = block_res.abig = RealScalar(0);
+        blue_norm_accumulate(copy.block(IsRowMajor ? outerStart : innerStart, IsRowMajor ? innerStart : outerStart,
+                                        IsRowMajor ? outerEnd-outerStart : innerEnd-innerStart,
+                                        IsRowMajor ? innerEnd-innerStart : outerEnd-outerStart),
+                             ab2, b1, s1m, s2m, block_res.asml, block_res.amed, block_res.abig);
+        return block_res;
+      },
+      [](const Partial& a, const Partial& b) {
+        Partial sum;
+        sum.asml = a.asml + b.asml;
+        sum.amed = a.amed + b.amed;
+        sum.abig = a.abig + b.abig;
+        return sum;
+      }))
+    return false;
+  asml = res.asml;
+  amed = res.amed;
+  abig = res.abig;
+  return true;
+}
+
+template<bool Parallel>
+struct blue_norm_accumulator
+{
+  template<typename Derived, typename RealScalar>
+  static void run(const Derived& vec, RealScalar ab2, RealScalar b1, RealScalar s1m, RealScalar s2m,
+                  RealScalar& asml, RealScalar& amed, RealScalar& abig)
+  {
+    blue_norm_accumulate(vec, ab2, b1, s1m, s2m, asml, amed, abig);
+  }
+};
+
+template<>
+struct blue_norm_accumulator<true>
+{
+  template<typename Derived, typename RealScalar>
+  static void run(const Derived& vec, RealScalar ab2, RealScalar b1, RealScalar s1m, RealScalar s2m,
+                  RealScalar& asml, RealScalar& amed, RealScalar& abig)
+  {
+    if(!parallel_blue_norm_accumulate(vec, ab2, b1, s1m, s2m, asml, amed, abig))
+      blue_norm_accumulate(vec, ab2, b1, s1m, s2m, asml, amed, abig);
+  }
+};
+
+// the squares are accumulated by blocks which may run on different threads if Parallel is true
+template<bool Parallel = false, typename Derived>
 inline typename NumTraits<typename traits<Derived>::Scalar>::Real
 blueNorm_impl(const EigenBase<Derived>& _vec)
 {
@@ -153,16 +310,7 @@ blueNorm_impl(const EigenBase<Derived>& _vec)
   RealScalar amed = RealScalar(0);
   RealScalar abig = RealScalar(0);
 
-  for(Index j=0; j<vec.outerSize(); ++j)
-  {
-    for(typename Derived::InnerIterator iter(vec, j); iter; ++iter)
-    {
-      RealScalar ax = abs(iter.value());
-      if(ax > ab2)     abig += numext::abs2(ax*s2m);
-      else if(ax < b1) asml += numext::abs2(ax*s1m);
-      else             amed += numext::abs2(ax);
-    }
-  }
+  blue_norm_accumulator<Parallel>::run(vec, ab2, b1, s1m, s2m, asml, amed, abig);
   if(amed!=amed)
     return amed;  // we got a NaN
   if(abig > RealScalar(0))
@@ -593,6 +593,85 @@ struct functor_traits<minmax_coeff_visitor<Derived, is_min, NaNPropagation> > {
   };
 };
 
+// restriction of a visitor_evaluator to the inner indices [innerStart,innerStart+innerSize)
+// of the inner vectors [outerStart,outerStart+outerSize)
+template<typename Evaluator>
+class visitor_block_evaluator
+{
+public:
+  typedef typename Evaluator::Scalar Scalar;
+  typedef typename Evaluator::CoeffReturnType CoeffReturnType;
+  static constexpr bool IsRowMajor = Evaluator::IsRowMajor;
+
+  visitor_block_evaluator(const Evaluator& eval, Index outerStart, Index outerSize, Index innerStart, Index innerSize)
+    : m_evaluator(eval),
+      m_startRow(IsRowMajor ? outerStart : innerStart), m_startCol(IsRowMajor ? innerStart : outerStart),
+      m_rows(IsRowMajor ? outerSize : innerSize), m_cols(IsRowMajor ? innerSize : outerSize) { }
+
+  Index rows() const { return m_rows; }
+  Index cols() const { return m_cols; }
+  Index startRow() const { return m_startRow; }
+  Index startCol() const { return m_startCol; }
+  EIGEN_STRONG_INLINE CoeffReturnType coeff(Index row, Index col) const { return m_evaluator.coeff(m_startRow + row, m_startCol + col); }
+  template <typename Packet>
+  EIGEN_STRONG_INLINE Packet packet(Index row, Index col) const {
+    return m_evaluator.template packet<Packet>(m_startRow + row, m_startCol + col);
+  }
+
+protected:
+  const Evaluator& m_evaluator;
+  const Index m_startRow, m_startCol, m_rows, m_cols;
+};
+
+/** \internal Visits large dynamic size expressions by blocks which may run on different threads, and merges
+  * their visitors in a fixed order (see parallel_outer_inner_reduce()). This is only valid for visitors such
+  * as minmax_coeff_visitor whose state after visiting two consecutive ranges of coefficients is obtained by
+  * visiting the (res, row, col) state of the second range after the first one. run() returns false if the
+  * expression is too small to be split, or must be evaluated before nesting (e.g., DenseBase::Random()).
+  * \sa ParallelAssign::minCoeff(), ParallelAssign::maxCoeff()
+  */
+template<typename Derived, typename Visitor,
+         bool Enable = DenseBase<Derived>::SizeAtCompileTime==Dynamic && !(int(evaluator<Derived>::Flags) & EvalBeforeNestingBit)>
+struct parallel_visit_impl
+{
+  static bool run(const Derived&, Visitor&) { return false; }
+};
+
+template<typename Derived, typename Visitor>
+struct parallel_visit_impl<Derived, Visitor, true>
+{
+  using Evaluator = visitor_evaluator<Derived>;
+  using BlockEvaluator = visitor_block_evaluator<Evaluator>;
+  static constexpr bool IsRowMajor = DenseBase<Derived>::IsRowMajor;
+  using impl = visitor_impl<Visitor, BlockEvaluator, Dynamic, visit_impl<Derived, Visitor, false>::Vectorize, /*LinearAccess=*/false>;
+
+  static bool run(const Derived& mat, Visitor& visitor) {
+    if (mat.size() < 2 * Index(ParallelReduxBlockSize)) return false;
+    Evaluator evaluator(mat);
+    return parallel_outer_inner_reduce(visitor, mat.outerSize(), mat.innerSize(),
+      double(int(Evaluator::CoeffReadCost) + int(functor_traits<Visitor>::Cost)),
+      [&](Index outerStart, Index outerEnd, Index innerStart, Index innerEnd) {
+        BlockEvaluator block(evaluator, outerStart, outerEnd - outerStart, innerStart, innerEnd - innerStart);
+        Visitor block_visitor;
+        impl::run(block, block_visitor);
+        block_visitor.row += block.startRow();
+        block_visitor.col += block.startCol();
+        return block_visitor;
+      },
+      [](Visitor left, const Visitor& right) {
+        left(right.res, right.row, right.col);
+        return left;
+      });
+  }
+};
+
+// Visits \a mat with a minmax_coeff_visitor, by blocks which may run on different threads if \a mat can be split.
+template<typename Derived, typename Visitor>
+void parallel_visit(const DenseBase<Derived>& mat, Visitor& visitor)
+{
+  if (!parallel_visit_impl<Derived, Visitor>::run(mat.derived(), visitor)) mat.visit(visitor);
+}
+
 template <typename Scalar>
 struct all_visitor {
   using result_type = bool;
@@ -214,6 +214,13 @@ template<typename Scalar,typename IndexType>
 struct has_unary_operator<scalar_random_op<Scalar>,IndexType> { enum { value = 0}; };
 template<typename Scalar,typename IndexType>
 struct has_binary_operator<scalar_random_op<Scalar>,IndexType> { enum { value = 0}; };
+
+template<typename Scalar,typename IndexType>
+struct has_nullary_operator<scalar_counter_random_op<Scalar>,IndexType> { enum { value = 0}; };
+template<typename Scalar,typename IndexType>
+struct has_unary_operator<scalar_counter_random_op<Scalar>,IndexType> { enum { value = 1}; };
+template<typename Scalar,typename IndexType>
+struct has_binary_operator<scalar_counter_random_op<Scalar>,IndexType> { enum { value = 1}; };
 #endif
 
 } // end namespace internal
@@ -16,6 +16,51 @@ namespace Eigen {
 
 namespace internal {
 
+#ifdef EIGEN_HAS_GEMM_THREADPOOL
+/** \internal \returns the storage of the thread pool set by setGemmThreadPool() */
+inline std::atomic<ThreadPoolInterface*>& gemm_thread_pool()
+{
+  static std::atomic<ThreadPoolInterface*> m_pool(nullptr);
+  return m_pool;
+}
+
+/** \internal Serializes the parallel sessions running on the user thread pool.
+  * A session spins until all its tasks have been picked up by the pool, so two
+  * sessions sharing the same workers could otherwise wait on each other forever. */
+inline std::mutex& gemm_thread_pool_session_mutex()
+{
+  static std::mutex m_mutex;
+  return m_mutex;
+}
+
+/** \internal \returns whether the calling thread is running its own share of a parallel region spread over the
+  * user thread pool. The threads of the pool itself are recognized by their CurrentThreadId() instead. */
+inline bool& gemm_thread_pool_caller_in_region()
+{
+  static thread_local bool m_inRegion = false;
+  return m_inRegion;
+}
+
+/** \internal Marks the calling thread as running in a parallel region for the lifetime of the object. */
+class gemm_thread_pool_region
+{
+  public:
+    gemm_thread_pool_region() : m_previous(gemm_thread_pool_caller_in_region()) { gemm_thread_pool_caller_in_region() = true; }
+    ~gemm_thread_pool_region() { gemm_thread_pool_caller_in_region() = m_previous; }
+  private:
+    gemm_thread_pool_region(const gemm_thread_pool_region&);
+    gemm_thread_pool_region& operator=(const gemm_thread_pool_region&);
+    bool m_previous;
+};
+
+/** \internal \returns whether a parallel region started from the calling thread must run sequentially, that is
+  * when no pool is set, or when the caller already takes part in a parallel region. */
+inline bool gemm_thread_pool_unavailable(ThreadPoolInterface* pool)
+{
+  return pool==0 || pool->CurrentThreadId()!=-1 || gemm_thread_pool_caller_in_region();
+}
+#endif
+
 /** \internal */
 inline void manage_multi_threading(Action action, int* v)
 {
@@ -35,6 +80,14 @@ inline void manage_multi_threading(Action action, int* v)
       *v = m_maxThreads;
     else
       *v = omp_get_max_threads();
+    #elif defined(EIGEN_HAS_GEMM_THREADPOOL)
+    ThreadPoolInterface* pool = gemm_thread_pool().load(std::memory_order_acquire);
+    if(pool==0)
+      *v = 1;
+    else if(m_maxThreads>0)
+      *v = (std::min)(m_maxThreads, pool->NumThreads());
+    else
+      *v = pool->NumThreads();
     #else
     *v = 1;
     #endif
@@ -72,23 +125,195 @@ inline void setNbThreads(int v)
   internal::manage_multi_threading(SetAction, &v);
 }
 
+#ifdef EIGEN_HAS_GEMM_THREADPOOL
+/** Sets the thread pool used to parallelize large matrix products when Eigen is
+  * compiled with \c EIGEN_GEMM_THREADPOOL. Passing a null pointer (the default)
+  * makes the products single-threaded again.
+  *
+  * Eigen does not take ownership of \a pool, which must outlive every product
+  * started while it is registered. The calling thread takes part in the work,
+  * so at most \c pool->NumThreads()-1 tasks are scheduled per product, and
+  * products issued from a thread of \a pool itself run sequentially.
+  *
+  * \sa getGemmThreadPool, setNbThreads */
+inline void setGemmThreadPool(ThreadPoolInterface* pool)
+{
+  internal::gemm_thread_pool().store(pool, std::memory_order_release);
+}
+
+/** \returns the thread pool set by setGemmThreadPool(), or a null pointer if none
+  * \sa setGemmThreadPool */
+inline ThreadPoolInterface* getGemmThreadPool()
+{
+  return internal::gemm_thread_pool().load(std::memory_order_acquire);
+}
+#endif
+
 namespace internal {
 
-template<typename Index> struct GemmParallelInfo
+/** \internal Synchronization state of the horizontal panel A'_i of the lhs packed by one thread */
+template<typename Index> struct GemmParallelTaskInfo
 {
 
-#ifdef EIGEN_HAS_OPENMP
-  GemmParallelInfo() : sync(-1), users(0), lhs_start(0), lhs_length(0) {}
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_GEMM_THREADPOOL)
+  GemmParallelTaskInfo() : sync(-1), users(0), lhs_start(0), lhs_length(0) {}
   std::atomic<Index> sync;
   std::atomic<int> users;
 #else
-  GemmParallelInfo() : lhs_start(0), lhs_length(0) {}
+  GemmParallelTaskInfo() : lhs_start(0), lhs_length(0) {}
 #endif
 
   Index lhs_start;
   Index lhs_length;
 };
 
+/** \internal Per-thread view of a parallel GEMM session: the logical id of the
+  * running thread, the number of threads taking part, and the shared task array. */
+template<typename Index> struct GemmParallelInfo
+{
+  GemmParallelInfo(Index logical_thread_id_, Index num_threads_, GemmParallelTaskInfo<Index>* task_info_)
+    : logical_thread_id(logical_thread_id_), num_threads(num_threads_), task_info(task_info_) {}
+
+  Index logical_thread_id;
+  Index num_threads;
+  GemmParallelTaskInfo<Index>* task_info;
+};
+
+/** \internal \returns the number of threads available to a parallel loop started from the calling thread,
+  * that is nbThreads(), or 1 if multi-threading is disabled or the caller already runs in a parallel region.
+  * \sa parallelize_tasks() */
+inline Index parallel_loop_threads()
+{
+#if defined(EIGEN_HAS_OPENMP)
+  if(omp_get_num_threads()>1)
+    return 1;
+  return nbThreads();
+#elif defined(EIGEN_HAS_GEMM_THREADPOOL)
+  if(gemm_thread_pool_unavailable(getGemmThreadPool()))
+    return 1;
+  return nbThreads();
+#else
+  return 1;
+#endif
+}
+
+/** \internal Calls \a func(i) for each i in [0,num_tasks), each call possibly on a different thread,
+  * and returns once all of them are done. Unlike the GEMM sessions the tasks must not wait on each other,
+  * so \a num_tasks is usually parallel_loop_threads() or a small multiple of it.
+  * \sa parallel_loop_threads() */
+template<typename Functor>
+void parallelize_tasks(Index num_tasks, const Functor& func)
+{
+  if(num_tasks<=1)
+  {
+    if(num_tasks==1)
+      func(Index(0));
+    return;
+  }
+#if defined(EIGEN_HAS_OPENMP)
+  Eigen::initParallel();
+  #pragma omp parallel for schedule(static,1) num_threads(static_cast<int>((std::min<Index>)(num_tasks, nbThreads())))
+  for(Index i=0; i<num_tasks; ++i)
+    func(i);
+#elif defined(EIGEN_HAS_GEMM_THREADPOOL)
+  ThreadPoolInterface* pool = getGemmThreadPool();
+  if(gemm_thread_pool_unavailable(pool))
+  {
+    for(Index i=0; i<num_tasks; ++i)
+      func(i);
+    return;
+  }
+  // the calling thread runs the last task while the others are handed to the pool
+  Barrier barrier(static_cast<unsigned int>(num_tasks-1));
+  for(Index i=0; i<num_tasks-1; ++i)
+    pool->Schedule([&func, &barrier, i]() { func(i); barrier.Notify(); });
+  {
+    gemm_thread_pool_region region;
+    func(num_tasks-1);
+  }
+  barrier.Wait();
+#else
+  for(Index i=0; i<num_tasks; ++i)
+    func(i);
+#endif
+}
+
+/** \internal Computes \a block(b) for each b in [0,num_blocks), sharing the blocks among at most \a num_tasks tasks,
+  * and returns their results combined pairwise by \a combine along a fixed binary tree. The result does not depend
+  * on the number of tasks actually run in parallel.
+  * \sa parallel_linear_reduce(), parallel_outer_inner_reduce() */
+template<typename Result, typename BlockFunc, typename CombineFunc>
+Result parallel_blocked_reduce(Index num_blocks, Index num_tasks, const BlockFunc& block, const CombineFunc& combine)
+{
+  ei_declare_aligned_stack_constructed_variable(Result, partial, num_blocks, 0);
+  num_tasks = numext::mini(num_tasks, num_blocks);
+  parallelize_tasks(num_tasks, [&](Index t) {
+    const Index end = (num_blocks*(t+1))/num_tasks;
+    for(Index b=(num_blocks*t)/num_tasks; b<end; ++b)
+      partial[b] = block(b);
+  });
+  for(Index step=1; step<num_blocks; step*=2)
+    for(Index b=0; b+step<num_blocks; b+=2*step)
+      partial[b] = combine(partial[b], partial[b+step]);
+  return partial[0];
+}
+
+/** \internal \returns the number of tasks worth running for \a num_blocks blocks costing \a cost in total. */
+inline Index parallel_reduce_tasks(Index num_blocks, double cost)
+{
+  const double max_tasks = cost/double(ParallelReduxMinTaskCost);
+  return numext::maxi(Index(1), numext::mini(parallel_loop_threads(), max_tasks<double(num_blocks) ? Index(max_tasks) : num_blocks));
+}
+
+/** \internal Reduces the linear range [0,size) split into blocks of ParallelReduxBlockSize coefficients starting at
+  * \a offset, the first block also covering [0,offset) and the last one the remaining coefficients. \a block(begin,end)
+  * returns the partial result of a block, and \a coeffCost is the cost of a coefficient.
+  * \returns false, without calling \a block, if the range is too small to be split, and true otherwise with the result
+  * in \a res.
+  * \sa parallel_blocked_reduce() */
+template<typename Result, typename BlockFunc, typename CombineFunc>
+bool parallel_linear_reduce(Result& res, Index size, Index offset, double coeffCost, const BlockFunc& block, const CombineFunc& combine)
+{
+  const Index num_blocks = (size-offset)/ParallelReduxBlockSize;
+  if(num_blocks<2)
+    return false;
+  res = parallel_blocked_reduce<Result>(num_blocks, parallel_reduce_tasks(num_blocks, double(size)*coeffCost),
+    [&](Index b) {
+      const Index begin = b==0 ? Index(0) : offset + b*ParallelReduxBlockSize;
+      const Index end = b==num_blocks-1 ? size : offset + (b+1)*ParallelReduxBlockSize;
+      return block(begin, end);
+    }, combine);
+  return true;
+}
+
+/** \internal Same as parallel_linear_reduce() for a \a outerSize x \a innerSize range visited inner index first.
+  * Long inner vectors are split into blocks of ParallelReduxBlockSize coefficients, and short ones are grouped into
+  * blocks of about ParallelReduxBlockSize coefficients. The blocks follow the sequential order, and
+  * \a block(outerStart,outerEnd,innerStart,innerEnd) returns the partial result of a block.
+  * \sa parallel_blocked_reduce() */
+template<typename Result, typename BlockFunc, typename CombineFunc>
+bool parallel_outer_inner_reduce(Result& res, Index outerSize, Index innerSize, double coeffCost, const BlockFunc& block, const CombineFunc& combine)
+{
+  if(innerSize==0)
+    return false;
+  const Index inner_blocks = numext::maxi(Index(1), innerSize/ParallelReduxBlockSize);
+  const Index outer_per_block = numext::maxi(Index(1), ParallelReduxBlockSize/innerSize);
+  const Index outer_blocks = outerSize/outer_per_block;
+  const Index num_blocks = outer_blocks*inner_blocks;
+  if(num_blocks<2)
+    return false;
+  res = parallel_blocked_reduce<Result>(num_blocks, parallel_reduce_tasks(num_blocks, double(outerSize)*double(innerSize)*coeffCost),
+    [&](Index b) {
+      const Index ob = b/inner_blocks, ib = b%inner_blocks;
+      const Index outerStart = ob*outer_per_block;
+      const Index outerEnd = ob==outer_blocks-1 ? outerSize : outerStart + outer_per_block;
+      const Index innerStart = ib*ParallelReduxBlockSize;
+      const Index innerEnd = ib==inner_blocks-1 ? innerSize : innerStart + ParallelReduxBlockSize;
+      return block(outerStart, outerEnd, innerStart, innerEnd);
+    }, combine);
+  return true;
+}
+
 template<bool Condition, typename Functor, typename Index>
 void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth, bool transpose)
 {
@@ -97,7 +322,7 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
   // Without C++11, we have to disable GEMM's parallelization on
   // non x86 architectures because there volatile is not enough for our purpose.
   // See bug 1572.
-#if (! defined(EIGEN_HAS_OPENMP)) || defined(EIGEN_USE_BLAS)
+#if (! (defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_GEMM_THREADPOOL))) || defined(EIGEN_USE_BLAS)
   // FIXME the transpose variable is only needed to properly split
   // the matrix product when multithreading is enabled. This is a temporary
   // fix to support row-major destination matrices. This whole
@@ -107,7 +332,7 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
   func(0,rows, 0,cols);
 #else
 
-  // Dynamically check whether we should enable or disable OpenMP.
+  // Dynamically check whether we should enable or disable multi-threading.
   // The conditions are:
   // - the max number of threads we can create is greater than 1
   // - we are not already in a parallel code
@@ -129,24 +354,34 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
 
   // if multi-threading is explicitly disabled, not useful, or if we already are in a parallel session,
   // then abort multi-threading
-  // FIXME omp_get_num_threads()>1 only works for openmp, what if the user does not use openmp?
-  if((!Condition) || (threads==1) || (omp_get_num_threads()>1))
+#if defined(EIGEN_HAS_OPENMP)
+  bool in_parallel_session = omp_get_num_threads()>1;
+#else
+  ThreadPoolInterface* pool = getGemmThreadPool();
+  bool in_parallel_session = gemm_thread_pool_unavailable(pool);
+#endif
+  if((!Condition) || (threads==1) || in_parallel_session)
     return func(0,rows, 0,cols);
 
+#if defined(EIGEN_HAS_GEMM_THREADPOOL)
+  // Another product is already spread over the pool: run this one on the calling thread
+  // rather than competing with it for the same workers.
+  std::unique_lock<std::mutex> session(gemm_thread_pool_session_mutex(), std::try_to_lock);
+  if(!session.owns_lock())
+    return func(0,rows, 0,cols);
+#endif
+
   Eigen::initParallel();
   func.initParallelSession(threads);
 
   if(transpose)
     std::swap(rows,cols);
 
-  ei_declare_aligned_stack_constructed_variable(GemmParallelInfo<Index>,info,threads,0);
+  ei_declare_aligned_stack_constructed_variable(GemmParallelTaskInfo<Index>,task_info,threads,0);
 
-  #pragma omp parallel num_threads(threads)
+  // Note that the actual number of threads might be lower than the number of request ones.
+  auto task = [&](Index i, Index actual_threads)
   {
-    Index i = omp_get_thread_num();
-    // Note that the actual number of threads might be lower than the number of request ones.
-    Index actual_threads = omp_get_num_threads();
-
     Index blockCols = (cols / actual_threads) & ~Index(0x3);
     Index blockRows = (rows / actual_threads);
     blockRows = (blockRows/Functor::Traits::mr)*Functor::Traits::mr;
@@ -157,12 +392,30 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
     Index c0 = i*blockCols;
     Index actualBlockCols = (i+1==actual_threads) ? cols-c0 : blockCols;
 
-    info[i].lhs_start = r0;
-    info[i].lhs_length = actualBlockRows;
+    task_info[i].lhs_start = r0;
+    task_info[i].lhs_length = actualBlockRows;
+
+    GemmParallelInfo<Index> info(i, actual_threads, task_info);
+    if(transpose) func(c0, actualBlockCols, 0, rows, &info);
+    else          func(0, rows, c0, actualBlockCols, &info);
+  };
 
-    if(transpose) func(c0, actualBlockCols, 0, rows, info);
-    else          func(0, rows, c0, actualBlockCols, info);
+#if defined(EIGEN_HAS_OPENMP)
+  #pragma omp parallel num_threads(threads)
+  task(omp_get_thread_num(), omp_get_num_threads());
+#else
+  // The threads of a session wait on each other's packed panels, so all of them
+  // must be running at once: the calling thread takes the last share and the
+  // others are handed to the pool.
+  Barrier barrier(static_cast<unsigned int>(threads-1));
+  for(Index i=0; i<threads-1; ++i)
+    pool->Schedule([&task, &barrier, i, threads]() { task(i, threads); barrier.Notify(); });
+  {
+    gemm_thread_pool_region region;
+    task(threads-1, threads);
   }
+  barrier.Wait();
+#endif
 #endif
 }
 
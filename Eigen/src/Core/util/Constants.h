@@ -417,7 +417,11 @@ enum DecompositionOptions {
     * solve the generalized eigenproblem \f$ BAx = \lambda x \f$. */
   BAx_lx              = 0x400,
   /** \internal */
-  GenEigMask = Ax_lBx | ABx_lx | BAx_lx
+  GenEigMask = Ax_lBx | ABx_lx | BAx_lx,
+  /** Used in SelfAdjointEigenSolver and GeneralizedSelfAdjointEigenSolver together with
+    * #ComputeEigenvectors to compute the eigendecomposition of the tridiagonal matrix
+    * by divide-and-conquer instead of the implicit QR algorithm. */
+  DivideAndConquer    = 0x800
 };
 
 /** \ingroup enums
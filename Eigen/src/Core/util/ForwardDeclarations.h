@@ -65,6 +65,7 @@ template<typename Derived> class ArrayBase;
 
 template<typename ExpressionType, unsigned int Added, unsigned int Removed> class Flagged;
 template<typename ExpressionType, template <typename> class StorageBase > class NoAlias;
+template<typename ExpressionType> class ParallelAssign;
 template<typename ExpressionType> class NestByValue;
 template<typename ExpressionType> class ForceAlignedAccess;
 template<typename ExpressionType> class SwapWrapper;
@@ -135,6 +136,16 @@ template<typename DecompositionType> struct image_retval_base;
 template<typename DecompositionType> struct image_retval;
 } // end namespace internal
 
+namespace internal {
+// Large reductions are computed by blocks of ParallelReduxBlockSize coefficients combined in a fixed order,
+// and a task of the parallel reductions should cost at least ParallelReduxMinTaskCost (see Parallelizer.h).
+enum { ParallelReduxBlockSize = 16384, ParallelReduxMinTaskCost = 1<<17 };
+template<typename Result, typename BlockFunc, typename CombineFunc>
+bool parallel_linear_reduce(Result& res, Index size, Index offset, double coeffCost, const BlockFunc& block, const CombineFunc& combine);
+template<typename Result, typename BlockFunc, typename CombineFunc>
+bool parallel_outer_inner_reduce(Result& res, Index outerSize, Index innerSize, double coeffCost, const BlockFunc& block, const CombineFunc& combine);
+} // end namespace internal
+
 namespace internal {
 template<typename Scalar_, int Rows=Dynamic, int Cols=Dynamic, int Supers=Dynamic, int Subs=Dynamic, int Options=0> class BandMatrix;
 }
@@ -199,6 +210,7 @@ template<typename Scalar> struct scalar_square_op;
 template<typename Scalar> struct scalar_cube_op;
 template<typename Scalar, typename NewType> struct scalar_cast_op;
 template<typename Scalar> struct scalar_random_op;
+template<typename Scalar> struct scalar_counter_random_op;
 template<typename Scalar> struct scalar_constant_op;
 template<typename Scalar> struct scalar_identity_op;
 template<typename Scalar> struct scalar_sign_op;
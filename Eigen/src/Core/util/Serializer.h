@@ -111,6 +111,12 @@ class Serializer<DenseBase<Derived>, void> {
     EIGEN_USING_STD(memcpy)
     memcpy(&header, src, header_bytes);
     src += header_bytes;
+    // Reject negative, overflowing or mismatching sizes, as found in corrupted buffers.
+    if (EIGEN_PREDICT_FALSE(header.rows < 0 || header.cols < 0)) return nullptr;
+    if (EIGEN_PREDICT_FALSE((Derived::RowsAtCompileTime != Dynamic && header.rows != Derived::RowsAtCompileTime)
+                            || (Derived::ColsAtCompileTime != Dynamic && header.cols != Derived::ColsAtCompileTime))) return nullptr;
+    const size_t max_size = size_t(end - src) / sizeof(Scalar);
+    if (EIGEN_PREDICT_FALSE(header.cols > 0 && size_t(header.rows) > max_size / size_t(header.cols))) return nullptr;
     const size_t data_bytes = sizeof(Scalar) * header.rows * header.cols;
     if (EIGEN_PREDICT_FALSE(src + data_bytes > end)) return nullptr;
     value.resize(header.rows, header.cols);
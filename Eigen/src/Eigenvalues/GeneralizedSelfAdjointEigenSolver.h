@@ -85,7 +85,8 @@ class GeneralizedSelfAdjointEigenSolver : public SelfAdjointEigenSolver<MatrixTy
       *                   Only the lower triangular part of the matrix is referenced.
       * \param[in]  matB  Positive-definite matrix in matrix pencil.
       *                   Only the lower triangular part of the matrix is referenced.
-      * \param[in]  options A or-ed set of flags {#ComputeEigenvectors,#EigenvaluesOnly} | {#Ax_lBx,#ABx_lx,#BAx_lx}.
+      * \param[in]  options A or-ed set of flags {#ComputeEigenvectors,#EigenvaluesOnly} | {#Ax_lBx,#ABx_lx,#BAx_lx},
+      *                     optionally or-ed with #DivideAndConquer.
       *                     Default is #ComputeEigenvectors|#Ax_lBx.
       *
       * This constructor calls compute(const MatrixType&, const MatrixType&, int)
@@ -118,7 +119,8 @@ class GeneralizedSelfAdjointEigenSolver : public SelfAdjointEigenSolver<MatrixTy
       *                   Only the lower triangular part of the matrix is referenced.
       * \param[in]  matB  Positive-definite matrix in matrix pencil.
       *                   Only the lower triangular part of the matrix is referenced.
-      * \param[in]  options A or-ed set of flags {#ComputeEigenvectors,#EigenvaluesOnly} | {#Ax_lBx,#ABx_lx,#BAx_lx}.
+      * \param[in]  options A or-ed set of flags {#ComputeEigenvectors,#EigenvaluesOnly} | {#Ax_lBx,#ABx_lx,#BAx_lx},
+      *                     optionally or-ed with #DivideAndConquer.
       *                     Default is #ComputeEigenvectors|#Ax_lBx.
       *
       * \returns    Reference to \c *this
@@ -165,13 +167,14 @@ GeneralizedSelfAdjointEigenSolver<MatrixType>& GeneralizedSelfAdjointEigenSolver
 compute(const MatrixType& matA, const MatrixType& matB, int options)
 {
   eigen_assert(matA.cols()==matA.rows() && matB.rows()==matA.rows() && matB.cols()==matB.rows());
-  eigen_assert((options&~(EigVecMask|GenEigMask))==0
+  eigen_assert((options&~(EigVecMask|GenEigMask|DivideAndConquer))==0
           && (options&EigVecMask)!=EigVecMask
           && ((options&GenEigMask)==0 || (options&GenEigMask)==Ax_lBx
            || (options&GenEigMask)==ABx_lx || (options&GenEigMask)==BAx_lx)
           && "invalid option parameter");
 
   bool computeEigVecs = ((options&EigVecMask)==0) || ((options&EigVecMask)==ComputeEigenvectors);
+  int solverOptions = (computeEigVecs ? ComputeEigenvectors : EigenvaluesOnly) | (options&DivideAndConquer);
 
   // Compute the cholesky decomposition of matB = L L' = U'U
   LLT<MatrixType> cholB(matB);
@@ -187,7 +190,7 @@ compute(const MatrixType& matA, const MatrixType& matB, int options)
     cholB.matrixL().template solveInPlace<OnTheLeft>(matC);
     cholB.matrixU().template solveInPlace<OnTheRight>(matC);
 
-    Base::compute(matC, computeEigVecs ? ComputeEigenvectors : EigenvaluesOnly );
+    Base::compute(matC, solverOptions);
 
     // transform back the eigen vectors: evecs = inv(U) * evecs
     if(computeEigVecs)
@@ -200,7 +203,7 @@ compute(const MatrixType& matA, const MatrixType& matB, int options)
     matC = matC * cholB.matrixL();
     matC = cholB.matrixU() * matC;
 
-    Base::compute(matC, computeEigVecs ? ComputeEigenvectors : EigenvaluesOnly);
+    Base::compute(matC, solverOptions);
 
     // transform back the eigen vectors: evecs = inv(U) * evecs
     if(computeEigVecs)
@@ -213,7 +216,7 @@ compute(const MatrixType& matA, const MatrixType& matB, int options)
     matC = matC * cholB.matrixL();
     matC = cholB.matrixU() * matC;
 
-    Base::compute(matC, computeEigVecs ? ComputeEigenvectors : EigenvaluesOnly);
+    Base::compute(matC, solverOptions);
 
     // transform back the eigen vectors: evecs = L * evecs
     if(computeEigVecs)
@@ -26,6 +26,9 @@ template<typename SolverType,int Size,bool IsComplex> struct direct_selfadjoint_
 template<typename MatrixType, typename DiagType, typename SubDiagType>
 EIGEN_DEVICE_FUNC
 ComputationInfo computeFromTridiagonal_impl(DiagType& diag, SubDiagType& subdiag, const Index maxIterations, bool computeEigenvectors, MatrixType& eivec);
+
+template<typename MatrixType, typename DiagType, typename SubDiagType>
+ComputationInfo computeFromTridiagonal_dc(DiagType& diag, SubDiagType& subdiag, const Index maxIterations, bool computeEigenvectors, MatrixType& eivec);
 }
 
 /** \eigenvalues_module \ingroup Eigenvalues_Module
@@ -191,7 +194,8 @@ template<typename MatrixType_> class SelfAdjointEigenSolver
       *
       * \param[in]  matrix  Selfadjoint matrix whose eigendecomposition is to
       *    be computed. Only the lower triangular part of the matrix is referenced.
-      * \param[in]  options Can be #ComputeEigenvectors (default) or #EigenvaluesOnly.
+      * \param[in]  options Can be #ComputeEigenvectors (default) or #EigenvaluesOnly,
+      *    optionally or-ed with #DivideAndConquer.
       * \returns    Reference to \c *this
       *
       * This function computes the eigenvalues of \p matrix.  The eigenvalues()
@@ -208,6 +212,13 @@ template<typename MatrixType_> class SelfAdjointEigenSolver
       * The cost of the computation is about \f$ 9n^3 \f$ if the eigenvectors
       * are required and \f$ 4n^3/3 \f$ if they are not required.
       *
+      * If \p options also contains #DivideAndConquer, the eigenvectors of the
+      * tridiagonal matrix are computed by Cuppen's divide-and-conquer algorithm,
+      * and applied to the Householder reflectors by a single matrix product. This
+      * is usually much faster than the QR algorithm for large matrices.
+      * With #EIGEN_USE_LAPACKE, it selects LAPACK's \c ?syevd / \c ?heevd instead
+      * of \c ?syev / \c ?heev.
+      *
       * This method reuses the memory in the SelfAdjointEigenSolver object that
       * was allocated when the object was constructed, if the size of the
       * matrix does not change.
@@ -247,7 +258,8 @@ template<typename MatrixType_> class SelfAdjointEigenSolver
       *
       * \param[in] diag The vector containing the diagonal of the matrix.
       * \param[in] subdiag The subdiagonal of the matrix.
-      * \param[in] options Can be #ComputeEigenvectors (default) or #EigenvaluesOnly.
+      * \param[in] options Can be #ComputeEigenvectors (default) or #EigenvaluesOnly,
+      *    optionally or-ed with #DivideAndConquer.
       * \returns Reference to \c *this
       *
       * This function assumes that the matrix has been reduced to tridiagonal form.
@@ -426,7 +438,7 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
 
   EIGEN_USING_STD(abs);
   eigen_assert(matrix.cols() == matrix.rows());
-  eigen_assert((options&~(EigVecMask|GenEigMask))==0
+  eigen_assert((options&~(EigVecMask|GenEigMask|DivideAndConquer))==0
           && (options&EigVecMask)!=EigVecMask
           && "invalid option parameter");
   bool computeEigenvectors = (options&ComputeEigenvectors)==ComputeEigenvectors;
@@ -458,7 +470,12 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
   m_hcoeffs.resize(n-1);
   internal::tridiagonalization_inplace(mat, diag, m_subdiag, m_hcoeffs, m_workspace, computeEigenvectors);
 
-  m_info = internal::computeFromTridiagonal_impl(diag, m_subdiag, m_maxIterations, computeEigenvectors, m_eivec);
+#ifndef EIGEN_GPU_COMPILE_PHASE
+  if((options&DivideAndConquer)==DivideAndConquer)
+    m_info = internal::computeFromTridiagonal_dc(diag, m_subdiag, m_maxIterations, computeEigenvectors, m_eivec);
+  else
+#endif
+    m_info = internal::computeFromTridiagonal_impl(diag, m_subdiag, m_maxIterations, computeEigenvectors, m_eivec);
   
   // scale back the eigen values
   m_eivalues *= scale;
@@ -481,7 +498,10 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
   {
     m_eivec.setIdentity(diag.size(), diag.size());
   }
-  m_info = internal::computeFromTridiagonal_impl(m_eivalues, m_subdiag, m_maxIterations, computeEigenvectors, m_eivec);
+  if((options&DivideAndConquer)==DivideAndConquer)
+    m_info = internal::computeFromTridiagonal_dc(m_eivalues, m_subdiag, m_maxIterations, computeEigenvectors, m_eivec);
+  else
+    m_info = internal::computeFromTridiagonal_impl(m_eivalues, m_subdiag, m_maxIterations, computeEigenvectors, m_eivec);
 
   m_isInitialized = true;
   m_eigenvectorsOk = computeEigenvectors;
@@ -0,0 +1,399 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_TRIDIAGONAL_DIVIDE_AND_CONQUER_H
+#define EIGEN_TRIDIAGONAL_DIVIDE_AND_CONQUER_H
+
+#include "./InternalHeaderCheck.h"
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal
+  * Cuppen's divide-and-conquer algorithm for the symmetric tridiagonal eigenproblem.
+  *
+  * The tridiagonal matrix is split into two halves coupled by a rank-one term,
+  * \f$ T = \mathrm{diag}(T_1, T_2) + \rho u u^T \f$. Both halves are diagonalized
+  * recursively, and the eigendecomposition of the rank-one modification
+  * \f$ D + \rho z z^T \f$ of their eigenvalues is obtained from the roots of the
+  * secular equation. As in LAPACK's stedc, close eigenvalues and small components
+  * of \f$ z \f$ are deflated, and the eigenvectors are computed from the recomputed
+  * vector \f$ \hat z \f$ of Gu and Eisenstat so that they are numerically orthogonal.
+  * The eigenvectors of the halves are then updated by products involving only the
+  * nonzero diagonal blocks of their block diagonal matrix.
+  *
+  * Blocks smaller than SmallSize are handled by the implicit QR algorithm.
+  */
+template<typename RealScalar>
+struct tridiagonal_divide_and_conquer
+{
+  typedef Matrix<RealScalar,Dynamic,Dynamic> MatrixXr;
+  typedef Matrix<RealScalar,Dynamic,1> VectorXr;
+  typedef Matrix<Index,Dynamic,1> IndicesType;
+
+  enum { SmallSize = 25 };
+
+  // Diagonalizes the block [start, start+size) of the tridiagonal matrix (diag,subdiag).
+  // On output, diag.segment(start,size) holds the eigenvalues in increasing order and
+  // Z.block(start,start,size,size) the corresponding eigenvectors.
+  static ComputationInfo divide(VectorXr& diag, VectorXr& subdiag, MatrixXr& Z, Index start, Index size, Index maxIterations)
+  {
+    using std::abs;
+    if(size <= SmallSize)
+    {
+      VectorXr d = diag.segment(start,size);
+      VectorXr e = subdiag.segment(start,size-1);
+      MatrixXr q = MatrixXr::Identity(size,size);
+      ComputationInfo info = computeFromTridiagonal_impl(d, e, maxIterations, true, q);
+      diag.segment(start,size) = d;
+      Z.block(start,start,size,size) = q;
+      return info;
+    }
+
+    const Index m = size/2;
+    const RealScalar beta = subdiag.coeff(start+m-1);
+    diag.coeffRef(start+m-1) -= abs(beta);
+    diag.coeffRef(start+m) -= abs(beta);
+
+    ComputationInfo info = divide(diag, subdiag, Z, start, m, maxIterations);
+    if(info != Success)
+      return info;
+    info = divide(diag, subdiag, Z, start+m, size-m, maxIterations);
+    if(info != Success)
+      return info;
+
+    merge(diag, Z, start, size, m, beta);
+    return Success;
+  }
+
+  // Diagonalizes diag(D1,D2) + |beta| z z^T, where z gathers the last row of the
+  // eigenvectors of the first half and the first row of those of the second half.
+  static void merge(VectorXr& diag, MatrixXr& Z, Index start, Index n, Index m, RealScalar beta)
+  {
+    using std::abs;
+    using std::sqrt;
+    const RealScalar eps = NumTraits<RealScalar>::epsilon();
+
+    VectorXr z(n);
+    z.head(m) = Z.row(start+m-1).segment(start,m).transpose();
+    z.tail(n-m) = Z.row(start+m).segment(start+m,n-m).transpose();
+    if(beta < RealScalar(0))
+      z.tail(n-m) = -z.tail(n-m);
+    const RealScalar znorm = z.norm();
+    z /= znorm;
+    const RealScalar rho = abs(beta) * znorm * znorm;
+
+    // sort the eigenvalues of the two halves
+    IndicesType perm(n);
+    for(Index i = 0; i < n; ++i)
+      perm(i) = i;
+    const RealScalar* d0 = diag.data() + start;
+    std::stable_sort(perm.data(), perm.data()+n, [d0](Index a, Index b) { return d0[a] < d0[b]; });
+
+    // Q = diag(Q1,Q2), and colType tells whether each of its columns is nonzero in the first half only,
+    // in the second half only, or in both after a deflation rotation
+    enum { FirstHalf = 0, BothHalves = 1, SecondHalf = 2 };
+    VectorXr d(n);
+    MatrixXr Q(n,n);
+    Matrix<int,Dynamic,1> colType(n);
+    for(Index i = 0; i < n; ++i)
+    {
+      d(i) = d0[perm(i)];
+      Q.col(i) = Z.col(start+perm(i)).segment(start,n);
+      colType(i) = perm(i) < m ? FirstHalf : SecondHalf;
+    }
+    VectorXr zs(n);
+    for(Index i = 0; i < n; ++i)
+      zs(i) = z(perm(i));
+
+    // deflation of the small components of z and of the close eigenvalues
+    const RealScalar tol = RealScalar(8) * eps * (std::max)(d.cwiseAbs().maxCoeff(), rho);
+    IndicesType nonDeflated(n);
+    Index K = 0;
+    Index prev = -1;
+    for(Index i = 0; i < n; ++i)
+    {
+      if(rho * abs(zs(i)) <= tol)
+      {
+        zs(i) = RealScalar(0);
+        continue;
+      }
+      if(prev >= 0)
+      {
+        RealScalar tau = numext::hypot(zs(prev), zs(i));
+        RealScalar c = zs(i) / tau;
+        RealScalar s = -zs(prev) / tau;
+        if(abs((d(i) - d(prev)) * c * s) <= tol)
+        {
+          zs(i) = tau;
+          zs(prev) = RealScalar(0);
+          VectorXr x = Q.col(prev);
+          Q.col(prev) = c * x + s * Q.col(i);
+          Q.col(i) = c * Q.col(i) - s * x;
+          RealScalar t = d(prev) * c * c + d(i) * s * s;
+          d(i) = d(prev) * s * s + d(i) * c * c;
+          d(prev) = t;
+          if(colType(prev) != colType(i))
+            colType(prev) = colType(i) = BothHalves;
+          // prev is deflated, and i replaces it in the list of non deflated entries
+          nonDeflated(K-1) = i;
+          prev = i;
+          continue;
+        }
+      }
+      nonDeflated(K++) = i;
+      prev = i;
+    }
+
+    if(K > 0)
+    {
+      VectorXr dk(K), zk(K);
+      for(Index j = 0; j < K; ++j)
+      {
+        dk(j) = d(nonDeflated(j));
+        zk(j) = zs(nonDeflated(j));
+      }
+
+      // roots of the secular equation, stored as lambda_j = dk(origins(j)) + mus(j)
+      IndicesType origins(K);
+      VectorXr mus(K);
+      for(Index j = 0; j < K; ++j)
+        secularRoot(dk, zk, rho, j, origins(j), mus(j));
+
+      // Gu and Eisenstat's recomputation of z from the computed eigenvalues
+      VectorXr zhat(K);
+      for(Index i = 0; i < K; ++i)
+      {
+        RealScalar prod = (dk(origins(K-1)) - dk(i)) + mus(K-1);
+        for(Index j = 0; j < i; ++j)
+          prod *= ((dk(origins(j)) - dk(i)) + mus(j)) / (dk(j) - dk(i));
+        for(Index j = i; j < K-1; ++j)
+          prod *= ((dk(origins(j)) - dk(i)) + mus(j)) / (dk(j+1) - dk(i));
+        zhat(i) = zk(i) < RealScalar(0) ? -sqrt(abs(prod) / rho) : sqrt(abs(prod) / rho);
+      }
+
+      MatrixXr V(K,K);
+      for(Index j = 0; j < K; ++j)
+      {
+        for(Index i = 0; i < K; ++i)
+          V(i,j) = zhat(i) / ((dk(origins(j)) - dk(i)) + mus(j));
+        V.col(j).normalize();
+      }
+
+      // As in LAPACK's dlaed3, the columns of Q are grouped by type so that the product by V
+      // only involves the nonzero blocks of Q: rows of the first half times the columns of
+      // the first two types, and rows of the second half times the columns of the last two.
+      Index typeCount[3] = {0, 0, 0};
+      for(Index j = 0; j < K; ++j)
+        ++typeCount[colType(nonDeflated(j))];
+      Index typeStart[3] = {0, typeCount[FirstHalf], typeCount[FirstHalf] + typeCount[BothHalves]};
+      MatrixXr Qk(n,K), Vk(K,K);
+      for(Index j = 0; j < K; ++j)
+      {
+        const Index p = typeStart[colType(nonDeflated(j))]++;
+        Qk.col(p) = Q.col(nonDeflated(j));
+        Vk.row(p) = V.row(j);
+      }
+      const Index n12 = typeCount[FirstHalf] + typeCount[BothHalves];
+      const Index n23 = typeCount[BothHalves] + typeCount[SecondHalf];
+      MatrixXr QV(n,K);
+      QV.topRows(m).noalias() = Qk.topLeftCorner(m,n12) * Vk.topRows(n12);
+      QV.bottomRows(n-m).noalias() = Qk.bottomRightCorner(n-m,n23) * Vk.bottomRows(n23);
+      for(Index j = 0; j < K; ++j)
+      {
+        Q.col(nonDeflated(j)) = QV.col(j);
+        d(nonDeflated(j)) = dk(origins(j)) + mus(j);
+      }
+    }
+
+    // sort back the eigenvalues and eigenvectors
+    for(Index i = 0; i < n; ++i)
+      perm(i) = i;
+    std::stable_sort(perm.data(), perm.data()+n, [&d](Index a, Index b) { return d(a) < d(b); });
+    for(Index i = 0; i < n; ++i)
+    {
+      diag(start+i) = d(perm(i));
+      Z.col(start+i).segment(start,n) = Q.col(perm(i));
+    }
+  }
+
+  // Computes the k-th root of f(x) = 1 + rho * sum_j z_j^2 / (d_j - x), where d is increasing
+  // and rho > 0. The root is returned as d(origin) + mu, where origin is the closest pole,
+  // so that its distance to the poles can be computed accurately.
+  static void secularRoot(const VectorXr& d, const VectorXr& z, RealScalar rho, Index k, Index& origin, RealScalar& mu)
+  {
+    using std::abs;
+    using std::sqrt;
+    const RealScalar eps = NumTraits<RealScalar>::epsilon();
+    const Index K = d.size();
+    const bool last = (k == K-1);
+
+    RealScalar lo, hi;
+    RealScalar gap = last ? RealScalar(0) : d(k+1) - d(k);
+    if(last)
+    {
+      origin = k;
+      lo = RealScalar(0);
+      hi = rho * z.squaredNorm();
+    }
+    else
+    {
+      if(gap <= RealScalar(0))
+      {
+        origin = k;
+        mu = RealScalar(0);
+        return;
+      }
+      RealScalar mid = gap / RealScalar(2);
+      RealScalar fmid = RealScalar(1);
+      for(Index j = 0; j < K; ++j)
+        fmid += rho * z(j) * z(j) / ((d(j) - d(k)) - mid);
+      if(fmid >= RealScalar(0))
+      {
+        origin = k;
+        lo = RealScalar(0);
+        hi = mid;
+      }
+      else
+      {
+        origin = k+1;
+        lo = -mid;
+        hi = RealScalar(0);
+      }
+    }
+    if(K == 1)
+    {
+      mu = hi;
+      return;
+    }
+
+    VectorXr delta = d.array() - d(origin);
+    // poles bracketing the root, relative to the origin
+    const RealScalar left = delta(k);
+    const RealScalar right = last ? RealScalar(0) : delta(k+1);
+
+    mu = (lo + hi) / RealScalar(2);
+    for(Index iter = 0; iter < 100; ++iter)
+    {
+      RealScalar psi = 0, dpsi = 0, phi = 0, dphi = 0;
+      for(Index j = 0; j <= k; ++j)
+      {
+        RealScalar t = z(j) / (delta(j) - mu);
+        psi += z(j) * t;
+        dpsi += t * t;
+      }
+      for(Index j = k+1; j < K; ++j)
+      {
+        RealScalar t = z(j) / (delta(j) - mu);
+        phi += z(j) * t;
+        dphi += t * t;
+      }
+      psi *= rho; dpsi *= rho; phi *= rho; dphi *= rho;
+      const RealScalar f = RealScalar(1) + psi + phi;
+
+      if(f < RealScalar(0)) lo = mu;
+      else                  hi = mu;
+
+      const RealScalar erretm = RealScalar(8) * (phi - psi) + RealScalar(2) + abs(mu) * (dpsi + dphi);
+      if(abs(f) <= RealScalar(K) * eps * erretm)
+        break;
+      if(hi - lo <= RealScalar(2) * eps * (std::max)(abs(lo), abs(hi)) || hi - lo <= (std::numeric_limits<RealScalar>::min)())
+        break;
+
+      // Approximate psi and phi by a + b/(left-x) and c + e/(right-x) matching their value
+      // and derivative at mu, and take the root of the resulting rational function.
+      const RealScalar b = dpsi * (left - mu) * (left - mu);
+      const RealScalar a = psi - dpsi * (left - mu);
+      RealScalar next;
+      if(last)
+      {
+        // 1 + a + b/(left-x) = 0 with left == 0
+        next = b / (RealScalar(1) + a);
+      }
+      else
+      {
+        const RealScalar e = dphi * (right - mu) * (right - mu);
+        const RealScalar c = phi - dphi * (right - mu);
+        const RealScalar C = RealScalar(1) + a + c;
+        RealScalar t;
+        if(origin == k)
+        {
+          // solve for P = -x in (-gap,0): C P^2 + (C gap + b + e) P + b gap = 0
+          t = quadraticRoot(C, C*gap + b + e, b*gap, -gap, RealScalar(0));
+          next = -t;
+        }
+        else
+        {
+          // solve for Q = -x in (0,gap): C Q^2 + (-C gap + b + e) Q - e gap = 0
+          t = quadraticRoot(C, -C*gap + b + e, -e*gap, RealScalar(0), gap);
+          next = -t;
+        }
+      }
+      if(!(next > lo && next < hi))
+        next = (lo + hi) / RealScalar(2);
+      mu = next;
+    }
+  }
+
+  // Returns a root of alpha x^2 + beta x + gamma in (lo,hi), or NaN if none is found.
+  static RealScalar quadraticRoot(RealScalar alpha, RealScalar beta, RealScalar gamma, RealScalar lo, RealScalar hi)
+  {
+    using std::abs;
+    using std::sqrt;
+    const RealScalar nan = NumTraits<RealScalar>::quiet_NaN();
+    if(numext::is_exactly_zero(alpha))
+      return numext::is_exactly_zero(beta) ? nan : -gamma / beta;
+    RealScalar disc = beta * beta - RealScalar(4) * alpha * gamma;
+    if(disc < RealScalar(0))
+      return nan;
+    RealScalar q = beta >= RealScalar(0) ? -(beta + sqrt(disc)) / RealScalar(2) : -(beta - sqrt(disc)) / RealScalar(2);
+    RealScalar x1 = q / alpha;
+    RealScalar x2 = numext::is_exactly_zero(q) ? nan : gamma / q;
+    if(x1 > lo && x1 < hi) return x1;
+    return x2;
+  }
+};
+
+/** \internal
+  * \brief Compute the eigendecomposition from a tridiagonal matrix by divide-and-conquer
+  *
+  * Same as computeFromTridiagonal_impl(), but the eigenvectors of the tridiagonal matrix are
+  * computed by tridiagonal_divide_and_conquer, and then applied to \a eivec by a single matrix
+  * product. Only the eigenvalues are computed by the implicit QR algorithm if
+  * \a computeEigenvectors is false.
+  */
+template<typename MatrixType, typename DiagType, typename SubDiagType>
+ComputationInfo computeFromTridiagonal_dc(DiagType& diag, SubDiagType& subdiag, const Index maxIterations, bool computeEigenvectors, MatrixType& eivec)
+{
+  typedef typename DiagType::RealScalar RealScalar;
+  typedef tridiagonal_divide_and_conquer<RealScalar> Impl;
+  const Index n = diag.size();
+  if(!computeEigenvectors || n <= Impl::SmallSize)
+    return computeFromTridiagonal_impl(diag, subdiag, maxIterations, computeEigenvectors, eivec);
+
+  // map the coefficients to [-1:1] to avoid over- and underflow.
+  RealScalar scale = (std::max)(diag.cwiseAbs().maxCoeff(), subdiag.cwiseAbs().maxCoeff());
+  if(numext::is_exactly_zero(scale)) scale = RealScalar(1);
+  typename Impl::VectorXr d = diag / scale;
+  typename Impl::VectorXr e = subdiag / scale;
+  typename Impl::MatrixXr Z = Impl::MatrixXr::Zero(n,n);
+
+  ComputationInfo info = Impl::divide(d, e, Z, 0, n, maxIterations);
+  if(info != Success)
+    return info;
+
+  diag = d * scale;
+  eivec = eivec * Z;
+  return Success;
+}
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_TRIDIAGONAL_DIVIDE_AND_CONQUER_H
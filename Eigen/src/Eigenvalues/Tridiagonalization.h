@@ -323,6 +323,13 @@ Tridiagonalization<MatrixType>::subDiagonal() const
 
 namespace internal {
 
+// forward declarations, implementation below
+template<typename MatrixType, typename CoeffVectorType>
+EIGEN_DEVICE_FUNC
+void tridiagonalization_inplace_unblocked(MatrixType& matA, CoeffVectorType& hCoeffs);
+template<typename MatrixType, typename CoeffVectorType>
+void tridiagonalization_inplace_blocked(MatrixType& matA, CoeffVectorType& hCoeffs, Index maxBlockSize=32);
+
 /** \internal
   * Performs a tridiagonal decomposition of the selfadjoint matrix \a matA in-place.
   *
@@ -344,11 +351,31 @@ namespace internal {
   *
   * Implemented from Golub's "Matrix Computations", algorithm 8.3.1.
   *
+  * Large dynamic-size matrices are reduced by tridiagonalization_inplace_blocked().
+  *
   * \sa Tridiagonalization::packedMatrix()
   */
 template<typename MatrixType, typename CoeffVectorType>
 EIGEN_DEVICE_FUNC
 void tridiagonalization_inplace(MatrixType& matA, CoeffVectorType& hCoeffs)
+{
+#ifndef EIGEN_GPU_COMPILE_PHASE
+  if(MatrixType::RowsAtCompileTime==Dynamic && matA.rows()>128)
+  {
+    tridiagonalization_inplace_blocked(matA, hCoeffs);
+    return;
+  }
+#endif
+  tridiagonalization_inplace_unblocked(matA, hCoeffs);
+}
+
+/** \internal
+  * Column by column version of tridiagonalization_inplace(): each reflector is applied
+  * to the trailing matrix by a rank-2 update.
+  */
+template<typename MatrixType, typename CoeffVectorType>
+EIGEN_DEVICE_FUNC
+void tridiagonalization_inplace_unblocked(MatrixType& matA, CoeffVectorType& hCoeffs)
 {
   using numext::conj;
   typedef typename MatrixType::Scalar Scalar;
@@ -381,6 +408,106 @@ void tridiagonalization_inplace(MatrixType& matA, CoeffVectorType& hCoeffs)
   }
 }
 
+/** \internal
+  * Applies mat(start:start+n, start:start+n) -= V * W^* + W * V^* to the lower triangular part,
+  * where V = mat(start:start+n, k:k+bs) and W = W(start:start+n, 0:bs).
+  * The triangle is split recursively so that most of the flops are performed by
+  * general matrix products, which can be parallelized, rather than by the
+  * triangular product kernel.
+  */
+template<typename MatrixType, typename WorkspaceType>
+void tridiagonalization_trailing_update(MatrixType& mat, const WorkspaceType& W, Index k, Index bs, Index start, Index n)
+{
+  if(n <= 256)
+  {
+    mat.block(start,start,n,n).template triangularView<Lower>() -= mat.block(start,k,n,bs) * W.block(start,0,n,bs).adjoint();
+    mat.block(start,start,n,n).template triangularView<Lower>() -= W.block(start,0,n,bs) * mat.block(start,k,n,bs).adjoint();
+    return;
+  }
+  const Index h = (n/2/16)*16;
+  tridiagonalization_trailing_update(mat, W, k, bs, start, h);
+  mat.block(start+h,start,n-h,h).noalias() -= mat.block(start+h,k,n-h,bs) * W.block(start,0,h,bs).adjoint();
+  mat.block(start+h,start,n-h,h).noalias() -= W.block(start+h,0,n-h,bs) * mat.block(start,k,h,bs).adjoint();
+  tridiagonalization_trailing_update(mat, W, k, bs, start+h, n-h);
+}
+
+/** \internal
+  * Blocked version of tridiagonalization_inplace() following LAPACK's sytrd.
+  *
+  * The reflectors of a panel of \a maxBlockSize columns are computed one after the
+  * other, the matrix being only updated on the fly for the current column (as in latrd).
+  * The whole trailing matrix is then updated at once by the rank-2k update
+  * \f$ A_{22} = A_{22} - V W^* - W V^* \f$. The last columns are reduced by
+  * tridiagonalization_inplace_unblocked().
+  */
+template<typename MatrixType, typename CoeffVectorType>
+void tridiagonalization_inplace_blocked(MatrixType& matA, CoeffVectorType& hCoeffs, Index maxBlockSize)
+{
+  using numext::conj;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  Index n = matA.rows();
+  eigen_assert(n==matA.cols());
+  eigen_assert(n==hCoeffs.size()+1 || n==1);
+
+  const Index crossover = (std::max)(Index(128), maxBlockSize);
+  const Index blockSize = maxBlockSize;
+  Matrix<Scalar,Dynamic,Dynamic> W(n, blockSize);
+  Matrix<Scalar,Dynamic,1> tmp(blockSize);
+  Matrix<RealScalar,Dynamic,1> betas(blockSize);
+
+  Index k = 0;
+  for(; n-k > crossover; k += blockSize)
+  {
+    // Reduce the panel matA(k:n, k:k+blockSize). The trailing matrix is not updated yet,
+    // so that its actual value is matA - V W^* - W V^* where V holds the previous reflectors
+    // of the panel (with their unit entry in place) and W the corresponding vectors w.
+    for(Index j = k; j < k+blockSize; ++j)
+    {
+      Index jj = j-k;
+      if(jj>0)
+      {
+        matA.col(j).tail(n-j).noalias() -= matA.block(j,k,n-j,jj) * W.row(j).head(jj).adjoint();
+        matA.col(j).tail(n-j).noalias() -= W.block(j,0,n-j,jj) * matA.row(j).segment(k,jj).adjoint();
+      }
+
+      Index remainingSize = n-j-1;
+      RealScalar beta;
+      Scalar h;
+      matA.col(j).tail(remainingSize).makeHouseholderInPlace(h, beta);
+      matA.col(j).coeffRef(j+1) = 1;
+      betas.coeffRef(jj) = beta;
+      hCoeffs.coeffRef(j) = h;
+
+      W.col(jj).tail(remainingSize).noalias() = matA.bottomRightCorner(remainingSize,remainingSize).template selfadjointView<Lower>()
+                                             * matA.col(j).tail(remainingSize);
+      if(jj>0)
+      {
+        tmp.head(jj).noalias() = W.block(j+1,0,remainingSize,jj).adjoint() * matA.col(j).tail(remainingSize);
+        W.col(jj).tail(remainingSize).noalias() -= matA.block(j+1,k,remainingSize,jj) * tmp.head(jj);
+        tmp.head(jj).noalias() = matA.block(j+1,k,remainingSize,jj).adjoint() * matA.col(j).tail(remainingSize);
+        W.col(jj).tail(remainingSize).noalias() -= W.block(j+1,0,remainingSize,jj) * tmp.head(jj);
+      }
+      W.col(jj).tail(remainingSize) *= conj(h);
+      W.col(jj).tail(remainingSize) += (conj(h)*RealScalar(-0.5)*(W.col(jj).tail(remainingSize).dot(matA.col(j).tail(remainingSize))))
+                                     * matA.col(j).tail(remainingSize);
+    }
+
+    const Index k1 = k+blockSize;
+    tridiagonalization_trailing_update(matA, W, k, blockSize, k1, n-k1);
+
+    for(Index jj = 0; jj < blockSize; ++jj)
+      matA.coeffRef(k+jj+1,k+jj) = betas.coeff(jj);
+  }
+
+  if(n-k > 1)
+  {
+    Block<MatrixType,Dynamic,Dynamic> A22(matA,k,k,n-k,n-k);
+    VectorBlock<CoeffVectorType> hCoeffs22(hCoeffs,k,n-k-1);
+    tridiagonalization_inplace_unblocked(A22, hCoeffs22);
+  }
+}
+
 // forward declaration, implementation at the end of this file
 template<typename MatrixType,
          int Size=MatrixType::ColsAtCompileTime,
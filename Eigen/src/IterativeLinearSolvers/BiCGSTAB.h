@@ -108,6 +108,111 @@ bool bicgstab(const MatrixType& mat, const Rhs& rhs, Dest& x,
   return true; 
 }
 
+/** \internal Same as bicgstab(), but the vector updates are fused with the reductions that follow them,
+  * and run by blocks on parallel_loop_threads() threads (see fused_vector_reduce()). In particular, the
+  * updates of the solution and of the residual, the norm of the latter and its dot product with r0
+  * take a single pass.
+  */
+template<typename MatrixType, typename Rhs, typename Dest, typename Preconditioner>
+bool bicgstab_fused(const MatrixType& mat, const Rhs& rhs, Dest& x,
+                    const Preconditioner& precond, Index& iters,
+                    typename Dest::RealScalar& tol_error)
+{
+  using std::sqrt;
+  using std::abs;
+  typedef typename Dest::RealScalar RealScalar;
+  typedef typename Dest::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  typedef Matrix<Scalar,2,1> PairType;
+  RealScalar tol = tol_error;
+  Index maxIters = iters;
+
+  Index n = mat.cols();
+  VectorType r  = rhs - mat * x;
+  VectorType r0 = r;
+
+  RealScalar r0_sqnorm = r0.squaredNorm();
+  RealScalar rhs_sqnorm = rhs.squaredNorm();
+  if(rhs_sqnorm == 0)
+  {
+    x.setZero();
+    return true;
+  }
+  Scalar rho    (1);
+  Scalar alpha  (1);
+  Scalar w      (1);
+
+  VectorType v = VectorType::Zero(n), p = VectorType::Zero(n);
+  VectorType y(n),  z(n);
+
+  VectorType s(n), t(n);
+
+  RealScalar tol2 = tol*tol*rhs_sqnorm;
+  RealScalar eps2 = NumTraits<Scalar>::epsilon()*NumTraits<Scalar>::epsilon();
+  Index i = 0;
+  Index restarts = 0;
+
+  // r.squaredNorm() and r0.dot(r), updated along with r
+  RealScalar r_sqnorm = r0_sqnorm;
+  Scalar r0_dot_r = r0_sqnorm;
+
+  while ( r_sqnorm > tol2 && i<maxIters )
+  {
+    Scalar rho_old = rho;
+
+    rho = r0_dot_r;
+    if (abs(rho) < eps2*r0_sqnorm)
+    {
+      // The new residual vector became too orthogonal to the arbitrarily chosen direction r0
+      // Let's restart with a new r0:
+      r  = rhs - mat * x;
+      r0 = r;
+      rho = r0_sqnorm = r.squaredNorm();
+      if(restarts++ == 0)
+        i = 0;
+    }
+    Scalar beta = (rho/rho_old) * (alpha / w);
+    fused_vector_update(n, [&](Index start, Index size) {
+      p.segment(start,size) = r.segment(start,size) + beta * (p.segment(start,size) - w * v.segment(start,size));
+    });
+
+    y = precond.solve(p);
+
+    v.noalias() = mat * y;
+
+    alpha = rho / fused_vector_dot(r0, v);
+    fused_vector_update(n, [&](Index start, Index size) {
+      s.segment(start,size) = r.segment(start,size) - alpha * v.segment(start,size);
+    });
+
+    z = precond.solve(s);
+    t.noalias() = mat * z;
+
+    // t.squaredNorm() and t.dot(s)
+    PairType tt_ts = fused_vector_reduce<PairType>(n, [&](Index start, Index size) {
+      return PairType(t.segment(start,size).squaredNorm(), t.segment(start,size).dot(s.segment(start,size)));
+    });
+    RealScalar tmp = numext::real(tt_ts(0));
+    if(tmp>RealScalar(0))
+      w = tt_ts(1) / tmp;
+    else
+      w = Scalar(0);
+
+    // x += alpha * y + w * z; r = s - w * t; followed by r.squaredNorm() and r0.dot(r)
+    PairType norms = fused_vector_reduce<PairType>(n, [&](Index start, Index size) {
+      x.segment(start,size) += alpha * y.segment(start,size) + w * z.segment(start,size);
+      r.segment(start,size) = s.segment(start,size) - w * t.segment(start,size);
+      return PairType(r.segment(start,size).squaredNorm(), r0.segment(start,size).dot(r.segment(start,size)));
+    });
+    r_sqnorm = numext::real(norms(0));
+    r0_dot_r = norms(1);
+    ++i;
+  }
+  tol_error = sqrt(r.squaredNorm()/rhs_sqnorm);
+  iters = i;
+  return true;
+}
+
 }
 
 template< typename MatrixType_,
@@ -198,7 +303,9 @@ public:
     m_iterations = Base::maxIterations();
     m_error = Base::m_tolerance;
     
-    bool ret = internal::bicgstab(matrix(), b, x, Base::m_preconditioner, m_iterations, m_error);
+    bool ret = Base::fusedIterations()
+             ? internal::bicgstab_fused(matrix(), b, x, Base::m_preconditioner, m_iterations, m_error)
+             : internal::bicgstab(matrix(), b, x, Base::m_preconditioner, m_iterations, m_error);
 
     m_info = (!ret) ? NumericalIssue
            : m_error <= Base::m_tolerance ? Success
@@ -90,6 +90,80 @@ void conjugate_gradient(const MatrixType& mat, const Rhs& rhs, Dest& x,
   iters = i;
 }
 
+/** \internal Same as conjugate_gradient(), but the vector updates are fused with the reductions that
+  * follow them, and run by blocks on parallel_loop_threads() threads (see fused_vector_reduce()).
+  * The updates of the solution and of the residual, and the norm of the latter, take a single pass.
+  */
+template<typename MatrixType, typename Rhs, typename Dest, typename Preconditioner>
+EIGEN_DONT_INLINE
+void conjugate_gradient_fused(const MatrixType& mat, const Rhs& rhs, Dest& x,
+                              const Preconditioner& precond, Index& iters,
+                              typename Dest::RealScalar& tol_error)
+{
+  typedef typename Dest::RealScalar RealScalar;
+  typedef typename Dest::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  typedef Matrix<RealScalar,1,1> RealResult;
+
+  RealScalar tol = tol_error;
+  Index maxIters = iters;
+
+  Index n = mat.cols();
+
+  VectorType residual = rhs - mat * x; //initial residual
+
+  RealScalar rhsNorm2 = rhs.squaredNorm();
+  if(rhsNorm2 == 0)
+  {
+    x.setZero();
+    iters = 0;
+    tol_error = 0;
+    return;
+  }
+  const RealScalar considerAsZero = (std::numeric_limits<RealScalar>::min)();
+  RealScalar threshold = numext::maxi(RealScalar(tol*tol*rhsNorm2),considerAsZero);
+  RealScalar residualNorm2 = residual.squaredNorm();
+  if (residualNorm2 < threshold)
+  {
+    iters = 0;
+    tol_error = numext::sqrt(residualNorm2 / rhsNorm2);
+    return;
+  }
+
+  VectorType p(n);
+  p = precond.solve(residual);      // initial search direction
+
+  VectorType z(n), tmp(n);
+  RealScalar absNew = numext::real(fused_vector_dot(residual, p));
+  Index i = 0;
+  while(i < maxIters)
+  {
+    tmp.noalias() = mat * p;
+
+    Scalar alpha = absNew / fused_vector_dot(p, tmp);
+    // x += alpha * p; residual -= alpha * tmp; residualNorm2 = residual.squaredNorm();
+    residualNorm2 = fused_vector_reduce<RealResult>(n, [&](Index start, Index size) {
+      x.segment(start,size) += alpha * p.segment(start,size);
+      residual.segment(start,size) -= alpha * tmp.segment(start,size);
+      return RealResult(residual.segment(start,size).squaredNorm());
+    }).value();
+    if(residualNorm2 < threshold)
+      break;
+
+    z = precond.solve(residual);
+
+    RealScalar absOld = absNew;
+    absNew = numext::real(fused_vector_dot(residual, z));
+    RealScalar beta = absNew / absOld;
+    fused_vector_update(n, [&](Index start, Index size) {
+      p.segment(start,size) = z.segment(start,size) + beta * p.segment(start,size);
+    });
+    i++;
+  }
+  tol_error = numext::sqrt(residualNorm2 / rhsNorm2);
+  iters = i;
+}
+
 }
 
 template< typename MatrixType_, int UpLo_=Lower,
@@ -130,7 +204,8 @@ struct traits<ConjugateGradient<MatrixType_,UpLo_,Preconditioner_> >
   * \b Performance: Even though the default value of \c UpLo_ is \c Lower, significantly higher performance is
   * achieved when using a complete matrix and \b Lower|Upper as the \a UpLo_ template parameter. Moreover, in this
   * case multi-threading can be exploited if the user code is compiled with OpenMP enabled.
-  * See \ref TopicMultiThreading for details.
+  * See \ref TopicMultiThreading for details. Calling setFusedIterations(true) additionally fuses the
+  * vector updates of each iteration with the following norm and dot products, and multi-threads them.
   * 
   * This class can be used as the direct solver classes. Here is a typical usage example:
     \code
@@ -216,7 +291,10 @@ public:
     m_error = Base::m_tolerance;
 
     RowMajorWrapper row_mat(matrix());
-    internal::conjugate_gradient(SelfAdjointWrapper(row_mat), b, x, Base::m_preconditioner, m_iterations, m_error);
+    if(Base::fusedIterations())
+      internal::conjugate_gradient_fused(SelfAdjointWrapper(row_mat), b, x, Base::m_preconditioner, m_iterations, m_error);
+    else
+      internal::conjugate_gradient(SelfAdjointWrapper(row_mat), b, x, Base::m_preconditioner, m_iterations, m_error);
     m_info = m_error <= Base::m_tolerance ? Success : NoConvergence;
   }
 
@@ -0,0 +1,71 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_FUSED_VECTOR_KERNELS_H
+#define EIGEN_FUSED_VECTOR_KERNELS_H
+
+#include "./InternalHeaderCheck.h"
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal
+  * Applies \a func(start,size) to consecutive blocks covering [0,n), and returns the sum of the
+  * values of type \a ResultType (a fixed size vector) it returns.
+  *
+  * Long vectors are split into one contiguous range per thread. Each range is processed by blocks
+  * of BlockSize coefficients, so that a function updating a vector and then reducing it reads the
+  * updated coefficients back from the cache rather than from memory. The partial sums are added in
+  * a fixed order, so that the result only depends on the number of threads.
+  */
+template<typename ResultType, typename Func>
+ResultType fused_vector_reduce(Index n, const Func& func)
+{
+  enum { BlockSize = 2048, ParallelThreshold = 65536 };
+  const Index threads = n < ParallelThreshold ? 1 : (std::min)(parallel_loop_threads(), n/(ParallelThreshold/2));
+
+  ei_declare_aligned_stack_constructed_variable(ResultType,partial,threads,0);
+  parallelize_tasks(threads, [&](Index t) {
+    const Index begin = (n*t)/threads, end = (n*(t+1))/threads;
+    ResultType acc = ResultType::Zero();
+    for(Index start = begin; start < end; start += BlockSize)
+      acc += func(start, (std::min)(Index(BlockSize), end-start));
+    partial[t] = acc;
+  });
+
+  ResultType res = partial[0];
+  for(Index t = 1; t < threads; ++t)
+    res += partial[t];
+  return res;
+}
+
+/** \internal Same as fused_vector_reduce() for a function \a func(start,size) returning nothing. */
+template<typename Func>
+void fused_vector_update(Index n, const Func& func)
+{
+  typedef Matrix<int,1,1> Dummy;
+  fused_vector_reduce<Dummy>(n, [&](Index start, Index size) { func(start, size); return Dummy::Zero(); });
+}
+
+/** \internal \returns a.dot(b), computed by fused_vector_reduce(). */
+template<typename VectorA, typename VectorB>
+typename ScalarBinaryOpTraits<typename VectorA::Scalar, typename VectorB::Scalar>::ReturnType
+fused_vector_dot(const VectorA& a, const VectorB& b)
+{
+  typedef typename ScalarBinaryOpTraits<typename VectorA::Scalar, typename VectorB::Scalar>::ReturnType Scalar;
+  typedef Matrix<Scalar,1,1> ResultType;
+  return fused_vector_reduce<ResultType>(a.size(), [&](Index start, Index size) {
+    return ResultType(a.segment(start,size).dot(b.segment(start,size)));
+  }).value();
+}
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_FUSED_VECTOR_KERNELS_H
@@ -41,6 +41,10 @@ namespace Eigen {
   * If the factorization fails, then the shift in doubled until it succeed or a maximum of ten attempts. If it still fails, as returned by
   * the info() method, then you can either increase the initial shift, or better use another preconditioning technique.
   *
+  * \b Multi-threading: when multi-threading is enabled while factorize() is called (see \ref TopicMultiThreading), it also
+  * computes level schedules of the triangular solves with L and L', together with a row-major copy of L. The rows of each
+  * level are then solved concurrently by each call to solve(), for the cost of this additional copy.
+  *
   */
 template <typename Scalar, int UpLo_ = Lower, typename OrderingType_ = AMDOrdering<int> >
 class IncompleteCholesky : public SparseSolverBase<IncompleteCholesky<Scalar,UpLo_,OrderingType_> >
@@ -153,8 +157,16 @@ class IncompleteCholesky : public SparseSolverBase<IncompleteCholesky<Scalar,UpL
       if (m_perm.rows() == b.rows())  x = m_perm * b;
       else                            x = b;
       x = m_scale.asDiagonal() * x;
-      x = m_L.template triangularView<Lower>().solve(x);
-      x = m_L.adjoint().template triangularView<Upper>().solve(x);
+      if(m_lowerLevels.isAnalyzed())
+      {
+        m_lowerLevels.template solveInPlace<Lower>(m_rowMajorL, x);
+        m_upperLevels.template solveInPlace<Upper>(m_L.adjoint(), x);
+      }
+      else
+      {
+        x = m_L.template triangularView<Lower>().solve(x);
+        x = m_L.adjoint().template triangularView<Upper>().solve(x);
+      }
       x = m_scale.asDiagonal() * x;
       if (m_perm.rows() == b.rows())
         x = m_perm.inverse() * x;
@@ -177,6 +189,9 @@ class IncompleteCholesky : public SparseSolverBase<IncompleteCholesky<Scalar,UpL
     bool m_factorizationIsOk;
     ComputationInfo m_info;
     PermutationType m_perm;
+    SparseMatrix<Scalar,RowMajor,StorageIndex> m_rowMajorL;         // copy of L for the parallel forward substitution
+    internal::sparse_triangular_levels<StorageIndex> m_lowerLevels; // level schedules of the triangular solves, if computed
+    internal::sparse_triangular_levels<StorageIndex> m_upperLevels;
 
   private:
     inline void updateList(Ref<const VectorIx> colPtr, Ref<VectorIx> rowIdx, Ref<VectorSx> vals, const Index& col, const Index& jk, VectorIx& firstElt, VectorList& listCol);
@@ -192,6 +207,9 @@ void IncompleteCholesky<Scalar,UpLo_, OrderingType>::factorize(const MatrixType_
 {
   using std::sqrt;
   eigen_assert(m_analysisIsOk && "analyzePattern() should be called first");
+  m_lowerLevels.clear();
+  m_upperLevels.clear();
+  m_rowMajorL.resize(0,0);
 
   // Dropping strategy : Keep only the p largest elements per column, where p is the number of elements in the column of the original matrix. Other strategies will be added
 
@@ -368,6 +386,13 @@ void IncompleteCholesky<Scalar,UpLo_, OrderingType>::factorize(const MatrixType_
       m_info = Success;
     }
   } while(m_info!=Success);
+
+  if(internal::parallel_loop_threads()>1)
+  {
+    m_rowMajorL = m_L;
+    m_lowerLevels.template analyze<Lower>(m_rowMajorL);
+    m_upperLevels.template analyze<Upper>(m_L.adjoint());
+  }
 }
 
 template<typename Scalar, int UpLo_, typename OrderingType>
@@ -84,6 +84,9 @@ Index QuickSplit(VectorV &row, VectorI &ind, Index ncut)
   * The two extreme cases are when @p droptol=0 (to keep all the @p fill*2 largest elements)
   * and when @p fill=n/2 with @p droptol being different to zero.
   *
+  * When multi-threading is enabled while factorize() is called (see \ref TopicMultiThreading), it also computes
+  * level schedules of the two triangular solves, whose independent rows are then solved concurrently by solve().
+  *
   * References : Yousef Saad, ILUT: A dual threshold incomplete LU factorization,
   *              Numerical Linear Algebra with Applications, 1(4), pp 387-402, 1994.
   *
@@ -173,8 +176,16 @@ class IncompleteLUT : public SparseSolverBase<IncompleteLUT<Scalar_, StorageInde
     void _solve_impl(const Rhs& b, Dest& x) const
     {
       x = m_Pinv * b;
-      x = m_lu.template triangularView<UnitLower>().solve(x);
-      x = m_lu.template triangularView<Upper>().solve(x);
+      if(m_lowerLevels.isAnalyzed())
+      {
+        m_lowerLevels.template solveInPlace<UnitLower>(m_lu, x);
+        m_upperLevels.template solveInPlace<Upper>(m_lu, x);
+      }
+      else
+      {
+        x = m_lu.template triangularView<UnitLower>().solve(x);
+        x = m_lu.template triangularView<Upper>().solve(x);
+      }
       x = m_P * x;
     }
 
@@ -198,6 +209,8 @@ protected:
     ComputationInfo m_info;
     PermutationMatrix<Dynamic,Dynamic,StorageIndex> m_P;     // Fill-reducing permutation
     PermutationMatrix<Dynamic,Dynamic,StorageIndex> m_Pinv;  // Inverse permutation
+    internal::sparse_triangular_levels<StorageIndex> m_lowerLevels; // level schedules of the triangular solves, if computed
+    internal::sparse_triangular_levels<StorageIndex> m_upperLevels;
 };
 
 /**
@@ -446,6 +459,14 @@ void IncompleteLUT<Scalar,StorageIndex>::factorize(const MatrixType_& amat)
   m_lu.finalize();
   m_lu.makeCompressed();
 
+  m_lowerLevels.clear();
+  m_upperLevels.clear();
+  if(internal::parallel_loop_threads()>1)
+  {
+    m_lowerLevels.template analyze<UnitLower>(m_lu);
+    m_upperLevels.template analyze<Upper>(m_lu);
+  }
+
   m_factorizationIsOk = true;
   m_info = Success;
 }
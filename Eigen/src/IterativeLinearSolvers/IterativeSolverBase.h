@@ -297,6 +297,26 @@ public:
     return derived();
   }
 
+  /** \returns whether the iterations fuse their vector updates with the following reductions.
+    * \sa setFusedIterations()
+    */
+  bool fusedIterations() const { return m_fusedIterations; }
+
+  /** Enables or disables the fused execution of the iterations (disabled by default).
+    *
+    * In this mode, the vector updates of an iteration are merged with the norms and dot products that
+    * follow them into single passes over memory, which are multi-threaded like the matrix-vector
+    * products (see \ref TopicMultiThreading). This mostly pays off for large problems, whose vectors do
+    * not fit in the cache. The results may differ from the default mode by rounding errors.
+    *
+    * This is currently taken into account by ConjugateGradient and BiCGSTAB.
+    */
+  Derived& setFusedIterations(bool enable)
+  {
+    m_fusedIterations = enable;
+    return derived();
+  }
+
   /** \returns the number of iterations performed during the last solve */
   Index iterations() const
   {
@@ -416,6 +436,7 @@ protected:
     m_factorizationIsOk = false;
     m_maxIterations = -1;
     m_tolerance = NumTraits<Scalar>::epsilon();
+    m_fusedIterations = false;
   }
 
   typedef internal::generic_matrix_wrapper<MatrixType> MatrixWrapper;
@@ -437,6 +458,7 @@ protected:
 
   Index m_maxIterations;
   RealScalar m_tolerance;
+  bool m_fusedIterations;
 
   mutable RealScalar m_error;
   mutable Index m_iterations;
@@ -0,0 +1,632 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_NESTED_DISSECTION_H
+#define EIGEN_NESTED_DISSECTION_H
+
+#include "./InternalHeaderCheck.h"
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal
+  * Undirected graph stored as adjacency lists in compressed format, with vertex and edge weights.
+  * Coarse graphs of the multilevel bisection accumulate the weights of the vertices and edges they merge.
+  */
+template<typename StorageIndex>
+struct nd_graph
+{
+  typedef Matrix<StorageIndex,Dynamic,1> IndexVector;
+
+  Index size() const { return xadj.size()-1; }
+
+  IndexVector xadj;   // start of the neighbors of each vertex in adj, followed by the number of edges
+  IndexVector adj;
+  IndexVector vwgt;
+  IndexVector ewgt;
+};
+
+/** \internal
+  * Nested dissection ordering of a graph.
+  *
+  * Each subgraph is split by a small vertex separator which is numbered after the two halves. The
+  * separators are computed by a multilevel bisection: the graph is coarsened by heavy edge matching,
+  * the coarsest graph is split by greedy graph growing, and the edge cut is refined by Fiduccia-Mattheyses
+  * passes while the partition is projected back to the finer graphs. A minimum vertex cover of the cut
+  * edges, obtained from a maximum matching, then gives the vertex separator. Subgraphs smaller than
+  * LeafSize are ordered by the approximate minimum degree algorithm.
+  *
+  * The recursion proceeds level by level, and the independent subgraphs of a level are processed
+  * concurrently. Each subgraph is handled independently of the others, so that the ordering does not
+  * depend on the number of threads.
+  */
+template<typename StorageIndex>
+class nested_dissection
+{
+  public:
+    typedef nd_graph<StorageIndex> Graph;
+    typedef Matrix<StorageIndex,Dynamic,1> IndexVector;
+
+    enum {
+      LeafSize = 200,       // subgraphs up to this size are ordered by AMD
+      CoarsenTo = 100,      // stop the coarsening at this size
+      InitialTries = 4,     // number of greedy graph growing attempts on the coarsest graph
+      RefinePasses = 8,
+      MaxUselessMoves = 64  // an FM pass stops after this many moves without improvement
+    };
+
+    /** Computes the ordering of the graph (\a xadj, \a adj), which must be symmetric and without self loops.
+      * On output \a perm(k) is the vertex numbered k. */
+    void operator()(const IndexVector& xadj, const IndexVector& adj, IndexVector& perm)
+    {
+      const Index n = xadj.size()-1;
+      m_xadj = &xadj;
+      m_adj = &adj;
+      m_position.resize(n);
+      m_label = IndexVector::Zero(n);
+      m_local.resize(n);
+
+      std::vector<IndexVector> items(1, IndexVector::LinSpaced(n, 0, StorageIndex(n-1)));
+      std::vector<Index> firsts(1, 0);
+      while(!items.empty())
+      {
+        const Index count = Index(items.size());
+        std::vector<IndexVector> children(2*count);
+        std::vector<Index> childFirsts(2*count);
+
+        // the largest subgraphs are handed out first, by interleaved blocks
+        std::vector<Index> order(count);
+        for(Index i = 0; i < count; ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](Index a, Index b) { return items[a].size() > items[b].size(); });
+        const Index threads = (std::min)(count, parallel_loop_threads());
+        parallelize_tasks(threads, [&](Index t) {
+          for(Index k = t; k < count; k += threads)
+          {
+            const Index i = order[k];
+            dissect(items[i], firsts[i], StorageIndex(i), children[2*i], childFirsts[2*i], children[2*i+1], childFirsts[2*i+1]);
+          }
+        });
+
+        // the labels are only updated between the levels, the tasks read those of the neighbors of their vertices
+        for(Index i = 0; i < count; ++i)
+          m_label(items[i]).setConstant(-1);
+        items.clear();
+        firsts.clear();
+        for(Index i = 0; i < 2*count; ++i)
+        {
+          if(children[i].size()==0)
+            continue;
+          const StorageIndex label = StorageIndex(items.size());
+          for(Index k = 0; k < children[i].size(); ++k)
+            m_label[children[i][k]] = label;
+          items.push_back(children[i]);
+          firsts.push_back(childFirsts[i]);
+        }
+      }
+
+      perm.resize(n);
+      for(Index v = 0; v < n; ++v)
+        perm[m_position[v]] = StorageIndex(v);
+    }
+
+  protected:
+
+    /** Orders the subgraph induced by \a vertices, whose label is \a label, in the positions starting at \a first.
+      * Either the whole subgraph is numbered, or only its separator is and the two halves are returned.
+      * Subgraphs of the same level are dissected concurrently, so that only the entries of \a vertices are written. */
+    void dissect(const IndexVector& vertices, Index first, StorageIndex label,
+                 IndexVector& child0, Index& first0, IndexVector& child1, Index& first1)
+    {
+      const Index n = vertices.size();
+      Graph g;
+      extract(vertices, label, g);
+
+      if(n > LeafSize)
+      {
+        IndexVector part;
+        bisect(g, part);
+        vertexSeparator(g, part);
+        Index count[3] = {0, 0, 0};
+        for(Index v = 0; v < n; ++v)
+          count[part[v]]++;
+        if(count[2] < n/2 && count[0] < n && count[1] < n)
+        {
+          child0.resize(count[0]);
+          child1.resize(count[1]);
+          first0 = first;
+          first1 = first + count[0];
+          Index pos[3] = {0, 0, first + count[0] + count[1]};
+          for(Index v = 0; v < n; ++v)
+          {
+            const StorageIndex gv = vertices[v];
+            switch(part[v])
+            {
+              case 0:  child0[pos[0]++] = gv; break;
+              case 1:  child1[pos[1]++] = gv; break;
+              default: m_position[gv] = StorageIndex(pos[2]++);
+            }
+          }
+          return;
+        }
+      }
+
+      // leaf, or a graph without small separator
+      if(n <= 2)
+      {
+        for(Index v = 0; v < n; ++v)
+          m_position[vertices[v]] = StorageIndex(first+v);
+        return;
+      }
+      // minimum_degree_ordering() considers the vertices without diagonal entry as dense
+      SparseMatrix<StorageIndex,ColMajor,StorageIndex> C(n,n);
+      C.resizeNonZeros(g.adj.size()+n);
+      for(Index v = 0, p = 0; v < n; ++v)
+      {
+        C.outerIndexPtr()[v] = StorageIndex(p);
+        C.innerIndexPtr()[p++] = StorageIndex(v);
+        for(Index k = g.xadj[v]; k < g.xadj[v+1]; ++k)
+          C.innerIndexPtr()[p++] = g.adj[k];
+      }
+      C.outerIndexPtr()[n] = StorageIndex(g.adj.size()+n);
+      PermutationMatrix<Dynamic,Dynamic,StorageIndex> amd;
+      minimum_degree_ordering(C, amd);
+      for(Index k = 0; k < n; ++k)
+        m_position[vertices[amd.indices()[k]]] = StorageIndex(first+k);
+    }
+
+    /** Builds the subgraph induced by the vertices of label \a label, with unit weights. */
+    void extract(const IndexVector& vertices, StorageIndex label, Graph& g)
+    {
+      const IndexVector& xadj = *m_xadj;
+      const IndexVector& adj = *m_adj;
+      const Index n = vertices.size();
+      for(Index v = 0; v < n; ++v)
+        m_local[vertices[v]] = StorageIndex(v);
+
+      g.xadj.resize(n+1);
+      g.xadj[0] = 0;
+      Index nnz = 0;
+      for(Index v = 0; v < n; ++v)
+      {
+        const StorageIndex gv = vertices[v];
+        for(Index k = xadj[gv]; k < xadj[gv+1]; ++k)
+          if(m_label[adj[k]]==label) ++nnz;
+        g.xadj[v+1] = StorageIndex(nnz);
+      }
+      g.adj.resize(nnz);
+      for(Index v = 0, p = 0; v < n; ++v)
+      {
+        const StorageIndex gv = vertices[v];
+        for(Index k = xadj[gv]; k < xadj[gv+1]; ++k)
+          if(m_label[adj[k]]==label) g.adj[p++] = m_local[adj[k]];
+      }
+      g.vwgt.setOnes(n);
+      g.ewgt.setOnes(nnz);
+    }
+
+    /** Multilevel bisection: \a part is set to 0 or 1 for each vertex. */
+    static void bisect(const Graph& g, IndexVector& part)
+    {
+      if(g.size() > CoarsenTo)
+      {
+        Graph coarse;
+        IndexVector cmap;
+        coarsen(g, coarse, cmap);
+        if(coarse.size() < (g.size()*9)/10)
+        {
+          IndexVector coarsePart;
+          bisect(coarse, coarsePart);
+          part.resize(g.size());
+          for(Index v = 0; v < g.size(); ++v)
+            part[v] = coarsePart[cmap[v]];
+          refine(g, part);
+          return;
+        }
+      }
+      initialPartition(g, part);
+    }
+
+    /** Heavy edge matching: each vertex is merged with the unmatched neighbor it shares the heaviest edge with. */
+    static void coarsen(const Graph& g, Graph& coarse, IndexVector& cmap)
+    {
+      const Index n = g.size();
+      const StorageIndex maxWeight = StorageIndex((std::max)(Index(1), (3*g.vwgt.sum())/(2*Index(CoarsenTo))));
+      IndexVector match = IndexVector::Constant(n, -1);
+
+      // low degree vertices are matched first, they have the fewest candidates
+      std::vector<StorageIndex> order(n);
+      for(Index v = 0; v < n; ++v) order[v] = StorageIndex(v);
+      std::stable_sort(order.begin(), order.end(), [&](StorageIndex a, StorageIndex b) {
+        return g.xadj[a+1]-g.xadj[a] < g.xadj[b+1]-g.xadj[b]; });
+      for(Index k = 0; k < n; ++k)
+      {
+        const StorageIndex v = order[k];
+        if(match[v]>=0)
+          continue;
+        StorageIndex best = v, bestWeight = -1;
+        for(Index p = g.xadj[v]; p < g.xadj[v+1]; ++p)
+        {
+          const StorageIndex u = g.adj[p];
+          if(match[u]<0 && u!=v && g.ewgt[p]>bestWeight && g.vwgt[v]+g.vwgt[u]<=maxWeight)
+          {
+            best = u;
+            bestWeight = g.ewgt[p];
+          }
+        }
+        match[v] = best;
+        match[best] = v;
+      }
+
+      cmap.resize(n);
+      Index cn = 0;
+      for(Index v = 0; v < n; ++v)
+        if(match[v]>=v)
+          cmap[v] = cmap[match[v]] = StorageIndex(cn++);
+
+      coarse.xadj.resize(cn+1);
+      coarse.adj.resize(g.adj.size());
+      coarse.ewgt.resize(g.adj.size());
+      coarse.vwgt.resize(cn);
+      IndexVector marker = IndexVector::Constant(cn, -1);
+      Index nnz = 0;
+      coarse.xadj[0] = 0;
+      for(Index v = 0; v < n; ++v)
+      {
+        if(match[v]<v)
+          continue;
+        const StorageIndex c = cmap[v];
+        const StorageIndex pair[2] = {StorageIndex(v), match[v]};
+        const Index start = nnz;
+        coarse.vwgt[c] = g.vwgt[v] + (match[v]!=v ? g.vwgt[match[v]] : 0);
+        for(int s = 0; s < (match[v]!=v ? 2 : 1); ++s)
+          for(Index p = g.xadj[pair[s]]; p < g.xadj[pair[s]+1]; ++p)
+          {
+            const StorageIndex cu = cmap[g.adj[p]];
+            if(cu==c)
+              continue;
+            if(marker[cu]<start)
+            {
+              marker[cu] = StorageIndex(nnz);
+              coarse.adj[nnz] = cu;
+              coarse.ewgt[nnz++] = g.ewgt[p];
+            }
+            else
+              coarse.ewgt[marker[cu]] += g.ewgt[p];
+          }
+        coarse.xadj[c+1] = StorageIndex(nnz);
+      }
+      coarse.adj.conservativeResize(nnz);
+      coarse.ewgt.conservativeResize(nnz);
+    }
+
+    /** Greedy graph growing from a few start vertices, each result being refined; the smallest cut is kept. */
+    static void initialPartition(const Graph& g, IndexVector& part)
+    {
+      const Index n = g.size();
+      const Index total = g.vwgt.sum();
+      IndexVector trial(n), queue(n);
+      Index bestCut = -1, bestImbalance = 0;
+      for(Index t = 0; t < (std::min)(Index(InitialTries), n); ++t)
+      {
+        trial.setOnes();
+        Index weight = 0, head = 0, tail = 0, next = 0;
+        queue[tail++] = StorageIndex((t*n)/InitialTries);
+        trial[queue[0]] = 0;
+        while(2*weight < total)
+        {
+          if(head==tail)
+          {
+            // disconnected graph: continue from any vertex not reached yet
+            while(trial[next]==0) ++next;
+            queue[tail++] = StorageIndex(next);
+            trial[next] = 0;
+          }
+          const StorageIndex v = queue[head++];
+          weight += g.vwgt[v];
+          for(Index p = g.xadj[v]; p < g.xadj[v+1] && 2*weight < total; ++p)
+            if(trial[g.adj[p]]==1)
+            {
+              trial[g.adj[p]] = 0;
+              queue[tail++] = g.adj[p];
+            }
+        }
+        // the vertices queued but not yet reached go back to the other side
+        for(Index k = head; k < tail; ++k)
+          trial[queue[k]] = 1;
+
+        refine(g, trial);
+        Index cut = 0, weight0 = 0;
+        for(Index v = 0; v < n; ++v)
+        {
+          if(trial[v]==0) weight0 += g.vwgt[v];
+          for(Index p = g.xadj[v]; p < g.xadj[v+1]; ++p)
+            if(trial[g.adj[p]]!=trial[v]) cut += g.ewgt[p];
+        }
+        const Index imbalance = numext::abs(total-2*weight0);
+        if(bestCut<0 || cut<bestCut || (cut==bestCut && imbalance<bestImbalance))
+        {
+          bestCut = cut;
+          bestImbalance = imbalance;
+          part = trial;
+        }
+      }
+    }
+
+    /** Fiduccia-Mattheyses refinement of the edge cut of the bisection \a part, under a 5% balance constraint. */
+    static void refine(const Graph& g, IndexVector& part)
+    {
+      const Index n = g.size();
+      const Index total = g.vwgt.sum();
+      const Index maxWeight = (std::max)((total*105)/200, (total+1)/2 + Index(g.vwgt.maxCoeff()));
+      IndexVector internalDeg = IndexVector::Zero(n), externalDeg = IndexVector::Zero(n);
+      Index weight[2] = {0, 0};
+      Index cut = 0;
+      for(Index v = 0; v < n; ++v)
+      {
+        weight[part[v]] += g.vwgt[v];
+        for(Index p = g.xadj[v]; p < g.xadj[v+1]; ++p)
+          (part[g.adj[p]]==part[v] ? internalDeg[v] : externalDeg[v]) += g.ewgt[p];
+        cut += externalDeg[v];
+      }
+      cut /= 2;
+
+      auto move = [&](StorageIndex v) {
+        const StorageIndex from = part[v], to = 1-from;
+        part[v] = to;
+        weight[from] -= g.vwgt[v];
+        weight[to] += g.vwgt[v];
+        cut -= externalDeg[v]-internalDeg[v];
+        std::swap(internalDeg[v], externalDeg[v]);
+        for(Index p = g.xadj[v]; p < g.xadj[v+1]; ++p)
+        {
+          const StorageIndex u = g.adj[p];
+          const StorageIndex w = g.ewgt[p];
+          if(part[u]==to) { internalDeg[u] += w; externalDeg[u] -= w; }
+          else            { internalDeg[u] -= w; externalDeg[u] += w; }
+        }
+      };
+
+      typedef std::pair<StorageIndex,StorageIndex> Entry;  // (gain, vertex)
+      std::vector<Entry> heap;
+      std::vector<StorageIndex> moves;
+      std::vector<bool> locked(n);
+      for(Index pass = 0; pass < RefinePasses; ++pass)
+      {
+        heap.clear();
+        moves.clear();
+        std::fill(locked.begin(), locked.end(), false);
+        for(Index v = 0; v < n; ++v)
+          if(externalDeg[v]>0)
+            heap.push_back(Entry(externalDeg[v]-internalDeg[v], StorageIndex(v)));
+        std::make_heap(heap.begin(), heap.end());
+
+        const Index startCut = cut;
+        Index bestCut = cut, bestImbalance = numext::abs(weight[0]-weight[1]);
+        size_t bestMoves = 0;
+        while(!heap.empty() && moves.size()-bestMoves < size_t(MaxUselessMoves))
+        {
+          std::pop_heap(heap.begin(), heap.end());
+          const Entry e = heap.back();
+          heap.pop_back();
+          const StorageIndex v = e.second;
+          if(locked[v] || e.first!=externalDeg[v]-internalDeg[v])
+            continue;  // stale entry
+          const StorageIndex to = 1-part[v];
+          if(weight[to]+g.vwgt[v] > maxWeight && weight[to] >= weight[1-to])
+            continue;
+          move(v);
+          locked[v] = true;
+          moves.push_back(v);
+          for(Index p = g.xadj[v]; p < g.xadj[v+1]; ++p)
+          {
+            const StorageIndex u = g.adj[p];
+            if(!locked[u] && externalDeg[u]>0)
+            {
+              heap.push_back(Entry(externalDeg[u]-internalDeg[u], u));
+              std::push_heap(heap.begin(), heap.end());
+            }
+          }
+          const Index imbalance = numext::abs(weight[0]-weight[1]);
+          const bool balanced = (std::max)(weight[0],weight[1]) <= maxWeight;
+          if((balanced && cut<bestCut) || (cut==bestCut && imbalance<bestImbalance) || (!balanced && imbalance<bestImbalance))
+          {
+            bestCut = cut;
+            bestImbalance = imbalance;
+            bestMoves = moves.size();
+          }
+        }
+        while(moves.size()>bestMoves)
+        {
+          move(moves.back());
+          moves.pop_back();
+        }
+        if(cut>=startCut)
+          break;
+      }
+    }
+
+    /** Replaces the edge separator of \a part by a vertex separator, whose vertices get part 2.
+      * The separator is a minimum vertex cover of the cut edges (Koenig's theorem), obtained from a
+      * maximum matching of the bipartite graph of the cut edges. */
+    static void vertexSeparator(const Graph& g, IndexVector& part)
+    {
+      const Index n = g.size();
+      IndexVector mate = IndexVector::Constant(n, -1);
+      IndexVector pred(n), queue(n);
+      IndexVector stamp = IndexVector::Constant(n, -1);
+      auto isCut = [&](StorageIndex v, Index p) { return part[g.adj[p]]!=part[v]; };
+
+      // greedy matching, then augmenting paths from the free left vertices (part 0)
+      std::vector<StorageIndex> left;
+      for(Index v = 0; v < n; ++v)
+      {
+        if(part[v]!=0)
+          continue;
+        bool boundary = false;
+        for(Index p = g.xadj[v]; p < g.xadj[v+1]; ++p)
+          if(isCut(StorageIndex(v),p))
+          {
+            boundary = true;
+            if(mate[v]<0 && mate[g.adj[p]]<0)
+            {
+              mate[v] = g.adj[p];
+              mate[g.adj[p]] = StorageIndex(v);
+            }
+          }
+        if(boundary)
+          left.push_back(StorageIndex(v));
+      }
+      for(size_t i = 0; i < left.size(); ++i)
+      {
+        const StorageIndex l = left[i];
+        if(mate[l]>=0)
+          continue;
+        Index head = 0, tail = 0;
+        StorageIndex found = -1;
+        queue[tail++] = l;
+        stamp[l] = l;
+        while(head<tail && found<0)
+        {
+          const StorageIndex x = queue[head++];
+          for(Index p = g.xadj[x]; p < g.xadj[x+1]; ++p)
+          {
+            const StorageIndex r = g.adj[p];
+            if(part[r]!=1 || stamp[r]==l)
+              continue;
+            stamp[r] = l;
+            pred[r] = x;
+            if(mate[r]<0) { found = r; break; }
+            stamp[mate[r]] = l;
+            queue[tail++] = mate[r];
+          }
+        }
+        for(StorageIndex r = found; r >= 0; )
+        {
+          const StorageIndex x = pred[r], next = mate[x];
+          mate[x] = r;
+          mate[r] = x;
+          r = next;
+        }
+      }
+
+      // vertices reachable from the free left vertices by alternating paths
+      std::vector<bool> reached(n, false);
+      Index head = 0, tail = 0;
+      for(size_t i = 0; i < left.size(); ++i)
+        if(mate[left[i]]<0)
+        {
+          reached[left[i]] = true;
+          queue[tail++] = left[i];
+        }
+      while(head<tail)
+      {
+        const StorageIndex x = queue[head++];
+        for(Index p = g.xadj[x]; p < g.xadj[x+1]; ++p)
+        {
+          const StorageIndex r = g.adj[p];
+          if(part[r]!=1 || reached[r])
+            continue;
+          reached[r] = true;
+          if(mate[r]>=0 && !reached[mate[r]])
+          {
+            reached[mate[r]] = true;
+            queue[tail++] = mate[r];
+          }
+        }
+      }
+
+      // minimum cover: the unreached left vertices and the reached right vertices
+      for(size_t i = 0; i < left.size(); ++i)
+      {
+        const StorageIndex l = left[i];
+        if(!reached[l])
+          part[l] = 2;
+      }
+      for(Index v = 0; v < n; ++v)
+        if(part[v]==1 && reached[v])
+          part[v] = 2;
+    }
+
+    const IndexVector* m_xadj;
+    const IndexVector* m_adj;
+    IndexVector m_position;  // position of each vertex in the ordering
+    IndexVector m_label;     // subgraph of the current level each vertex belongs to, -1 once numbered
+    IndexVector m_local;     // index of each vertex in its subgraph
+};
+
+} // end namespace internal
+
+/** \ingroup OrderingMethods_Module
+  * \class NestedDissectionOrdering
+  *
+  * Functor computing a \em nested \em dissection ordering.
+  *
+  * The graph of the matrix is recursively split by small vertex separators, which are numbered after
+  * the two parts they separate. The separators are computed by a multilevel graph bisection, and
+  * the small subgraphs at the bottom of the recursion are ordered by the approximate minimum degree algorithm.
+  * On large matrices coming from 3D meshes, this ordering usually leads to fewer operations and
+  * more balanced elimination trees than AMDOrdering, which benefits the multi-threaded factorization
+  * of SupernodalLLT.
+  *
+  * The independent subgraphs are processed concurrently when multi-threading is enabled
+  * (see \ref TopicMultiThreading), and the ordering does not depend on the number of threads.
+  * If the matrix is not structurally symmetric, an ordering of A^T+A is computed.
+  *
+  * \tparam  StorageIndex The type of indices of the matrix
+  * \sa AMDOrdering, MetisOrdering
+  */
+template <typename StorageIndex>
+class NestedDissectionOrdering
+{
+  public:
+    typedef PermutationMatrix<Dynamic, Dynamic, StorageIndex> PermutationType;
+    typedef Matrix<StorageIndex, Dynamic, 1> IndexVector;
+
+    /** Compute the permutation vector from a sparse matrix */
+    template <typename MatrixType>
+    void operator()(const MatrixType& mat, PermutationType& perm)
+    {
+      SparseMatrix<typename MatrixType::Scalar, ColMajor, StorageIndex> symm;
+      internal::ordering_helper_at_plus_a(mat,symm);
+      order(symm, perm);
+    }
+
+    /** Compute the permutation with a selfadjoint matrix */
+    template <typename SrcType, unsigned int SrcUpLo>
+    void operator()(const SparseSelfAdjointView<SrcType, SrcUpLo>& mat, PermutationType& perm)
+    {
+      SparseMatrix<typename SrcType::Scalar, ColMajor, StorageIndex> C; C = mat;
+      order(C, perm);
+    }
+
+  protected:
+    template <typename SymmetricMatrix>
+    void order(const SymmetricMatrix& C, PermutationType& perm)
+    {
+      // adjacency graph of C, without the diagonal
+      const Index n = C.cols();
+      IndexVector xadj(n+1), adj(C.nonZeros());
+      Index nnz = 0;
+      xadj[0] = 0;
+      for(Index j = 0; j < n; ++j)
+      {
+        for(typename SymmetricMatrix::InnerIterator it(C,j); it; ++it)
+          if(it.index()!=j)
+            adj[nnz++] = StorageIndex(it.index());
+        xadj[j+1] = StorageIndex(nnz);
+      }
+      adj.conservativeResize(nnz);
+
+      internal::nested_dissection<StorageIndex> dissection;
+      dissection(xadj, adj, perm.indices());
+    }
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_NESTED_DISSECTION_H
@@ -85,6 +85,10 @@ class SimplicialCholeskyBase : public SparseSolverBase<Derived>
       : m_info(Success),
         m_factorizationIsOk(false),
         m_analysisIsOk(false),
+        m_analysisIsLDLT(false),
+        m_cachedAnalysis(false),
+        m_hasFingerprint(false),
+        m_patternFingerprint(0),
         m_shiftOffset(0),
         m_shiftScale(1)
     {}
@@ -93,6 +97,10 @@ class SimplicialCholeskyBase : public SparseSolverBase<Derived>
       : m_info(Success),
         m_factorizationIsOk(false),
         m_analysisIsOk(false),
+        m_analysisIsLDLT(false),
+        m_cachedAnalysis(false),
+        m_hasFingerprint(false),
+        m_patternFingerprint(0),
         m_shiftOffset(0),
         m_shiftScale(1)
     {
@@ -146,6 +154,46 @@ class SimplicialCholeskyBase : public SparseSolverBase<Derived>
       return derived();
     }
 
+    /** Enables or disables the cached analysis mode, which is disabled by default.
+      *
+      * In this mode, compute() hashes the positions of the non-zeros of its input matrix, and skips the symbolic
+      * analysis (ordering, elimination tree and column counts) when they match the ones of the matrix given to the last
+      * analysis. Calling compute() in a loop over matrices sharing the same pattern then costs a single analysis.
+      *
+      * \returns a reference to \c *this.
+      *
+      * \sa serializeAnalysis()
+      */
+    Derived& setCachedAnalysis(bool enable)
+    {
+      m_cachedAnalysis = enable;
+      return derived();
+    }
+
+    /** \returns whether the cached analysis mode is enabled
+      * \sa setCachedAnalysis() */
+    bool cachedAnalysis() const { return m_cachedAnalysis; }
+
+    /** \returns the size in bytes of the buffer needed by serializeAnalysis() */
+    size_t serializedAnalysisSize() const
+    {
+      eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+      return Eigen::serialize_size(analysisHeader(), m_Pinv.indices(), m_parent, outerIndices());
+    }
+
+    /** Writes the symbolic analysis (permutation, elimination tree and structure of the factor) to the buffer [\a dest, \a end),
+      * so that it can be restored by deserializeAnalysis(), possibly in another process.
+      *
+      * \returns the address following the serialized data, or \c nullptr if the buffer is too small.
+      *
+      * \sa serializedAnalysisSize(), deserializeAnalysis()
+      */
+    uint8_t* serializeAnalysis(uint8_t* dest, uint8_t* end) const
+    {
+      eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+      return Eigen::serialize(dest, end, analysisHeader(), m_Pinv.indices(), m_parent, outerIndices());
+    }
+
 #ifndef EIGEN_PARSED_BY_DOXYGEN
     /** \internal */
     template<typename Stream>
@@ -204,11 +252,23 @@ class SimplicialCholeskyBase : public SparseSolverBase<Derived>
     void compute(const MatrixType& matrix)
     {
       eigen_assert(matrix.rows()==matrix.cols());
+      numext::uint64_t fingerprint = 0;
+      if(m_cachedAnalysis)
+      {
+        fingerprint = internal::sparse_pattern_fingerprint(matrix);
+        if(m_analysisIsOk && m_hasFingerprint && m_analysisIsLDLT==DoLDLT && fingerprint==m_patternFingerprint)
+        {
+          factorize<DoLDLT>(matrix);
+          return;
+        }
+      }
       Index size = matrix.cols();
       CholMatrixType tmp(size,size);
       ConstCholMatrixPtr pmat;
       ordering(matrix, pmat, tmp);
       analyzePattern_preordered(*pmat, DoLDLT);
+      m_hasFingerprint = m_cachedAnalysis;
+      m_patternFingerprint = fingerprint;
       factorize_preordered<DoLDLT>(*pmat);
     }
     
@@ -216,6 +276,9 @@ class SimplicialCholeskyBase : public SparseSolverBase<Derived>
     void factorize(const MatrixType& a)
     {
       eigen_assert(a.rows()==a.cols());
+      // the structure of the factor differs between the two modes
+      if(m_analysisIsOk && m_analysisIsLDLT!=DoLDLT)
+        analyzePattern(a, DoLDLT);
       Index size = a.cols();
       CholMatrixType tmp(size,size);
       ConstCholMatrixPtr pmat;
@@ -245,8 +308,78 @@ class SimplicialCholeskyBase : public SparseSolverBase<Derived>
       ConstCholMatrixPtr pmat;
       ordering(a, pmat, tmp);
       analyzePattern_preordered(*pmat,doLDLT);
+      m_hasFingerprint = m_cachedAnalysis;
+      m_patternFingerprint = m_cachedAnalysis ? internal::sparse_pattern_fingerprint(a) : 0;
     }
     void analyzePattern_preordered(const CholMatrixType& a, bool doLDLT);
+
+    const uint8_t* deserializeAnalysis(const uint8_t* src, const uint8_t* end, bool doLDLT)
+    {
+      AnalysisHeader header;
+      VectorI pinv, parent, outer;
+      src = Eigen::deserialize(src, end, header, pinv, parent, outer);
+      m_analysisIsOk = m_factorizationIsOk = false;
+      m_isInitialized = false;
+      if(src==nullptr || !isValidAnalysis(header, doLDLT, pinv, parent, outer))
+        return nullptr;
+
+      m_Pinv.indices() = pinv;
+      if(m_Pinv.size()>0) m_P = m_Pinv.inverse();
+      else                m_P.resize(0);
+      m_parent = parent;
+      m_nonZerosPerCol.resize(header.size);
+      m_matrix.resize(header.size, header.size);
+      VectorI::Map(m_matrix.outerIndexPtr(), header.size+1) = outer;
+      m_matrix.resizeNonZeros(outer[header.size]);
+      m_analysisIsLDLT = header.ldlt;
+      m_hasFingerprint = header.hasFingerprint;
+      m_patternFingerprint = header.fingerprint;
+
+      m_isInitialized = true;
+      m_info = Success;
+      m_analysisIsOk = true;
+      return src;
+    }
+
+    /** \internal header of the serialized analysis */
+    struct AnalysisHeader {
+      Index size;
+      numext::uint64_t fingerprint;
+      bool hasFingerprint;
+      bool ldlt;
+    };
+
+    AnalysisHeader analysisHeader() const
+    {
+      AnalysisHeader header = {m_matrix.cols(), m_patternFingerprint, m_hasFingerprint, m_analysisIsLDLT};
+      return header;
+    }
+
+    /** \internal \returns whether \a header comes from an analysis in the mode \a doLDLT, and whether \a pinv, \a parent
+      * and \a outer are a permutation, an elimination tree and the column starts of the factor that analyzePattern()
+      * could have computed for a matrix of size \a header.size */
+    static bool isValidAnalysis(const AnalysisHeader& header, bool doLDLT, const VectorI& pinv, const VectorI& parent, const VectorI& outer)
+    {
+      const Index size = header.size;
+      if(header.ldlt!=doLDLT || size<0 || parent.size()!=size || outer.size()!=size+1 || outer[0]!=0)
+        return false;
+      if(pinv.size()!=0 && (pinv.size()!=size || !internal::is_permutation_indices(pinv, size)))
+        return false;
+      const Index diag = header.ldlt ? 0 : 1;
+      for(Index k = 0; k < size; ++k)
+      {
+        // The parent of k is the row of its first off-diagonal entry, if any, and column k holds at most size-k-1 of them
+        const Index nnz = Index(outer[k+1]) - Index(outer[k]) - diag;
+        if(nnz<0 || nnz>size-k-1 || (nnz==0) != (parent[k]==-1) || (parent[k]!=-1 && (parent[k]<=k || parent[k]>=size)))
+          return false;
+      }
+      return true;
+    }
+
+    VectorI outerIndices() const
+    {
+      return VectorI::Map(m_matrix.outerIndexPtr(), m_matrix.cols()+1);
+    }
     
     void ordering(const MatrixType& a, ConstCholMatrixPtr &pmat, CholMatrixType& ap);
 
@@ -261,6 +394,10 @@ class SimplicialCholeskyBase : public SparseSolverBase<Derived>
     mutable ComputationInfo m_info;
     bool m_factorizationIsOk;
     bool m_analysisIsOk;
+    bool m_analysisIsLDLT;
+    bool m_cachedAnalysis;
+    bool m_hasFingerprint;
+    numext::uint64_t m_patternFingerprint;            // hash of the pattern of the analyzed matrix (cached analysis mode)
     
     CholMatrixType m_matrix;
     VectorType m_diag;                                // the diagonal coefficients (LDLT mode)
@@ -399,6 +536,20 @@ public:
       Base::template factorize<false>(a);
     }
 
+    /** Restores a symbolic analysis written by serializeAnalysis() for a solver of the same type.
+      * factorize() can then be called right away on matrices having the analyzed pattern, and so can compute()
+      * in the cached analysis mode if the analysis was computed in this mode.
+      *
+      * \returns the address following the serialized data, or \c nullptr if the data are invalid, in which case
+      * the solver is left in an uninitialized state.
+      *
+      * \sa serializeAnalysis()
+      */
+    const uint8_t* deserializeAnalysis(const uint8_t* src, const uint8_t* end)
+    {
+      return Base::deserializeAnalysis(src, end, false);
+    }
+
     /** \returns the determinant of the underlying matrix from the current factorization */
     Scalar determinant() const
     {
@@ -496,6 +647,20 @@ public:
       Base::template factorize<true>(a);
     }
 
+    /** Restores a symbolic analysis written by serializeAnalysis() for a solver of the same type.
+      * factorize() can then be called right away on matrices having the analyzed pattern, and so can compute()
+      * in the cached analysis mode if the analysis was computed in this mode.
+      *
+      * \returns the address following the serialized data, or \c nullptr if the data are invalid, in which case
+      * the solver is left in an uninitialized state.
+      *
+      * \sa serializeAnalysis()
+      */
+    const uint8_t* deserializeAnalysis(const uint8_t* src, const uint8_t* end)
+    {
+      return Base::deserializeAnalysis(src, end, true);
+    }
+
     /** \returns the determinant of the underlying matrix from the current factorization */
     Scalar determinant() const
     {
@@ -594,6 +759,20 @@ public:
         Base::template factorize<false>(a);
     }
 
+    /** Restores a symbolic analysis written by serializeAnalysis() for a solver of the same type and mode.
+      * factorize() can then be called right away on matrices having the analyzed pattern, and so can compute()
+      * in the cached analysis mode if the analysis was computed in this mode.
+      *
+      * \returns the address following the serialized data, or \c nullptr if the data are invalid or were computed in the other mode, in which case
+      * the solver is left in an uninitialized state.
+      *
+      * \sa serializeAnalysis()
+      */
+    const uint8_t* deserializeAnalysis(const uint8_t* src, const uint8_t* end)
+    {
+      return Base::deserializeAnalysis(src, end, m_LDLT);
+    }
+
     /** \internal */
     template<typename Rhs,typename Dest>
     void _solve_impl(const MatrixBase<Rhs> &b, MatrixBase<Dest> &dest) const
@@ -69,6 +69,7 @@ void SimplicialCholeskyBase<Derived>::analyzePattern_preordered(const CholMatrix
   m_isInitialized     = true;
   m_info              = Success;
   m_analysisIsOk      = true;
+  m_analysisIsLDLT    = doLDLT;
   m_factorizationIsOk = false;
 }
 
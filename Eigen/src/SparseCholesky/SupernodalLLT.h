@@ -0,0 +1,891 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SUPERNODAL_LLT_H
+#define EIGEN_SUPERNODAL_LLT_H
+
+#include "./InternalHeaderCheck.h"
+
+namespace Eigen {
+
+template<typename MatrixType_, int UpLo_ = Lower, typename Ordering_ = AMDOrdering<typename MatrixType_::StorageIndex> > class SupernodalLLT;
+
+/** \ingroup SparseCholesky_Module
+  * \class SupernodalLLT
+  * \brief A supernodal, multithreaded sparse LLT Cholesky factorization
+  *
+  * This class provides a LL^T Cholesky factorization of sparse matrices that are selfadjoint and positive definite.
+  * It computes the same factor as SimplicialLLT, but groups the columns of L sharing the same structure into
+  * supernodes stored as dense column-major blocks. Each supernode is factorized with the dense LLT kernel,
+  * and the updates between supernodes are computed with matrix products, so that large factors run at the speed
+  * of the dense kernels rather than of a column-at-a-time loop.
+  *
+  * The supernodes are detected from the elimination tree during analyzePattern(). When multi-threading is enabled
+  * (see \ref TopicMultiThreading), factorize() first processes independent subtrees of the supernodal elimination
+  * tree concurrently, and then the supernodes close to the root, whose matrix products are themselves
+  * multithreaded.
+  *
+  * In order to reduce the fill-in, a symmetric permutation P is applied prior to the factorization
+  * such that the factorized matrix is P A P^-1.
+  *
+  * \tparam MatrixType_ the type of the sparse matrix A, it must be a SparseMatrix<>
+  * \tparam UpLo_ the triangular part that will be used for the computations. It can be Lower
+  *               or Upper. Default is Lower.
+  * \tparam Ordering_ The ordering method to use, either AMDOrdering<>, NestedDissectionOrdering<> or NaturalOrdering<>.
+  *                  Default is AMDOrdering<>. NestedDissectionOrdering<> yields a wider elimination tree whose
+  *                  independent subtrees are factorized in parallel.
+  *
+  * \implsparsesolverconcept
+  *
+  * \sa class SimplicialLLT, class AMDOrdering, class NestedDissectionOrdering, class NaturalOrdering
+  */
+template<typename MatrixType_, int UpLo_, typename Ordering_>
+class SupernodalLLT : public SparseSolverBase<SupernodalLLT<MatrixType_,UpLo_,Ordering_> >
+{
+    typedef SparseSolverBase<SupernodalLLT> Base;
+    using Base::m_isInitialized;
+
+  public:
+    typedef MatrixType_ MatrixType;
+    typedef Ordering_ OrderingType;
+    enum { UpLo = UpLo_ };
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef typename MatrixType::StorageIndex StorageIndex;
+    typedef SparseMatrix<Scalar,ColMajor,StorageIndex> CholMatrixType;
+    typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+    typedef Matrix<Scalar,Dynamic,1> VectorType;
+    typedef Matrix<StorageIndex,Dynamic,1> VectorI;
+    typedef Matrix<Index,Dynamic,1> VectorIndex;
+
+    enum {
+      ColsAtCompileTime = MatrixType::ColsAtCompileTime,
+      MaxColsAtCompileTime = MatrixType::MaxColsAtCompileTime
+    };
+
+  public:
+
+    /** Default constructor */
+    SupernodalLLT()
+      : m_info(Success),
+        m_factorizationIsOk(false),
+        m_analysisIsOk(false),
+        m_size(0),
+        m_maxUpdateSize(0),
+        m_cachedAnalysis(false),
+        m_hasFingerprint(false),
+        m_patternFingerprint(0),
+        m_shiftOffset(0),
+        m_shiftScale(1)
+    {}
+
+    /** Constructs and performs the LLT factorization of \a matrix */
+    explicit SupernodalLLT(const MatrixType& matrix)
+      : m_info(Success),
+        m_factorizationIsOk(false),
+        m_analysisIsOk(false),
+        m_size(0),
+        m_maxUpdateSize(0),
+        m_cachedAnalysis(false),
+        m_hasFingerprint(false),
+        m_patternFingerprint(0),
+        m_shiftOffset(0),
+        m_shiftScale(1)
+    {
+      compute(matrix);
+    }
+
+    inline Index cols() const { return m_size; }
+    inline Index rows() const { return m_size; }
+
+    /** \brief Reports whether previous computation was successful.
+      *
+      * \returns \c Success if computation was successful,
+      *          \c NumericalIssue if the matrix.appears to be negative.
+      */
+    ComputationInfo info() const
+    {
+      eigen_assert(m_isInitialized && "Decomposition is not initialized.");
+      return m_info;
+    }
+
+    /** \returns the permutation P
+      * \sa permutationPinv() */
+    const PermutationMatrix<Dynamic,Dynamic,StorageIndex>& permutationP() const
+    { return m_P; }
+
+    /** \returns the inverse P^-1 of the permutation P
+      * \sa permutationP() */
+    const PermutationMatrix<Dynamic,Dynamic,StorageIndex>& permutationPinv() const
+    { return m_Pinv; }
+
+    /** \returns the number of supernodes found by the last call to analyzePattern() */
+    Index supernodes() const
+    {
+      eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+      return m_superFirst.size()-1;
+    }
+
+    /** Sets the shift parameters that will be used to adjust the diagonal coefficients during the numerical factorization.
+      *
+      * During the numerical factorization, the diagonal coefficients are transformed by the following linear model:\n
+      * \c d_ii = \a offset + \a scale * \c d_ii
+      *
+      * The default is the identity transformation with \a offset=0, and \a scale=1.
+      *
+      * \returns a reference to \c *this.
+      */
+    SupernodalLLT& setShift(const RealScalar& offset, const RealScalar& scale = 1)
+    {
+      m_shiftOffset = offset;
+      m_shiftScale = scale;
+      return *this;
+    }
+
+    /** Enables or disables the cached analysis mode, which is disabled by default.
+      *
+      * In this mode, compute() hashes the positions of the non-zeros of its input matrix, and skips analyzePattern()
+      * when they match the ones of the matrix given to the last analysis.
+      *
+      * \returns a reference to \c *this.
+      *
+      * \sa SimplicialCholeskyBase::setCachedAnalysis(), serializeAnalysis()
+      */
+    SupernodalLLT& setCachedAnalysis(bool enable)
+    {
+      m_cachedAnalysis = enable;
+      return *this;
+    }
+
+    /** \returns whether the cached analysis mode is enabled
+      * \sa setCachedAnalysis() */
+    bool cachedAnalysis() const { return m_cachedAnalysis; }
+
+    /** Computes the sparse Cholesky decomposition of \a matrix */
+    SupernodalLLT& compute(const MatrixType& matrix)
+    {
+      if(!m_cachedAnalysis || !m_analysisIsOk || !m_hasFingerprint || internal::sparse_pattern_fingerprint(matrix)!=m_patternFingerprint)
+        analyzePattern(matrix);
+      factorize(matrix);
+      return *this;
+    }
+
+    /** Performs a symbolic decomposition on the sparcity of \a matrix, and detects its supernodes.
+      *
+      * This function is particularly useful when solving for several problems having the same structure.
+      *
+      * \sa factorize()
+      */
+    void analyzePattern(const MatrixType& a)
+    {
+      eigen_assert(a.rows()==a.cols());
+      CholMatrixType ap;
+      ordering(a, ap);
+      analyzePattern_preordered(ap);
+      m_hasFingerprint = m_cachedAnalysis;
+      m_patternFingerprint = m_cachedAnalysis ? internal::sparse_pattern_fingerprint(a) : 0;
+    }
+
+    /** \returns the size in bytes of the buffer needed by serializeAnalysis() */
+    size_t serializedAnalysisSize() const
+    {
+      eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+      return Eigen::serialize_size(analysisHeader(), m_Pinv.indices(), m_superFirst, m_superParent, m_rowPtr, m_rows,
+                                   m_valuePtr, m_sourcePtr, m_sources, m_sourceRows);
+    }
+
+    /** Writes the symbolic analysis (permutation, supernodes and their structure) to the buffer [\a dest, \a end),
+      * so that it can be restored by deserializeAnalysis(), possibly in another process.
+      *
+      * \returns the address following the serialized data, or \c nullptr if the buffer is too small.
+      *
+      * \sa serializedAnalysisSize(), deserializeAnalysis()
+      */
+    uint8_t* serializeAnalysis(uint8_t* dest, uint8_t* end) const
+    {
+      eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+      return Eigen::serialize(dest, end, analysisHeader(), m_Pinv.indices(), m_superFirst, m_superParent, m_rowPtr, m_rows,
+                              m_valuePtr, m_sourcePtr, m_sources, m_sourceRows);
+    }
+
+    /** Restores a symbolic analysis written by serializeAnalysis().
+      * factorize() can then be called right away on matrices having the analyzed pattern, and so can compute()
+      * in the cached analysis mode if the analysis was computed in this mode.
+      *
+      * \returns the address following the serialized data, or \c nullptr if the data are invalid, in which case
+      * the solver is left in an uninitialized state.
+      *
+      * \sa serializeAnalysis()
+      */
+    const uint8_t* deserializeAnalysis(const uint8_t* src, const uint8_t* end)
+    {
+      AnalysisHeader header;
+      VectorI pinv, superFirst, superParent, rows, sources;
+      VectorIndex rowPtr, valuePtr, sourcePtr, sourceRows;
+      m_analysisIsOk = m_factorizationIsOk = false;
+      m_isInitialized = false;
+      src = Eigen::deserialize(src, end, header, pinv, superFirst, superParent, rowPtr, rows,
+                               valuePtr, sourcePtr, sources, sourceRows);
+      Index maxUpdateSize;
+      if(src==nullptr || !isValidAnalysis(header.size, pinv, superFirst, superParent, rowPtr, rows, valuePtr,
+                                          sourcePtr, sources, sourceRows, maxUpdateSize))
+        return nullptr;
+
+      m_Pinv.indices() = pinv;
+      if(m_Pinv.size()>0) m_P = m_Pinv.inverse();
+      else                m_P.resize(0);
+      m_size = header.size;
+      m_superFirst = superFirst;
+      m_superParent = superParent;
+      m_rowPtr = rowPtr;
+      m_rows = rows;
+      m_valuePtr = valuePtr;
+      m_sourcePtr = sourcePtr;
+      m_sources = sources;
+      m_sourceRows = sourceRows;
+      m_maxUpdateSize = maxUpdateSize;
+      m_values.resize(m_valuePtr[m_superFirst.size()-1]);
+      m_hasFingerprint = header.hasFingerprint;
+      m_patternFingerprint = header.fingerprint;
+
+      m_isInitialized = true;
+      m_info = Success;
+      m_analysisIsOk = true;
+      return src;
+    }
+
+    /** Performs a numeric decomposition of \a matrix
+      *
+      * The given matrix must has the same sparcity than the matrix on which the symbolic decomposition has been performed.
+      *
+      * \sa analyzePattern()
+      */
+    void factorize(const MatrixType& a)
+    {
+      eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+      eigen_assert(a.rows()==a.cols() && a.rows()==m_size);
+      CholMatrixType ap(m_size,m_size);
+      ap.template selfadjointView<Lower>() = a.template selfadjointView<UpLo>().twistedBy(m_P);
+      factorize_preordered(ap);
+    }
+
+    /** \returns the determinant of the underlying matrix from the current factorization */
+    Scalar determinant() const
+    {
+      eigen_assert(m_factorizationIsOk && "The decomposition is not in a valid state, you must first call either compute() or analyzePattern()/factorize()");
+      Scalar detL(1);
+      for(Index s = 0; s < m_superFirst.size()-1; ++s)
+        detL *= supernode(s).diagonal().prod();
+      return numext::abs2(detL);
+    }
+
+#ifndef EIGEN_PARSED_BY_DOXYGEN
+    /** \internal */
+    template<typename Rhs,typename Dest>
+    void _solve_impl(const MatrixBase<Rhs> &b, MatrixBase<Dest> &dest) const
+    {
+      eigen_assert(m_factorizationIsOk && "The decomposition is not in a valid state for solving, you must first call either compute() or analyzePattern()/factorize()");
+      eigen_assert(m_size==b.rows());
+
+      if(m_info!=Success)
+        return;
+
+      DenseMatrix x;
+      if(m_P.size()>0)
+        x = m_P * b;
+      else
+        x = b;
+
+      solveInPlace(x);
+
+      if(m_P.size()>0)
+        dest = m_Pinv * x;
+      else
+        dest = x;
+    }
+
+    /** \internal */
+    template<typename Rhs,typename Dest>
+    void _solve_impl(const SparseMatrixBase<Rhs> &b, SparseMatrixBase<Dest> &dest) const
+    {
+      internal::solve_sparse_through_dense_panels(*this, b, dest);
+    }
+#endif // EIGEN_PARSED_BY_DOXYGEN
+
+  protected:
+
+    typedef Map<DenseMatrix> SupernodeBlock;
+    typedef Map<const DenseMatrix> ConstSupernodeBlock;
+
+    /** \internal header of the serialized analysis */
+    struct AnalysisHeader {
+      Index size;
+      Index maxUpdateSize;
+      numext::uint64_t fingerprint;
+      bool hasFingerprint;
+    };
+
+    AnalysisHeader analysisHeader() const
+    {
+      AnalysisHeader header = {m_size, m_maxUpdateSize, m_patternFingerprint, m_hasFingerprint};
+      return header;
+    }
+
+    /** \internal \returns the dense block storing the columns of the supernode \a s and their off-diagonal rows */
+    SupernodeBlock supernode(Index s)
+    {
+      return SupernodeBlock(m_values.data()+m_valuePtr[s], m_rowPtr[s+1]-m_rowPtr[s], m_superFirst[s+1]-m_superFirst[s]);
+    }
+    ConstSupernodeBlock supernode(Index s) const
+    {
+      return ConstSupernodeBlock(m_values.data()+m_valuePtr[s], m_rowPtr[s+1]-m_rowPtr[s], m_superFirst[s+1]-m_superFirst[s]);
+    }
+
+    void ordering(const MatrixType& a, CholMatrixType& ap);
+    void analyzePattern_preordered(const CholMatrixType& ap);
+    void factorize_preordered(const CholMatrixType& ap);
+    static bool isValidAnalysis(Index size, const VectorI& pinv, const VectorI& superFirst, const VectorI& superParent,
+                                const VectorIndex& rowPtr, const VectorI& rows, const VectorIndex& valuePtr,
+                                const VectorIndex& sourcePtr, const VectorI& sources, const VectorIndex& sourceRows,
+                                Index& maxUpdateSize);
+    Index partitionTree(Index threads, VectorI& owner) const;
+    bool factorizeSupernode(Index s, const CholMatrixType& ap, StorageIndex* relativeRows, Scalar* workspace);
+    void solveInPlace(DenseMatrix& x) const;
+
+    mutable ComputationInfo m_info;
+    bool m_factorizationIsOk;
+    bool m_analysisIsOk;
+    Index m_size;
+
+    VectorI m_superFirst;       // first column of each supernode, followed by the size of the matrix
+    VectorI m_superParent;      // supernodal elimination tree
+    VectorIndex m_rowPtr;       // start of the row indices of each supernode in m_rows
+    VectorI m_rows;             // rows of each supernode, starting with its own columns
+    VectorIndex m_valuePtr;     // start of the dense column-major block of each supernode in m_values
+    VectorType m_values;
+    VectorIndex m_sourcePtr;    // start of the list of the supernodes updating each supernode in m_sources
+    VectorI m_sources;
+    VectorIndex m_sourceRows;   // for each entry of m_sources, position in its rows of the first updated row
+    Index m_maxUpdateSize;
+
+    bool m_cachedAnalysis;
+    bool m_hasFingerprint;
+    numext::uint64_t m_patternFingerprint;  // hash of the pattern of the analyzed matrix (cached analysis mode)
+
+    PermutationMatrix<Dynamic,Dynamic,StorageIndex> m_P;     // the permutation
+    PermutationMatrix<Dynamic,Dynamic,StorageIndex> m_Pinv;  // the inverse permutation
+
+    RealScalar m_shiftOffset;
+    RealScalar m_shiftScale;
+};
+
+template<typename MatrixType_, int UpLo_, typename Ordering_>
+void SupernodalLLT<MatrixType_,UpLo_,Ordering_>::ordering(const MatrixType& a, CholMatrixType& ap)
+{
+  const Index size = a.rows();
+  // Note that ordering methods compute the inverse permutation
+  if(!internal::is_same<OrderingType,NaturalOrdering<StorageIndex> >::value)
+  {
+    {
+      CholMatrixType C;
+      C = a.template selfadjointView<UpLo>();
+
+      OrderingType ordering;
+      ordering(C,m_Pinv);
+    }
+
+    if(m_Pinv.size()>0) m_P = m_Pinv.inverse();
+    else                m_P.resize(0);
+  }
+  else
+  {
+    m_Pinv.resize(0);
+    m_P.resize(0);
+  }
+
+  ap.resize(size,size);
+  ap.template selfadjointView<Lower>() = a.template selfadjointView<UpLo>().twistedBy(m_P);
+}
+
+template<typename MatrixType_, int UpLo_, typename Ordering_>
+void SupernodalLLT<MatrixType_,UpLo_,Ordering_>::analyzePattern_preordered(const CholMatrixType& ap)
+{
+  const StorageIndex size = StorageIndex(ap.rows());
+  m_size = size;
+
+  // elimination tree and column counts of L, computed as in SimplicialCholeskyBase from the upper triangular part
+  VectorI parent(size), colCount(size);
+  {
+    CholMatrixType upper = ap.transpose();
+    ei_declare_aligned_stack_constructed_variable(StorageIndex, tags, size, 0);
+    for(StorageIndex k = 0; k < size; ++k)
+    {
+      parent[k] = -1;
+      tags[k] = k;
+      colCount[k] = 0;
+      for(typename CholMatrixType::InnerIterator it(upper,k); it; ++it)
+      {
+        StorageIndex i = it.index();
+        if(i < k)
+        {
+          for(; tags[i] != k; i = parent[i])
+          {
+            if (parent[i] == -1)
+              parent[i] = k;
+            colCount[i]++;
+            tags[i] = k;
+          }
+        }
+      }
+    }
+  }
+
+  // Column j+1 joins the supernode of column j if it is its parent and L(:,j) has the same structure as
+  // L(:,j+1) plus the row j+1. The diagonal block of the supernode is then dense, and all its columns
+  // share the rows below it.
+  VectorI fundamental(size+1);
+  Index nf = 0;
+  for(StorageIndex j = 0; j < size; ++j)
+    if(j==0 || parent[j-1]!=j || colCount[j-1]!=colCount[j]+1)
+      fundamental[nf++] = j;
+  fundamental[nf] = size;
+
+  // Relaxed amalgamation: a supernode is also merged into the next one when the latter is its parent, at the
+  // cost of a few explicit zeros, so as to get fewer and larger dense blocks (same thresholds as CHOLMOD).
+  // A supernode ending at a root is never merged, which would join independent subtrees.
+  // The rows of the merged supernode are its columns followed by the off-diagonal rows of the parent.
+  m_superFirst.resize(nf+1);
+  VectorIndex rowCount(nf);
+  Index ns = 0;
+  double nnz = 0;
+  for(Index f = 0; f < nf; ++f)
+  {
+    const Index fnc = fundamental[f+1]-fundamental[f], fnr = colCount[fundamental[f]]+1;
+    const double fnnz = double(fnc)*double(fnr) - 0.5*double(fnc)*double(fnc-1);
+    if(ns>0 && parent[fundamental[f]-1]>=0 && parent[fundamental[f]-1]<fundamental[f+1])
+    {
+      const Index nc = fundamental[f+1]-m_superFirst[ns-1], nr = fundamental[f]-m_superFirst[ns-1]+fnr;
+      const double entries = double(nc)*double(nr) - 0.5*double(nc)*double(nc-1);
+      const double zeros = (entries-nnz-fnnz)/entries;
+      if(nc<=4 || (nc<=16 && zeros<0.8) || (nc<=48 && zeros<0.1) || zeros<0.05)
+      {
+        rowCount[ns-1] = nr;
+        nnz += fnnz;
+        continue;
+      }
+    }
+    m_superFirst[ns] = fundamental[f];
+    rowCount[ns++] = fnr;
+    nnz = fnnz;
+  }
+  m_superFirst[ns] = size;
+  m_superFirst.conservativeResize(ns+1);
+
+  VectorI columnToSuper(size);
+  for(Index s = 0; s < ns; ++s)
+    columnToSuper.segment(m_superFirst[s], m_superFirst[s+1]-m_superFirst[s]).setConstant(StorageIndex(s));
+
+  m_superParent.resize(ns);
+  m_rowPtr.resize(ns+1);
+  m_valuePtr.resize(ns+1);
+  m_rowPtr[0] = 0;
+  m_valuePtr[0] = 0;
+  for(Index s = 0; s < ns; ++s)
+  {
+    const StorageIndex last = m_superFirst[s+1]-1;
+    const Index nc = m_superFirst[s+1]-m_superFirst[s];
+    m_superParent[s] = parent[last]==-1 ? StorageIndex(-1) : columnToSuper[parent[last]];
+    m_rowPtr[s+1] = m_rowPtr[s] + rowCount[s];
+    m_valuePtr[s+1] = m_valuePtr[s] + rowCount[s]*nc;
+  }
+
+  // The rows of a supernode are its columns, the rows of A below them, and the off-diagonal rows of its children.
+  // Children have a lower index than their parent, so that they are always processed first.
+  VectorIndex childPtr = VectorIndex::Zero(ns+1);
+  VectorI children(ns);
+  for(Index s = 0; s < ns; ++s)
+    if(m_superParent[s]>=0) childPtr[m_superParent[s]+1]++;
+  for(Index s = 0; s < ns; ++s)
+    childPtr[s+1] += childPtr[s];
+  {
+    VectorIndex pos = childPtr.head(ns);
+    for(Index s = 0; s < ns; ++s)
+      if(m_superParent[s]>=0) children[pos[m_superParent[s]]++] = StorageIndex(s);
+  }
+
+  m_rows.resize(m_rowPtr[ns]);
+  VectorI marker = VectorI::Constant(size, -1);
+  for(Index s = 0; s < ns; ++s)
+  {
+    const StorageIndex first = m_superFirst[s], last = m_superFirst[s+1]-1;
+    StorageIndex* rows = m_rows.data() + m_rowPtr[s];
+    Index count = 0;
+    for(StorageIndex j = first; j <= last; ++j)
+    {
+      rows[count++] = j;
+      marker[j] = StorageIndex(s);
+    }
+    for(StorageIndex j = first; j <= last; ++j)
+      for(typename CholMatrixType::InnerIterator it(ap,j); it; ++it)
+        if(marker[it.index()]!=s)
+        {
+          marker[it.index()] = StorageIndex(s);
+          rows[count++] = it.index();
+        }
+    for(Index k = childPtr[s]; k < childPtr[s+1]; ++k)
+    {
+      const Index c = children[k];
+      const Index cnc = m_superFirst[c+1]-m_superFirst[c];
+      for(Index p = m_rowPtr[c]+cnc; p < m_rowPtr[c+1]; ++p)
+        if(marker[m_rows[p]]!=s)
+        {
+          marker[m_rows[p]] = StorageIndex(s);
+          rows[count++] = m_rows[p];
+        }
+    }
+    eigen_internal_assert(count==m_rowPtr[s+1]-m_rowPtr[s]);
+    std::sort(rows+(last-first+1), rows+count);
+  }
+
+  // The off-diagonal rows of a supernode d falling in the columns of an ancestor s are contiguous, and d contributes
+  // a single dense update to s. List these updates by target supernode for the left-looking factorization.
+  m_sourcePtr = VectorIndex::Zero(ns+1);
+  for(Index d = 0; d < ns; ++d)
+  {
+    Index p = m_rowPtr[d] + (m_superFirst[d+1]-m_superFirst[d]);
+    while(p < m_rowPtr[d+1])
+    {
+      const StorageIndex t = columnToSuper[m_rows[p]];
+      m_sourcePtr[t+1]++;
+      while(p < m_rowPtr[d+1] && columnToSuper[m_rows[p]]==t) ++p;
+    }
+  }
+  for(Index s = 0; s < ns; ++s)
+    m_sourcePtr[s+1] += m_sourcePtr[s];
+  m_sources.resize(m_sourcePtr[ns]);
+  m_sourceRows.resize(m_sourcePtr[ns]);
+  m_maxUpdateSize = 0;
+  {
+    VectorIndex pos = m_sourcePtr.head(ns);
+    for(Index d = 0; d < ns; ++d)
+    {
+      const Index start = m_rowPtr[d];
+      Index p = start + (m_superFirst[d+1]-m_superFirst[d]);
+      while(p < m_rowPtr[d+1])
+      {
+        const StorageIndex t = columnToSuper[m_rows[p]];
+        const Index q0 = p;
+        while(p < m_rowPtr[d+1] && columnToSuper[m_rows[p]]==t) ++p;
+        m_sources[pos[t]] = StorageIndex(d);
+        m_sourceRows[pos[t]++] = q0-start;
+        m_maxUpdateSize = (std::max)(m_maxUpdateSize, (m_rowPtr[d+1]-q0)*(p-q0));
+      }
+    }
+  }
+
+  m_values.resize(m_valuePtr[ns]);
+
+  m_isInitialized     = true;
+  m_info              = Success;
+  m_analysisIsOk      = true;
+  m_factorizationIsOk = false;
+}
+
+/** \internal \returns whether the arrays of a deserialized analysis describe supernodes that analyzePattern() could
+  * have computed for a matrix of size \a size, so that factorize() and solve() only access memory they own.
+  * On success, \a maxUpdateSize is set to the size of the workspace needed by the updates. */
+template<typename MatrixType_, int UpLo_, typename Ordering_>
+bool SupernodalLLT<MatrixType_,UpLo_,Ordering_>::isValidAnalysis(Index size, const VectorI& pinv, const VectorI& superFirst,
+    const VectorI& superParent, const VectorIndex& rowPtr, const VectorI& rows, const VectorIndex& valuePtr,
+    const VectorIndex& sourcePtr, const VectorI& sources, const VectorIndex& sourceRows, Index& maxUpdateSize)
+{
+  const Index ns = superFirst.size()-1;
+  if(size<0 || ns<0 || superFirst[0]!=0 || superFirst[ns]!=size || superParent.size()!=ns
+     || rowPtr.size()!=ns+1 || valuePtr.size()!=ns+1 || sourcePtr.size()!=ns+1 || rowPtr[0]!=0 || valuePtr[0]!=0 || sourcePtr[0]!=0)
+    return false;
+  if(pinv.size()!=0 && (pinv.size()!=size || !internal::is_permutation_indices(pinv, size)))
+    return false;
+
+  // Supernodes: consecutive columns, a parent of larger index, and a dense block of nr x nc values
+  for(Index s = 0; s < ns; ++s)
+  {
+    const Index nc = Index(superFirst[s+1])-Index(superFirst[s]);
+    const Index nr = rowPtr[s+1]-rowPtr[s];
+    if(nc<=0 || nr<nc || nr>size-superFirst[s] || valuePtr[s+1]-valuePtr[s]!=nr*nc || sourcePtr[s+1]<sourcePtr[s]
+       || (superParent[s]!=-1 && (superParent[s]<=s || superParent[s]>=ns)))
+      return false;
+  }
+  if(rows.size()!=rowPtr[ns] || sources.size()!=sourcePtr[ns] || sourceRows.size()!=sourcePtr[ns])
+    return false;
+
+  // Rows: the columns of the supernode, followed by increasing rows below them
+  for(Index s = 0; s < ns; ++s)
+  {
+    const StorageIndex first = superFirst[s];
+    const Index nc = superFirst[s+1]-first;
+    const StorageIndex* srows = rows.data() + rowPtr[s];
+    for(Index k = 0; k < rowPtr[s+1]-rowPtr[s]; ++k)
+      if(k<nc ? srows[k]!=first+k : (srows[k]<=srows[k-1] || srows[k]>=size))
+        return false;
+  }
+
+  // Interval [start[s], start[s]+count[s]) of the subtrees in a postordering of the supernodal tree,
+  // so that d is a descendant of s if and only if start[s] <= start[d] < start[s]+count[s]-1.
+  VectorIndex count = VectorIndex::Ones(ns), start(ns), next(ns);
+  for(Index s = 0; s < ns; ++s)
+    if(superParent[s]>=0) count[superParent[s]] += count[s];
+  Index nextRoot = 0;
+  for(Index s = ns-1; s >= 0; --s)
+  {
+    Index& pos = superParent[s]>=0 ? next[superParent[s]] : nextRoot;
+    start[s] = next[s] = pos;
+    pos += count[s];
+  }
+
+  // Updates: each source is a descendant whose rows from the updated ones on are columns of s, then rows of s
+  maxUpdateSize = 0;
+  VectorI marker = VectorI::Constant(size, -1);
+  for(Index s = 0; s < ns; ++s)
+  {
+    const StorageIndex first = superFirst[s];
+    const Index nc = superFirst[s+1]-first;
+    for(Index k = rowPtr[s]; k < rowPtr[s+1]; ++k)
+      marker[rows[k]] = StorageIndex(s);
+    for(Index k = sourcePtr[s]; k < sourcePtr[s+1]; ++k)
+    {
+      const Index d = sources[k];
+      if(d<0 || d>=s || start[d]<start[s] || start[d]>=start[s]+count[s]-1)
+        return false;
+      const StorageIndex* drows = rows.data() + rowPtr[d];
+      const Index dnr = rowPtr[d+1]-rowPtr[d];
+      const Index p = sourceRows[k];
+      if(p<superFirst[d+1]-superFirst[d] || p>=dnr || drows[p]<first || drows[p]>=first+nc)
+        return false;
+      Index q = p;
+      while(q < dnr && drows[q] < first+nc) ++q;
+      for(Index i = p; i < dnr; ++i)
+        if(marker[drows[i]]!=s)
+          return false;
+      maxUpdateSize = (std::max)(maxUpdateSize, (dnr-p)*(q-p));
+    }
+  }
+  return true;
+}
+
+/** \internal Assigns the supernodes to \a threads threads: owner[s] is the thread factorizing s in the parallel phase,
+  * or -1 if s is left for the sequential phase. The subtrees are obtained by repeatedly splitting the most expensive
+  * one at its root, until it becomes small enough to balance the load. \returns the number of threads to use in the
+  * parallel phase, or 0 if the tree is too small or too narrow to be worth it. */
+template<typename MatrixType_, int UpLo_, typename Ordering_>
+Index SupernodalLLT<MatrixType_,UpLo_,Ordering_>::partitionTree(Index threads, VectorI& owner) const
+{
+  const Index ns = m_superFirst.size()-1;
+  Matrix<double,Dynamic,1> cost(ns), subtreeCost(ns);
+  for(Index s = 0; s < ns; ++s)
+  {
+    const double nr = double(m_rowPtr[s+1]-m_rowPtr[s]), nc = double(m_superFirst[s+1]-m_superFirst[s]);
+    subtreeCost[s] = cost[s] = nc*nr*nr;
+  }
+  for(Index s = 0; s < ns; ++s)
+    if(m_superParent[s]>=0) subtreeCost[m_superParent[s]] += subtreeCost[s];
+
+  VectorIndex childPtr = VectorIndex::Zero(ns+1);
+  VectorI children(ns);
+  for(Index s = 0; s < ns; ++s)
+    if(m_superParent[s]>=0) childPtr[m_superParent[s]+1]++;
+  for(Index s = 0; s < ns; ++s)
+    childPtr[s+1] += childPtr[s];
+  {
+    VectorIndex pos = childPtr.head(ns);
+    for(Index s = 0; s < ns; ++s)
+      if(m_superParent[s]>=0) children[pos[m_superParent[s]]++] = StorageIndex(s);
+  }
+
+  std::vector<StorageIndex> heap;
+  double queueCost = 0;
+  for(Index s = 0; s < ns; ++s)
+    if(m_superParent[s]<0)
+    {
+      heap.push_back(StorageIndex(s));
+      queueCost += subtreeCost[s];
+    }
+  if(queueCost < 1e6)
+    return 0;
+
+  auto cheaper = [&](StorageIndex a, StorageIndex b) { return subtreeCost[a] < subtreeCost[b]; };
+  std::make_heap(heap.begin(), heap.end(), cheaper);
+  owner.setConstant(ns, -2);
+  while(!heap.empty() && subtreeCost[heap.front()] > queueCost/double(2*threads))
+  {
+    const StorageIndex r = heap.front();
+    if(childPtr[r]==childPtr[r+1])
+      break;
+    std::pop_heap(heap.begin(), heap.end(), cheaper);
+    heap.pop_back();
+    owner[r] = -1;
+    queueCost -= cost[r];
+    for(Index k = childPtr[r]; k < childPtr[r+1]; ++k)
+    {
+      heap.push_back(children[k]);
+      std::push_heap(heap.begin(), heap.end(), cheaper);
+    }
+  }
+  if(heap.size()<2)
+    return 0;
+
+  // largest subtrees first, each one to the least loaded thread
+  std::sort_heap(heap.begin(), heap.end(), cheaper);
+  std::vector<double> load(threads, 0.);
+  for(Index k = Index(heap.size())-1; k >= 0; --k)
+  {
+    const Index t = std::min_element(load.begin(), load.end()) - load.begin();
+    owner[heap[k]] = StorageIndex(t);
+    load[t] += subtreeCost[heap[k]];
+  }
+  for(Index s = ns-1; s >= 0; --s)
+    if(owner[s]==-2)
+      owner[s] = owner[m_superParent[s]];
+  return (std::min)(threads, Index(heap.size()));
+}
+
+template<typename MatrixType_, int UpLo_, typename Ordering_>
+bool SupernodalLLT<MatrixType_,UpLo_,Ordering_>::factorizeSupernode(Index s, const CholMatrixType& ap, StorageIndex* relativeRows, Scalar* workspace)
+{
+  const StorageIndex first = m_superFirst[s];
+  const Index nc = m_superFirst[s+1]-first;
+  const Index nr = m_rowPtr[s+1]-m_rowPtr[s];
+  const StorageIndex* rows = m_rows.data() + m_rowPtr[s];
+  SupernodeBlock L = supernode(s);
+
+  for(Index k = 0; k < nr; ++k)
+    relativeRows[rows[k]] = StorageIndex(k);
+
+  // scatter the columns of A
+  L.setZero();
+  for(Index j = 0; j < nc; ++j)
+  {
+    for(typename CholMatrixType::InnerIterator it(ap,first+j); it; ++it)
+    {
+      if(it.index()==first+j)
+        L(j,j) = numext::real(it.value()) * m_shiftScale + m_shiftOffset;
+      else
+        L(relativeRows[it.index()],j) = it.value();
+    }
+  }
+
+  // left-looking updates from the descendants of s: L(rows,cols) -= Ld(rows,:) * Ld(cols,:)^*
+  for(Index k = m_sourcePtr[s]; k < m_sourcePtr[s+1]; ++k)
+  {
+    const Index d = m_sources[k];
+    const Index p = m_sourceRows[k];
+    const StorageIndex* drows = m_rows.data() + m_rowPtr[d];
+    const Index dnr = m_rowPtr[d+1]-m_rowPtr[d];
+    Index q = p;
+    while(q < dnr && drows[q] < first+nc) ++q;
+
+    ConstSupernodeBlock Ld(m_values.data()+m_valuePtr[d], dnr, m_superFirst[d+1]-m_superFirst[d]);
+    Map<DenseMatrix> C(workspace, dnr-p, q-p);
+    C.noalias() = Ld.bottomRows(dnr-p) * Ld.middleRows(p,q-p).adjoint();
+    for(Index j = 0; j < q-p; ++j)
+    {
+      const Index col = drows[p+j]-first;
+      for(Index i = j; i < dnr-p; ++i)
+        L(relativeRows[drows[p+i]],col) -= C(i,j);
+    }
+  }
+
+  // dense factorization of the supernode
+  Block<SupernodeBlock> L11(L,0,0,nc,nc);
+  if(internal::llt_inplace<Scalar,Lower>::blocked(L11)>=0)
+    return false;
+  if(nr>nc)
+  {
+    Block<SupernodeBlock> L21(L,nc,0,nr-nc,nc);
+    L11.adjoint().template triangularView<Upper>().template solveInPlace<OnTheRight>(L21);
+  }
+  return true;
+}
+
+template<typename MatrixType_, int UpLo_, typename Ordering_>
+void SupernodalLLT<MatrixType_,UpLo_,Ordering_>::factorize_preordered(const CholMatrixType& ap)
+{
+  eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+  eigen_assert(ap.rows()==m_size);
+
+  const Index ns = m_superFirst.size()-1;
+  VectorI owner;
+  const Index threads = ns > 1 ? partitionTree(internal::parallel_loop_threads(), owner) : 0;
+
+  // Independent subtrees first, one group of subtrees per thread. Each supernode only reads its descendants,
+  // which belong to the same group.
+  Matrix<Index,Dynamic,1> failed = Matrix<Index,Dynamic,1>::Constant((std::max)(threads,Index(1)), -1);
+  internal::parallelize_tasks(threads, [&](Index t) {
+    VectorI relativeRows(m_size);
+    VectorType workspace(m_maxUpdateSize);
+    for(Index s = 0; s < ns && failed[t]<0; ++s)
+      if(owner[s]==t && !factorizeSupernode(s, ap, relativeRows.data(), workspace.data()))
+        failed[t] = s;
+  });
+
+  // then the remaining supernodes, close to the root
+  bool ok = (failed.array()<0).all();
+  if(ok)
+  {
+    VectorI relativeRows(m_size);
+    VectorType workspace(m_maxUpdateSize);
+    for(Index s = 0; s < ns && ok; ++s)
+      if(threads==0 || owner[s]<0)
+        ok = factorizeSupernode(s, ap, relativeRows.data(), workspace.data());
+  }
+
+  m_info = ok ? Success : NumericalIssue;
+  m_factorizationIsOk = true;
+}
+
+template<typename MatrixType_, int UpLo_, typename Ordering_>
+void SupernodalLLT<MatrixType_,UpLo_,Ordering_>::solveInPlace(DenseMatrix& x) const
+{
+  const Index ns = m_superFirst.size()-1;
+  DenseMatrix tmp;
+
+  // L y = b
+  for(Index s = 0; s < ns; ++s)
+  {
+    const Index first = m_superFirst[s], nc = m_superFirst[s+1]-first, nr = m_rowPtr[s+1]-m_rowPtr[s];
+    const StorageIndex* rows = m_rows.data() + m_rowPtr[s];
+    ConstSupernodeBlock L = supernode(s);
+    typename DenseMatrix::RowsBlockXpr xs = x.middleRows(first,nc);
+    L.topRows(nc).template triangularView<Lower>().solveInPlace(xs);
+    if(nr>nc)
+    {
+      tmp.noalias() = L.bottomRows(nr-nc) * xs;
+      for(Index k = 0; k < nr-nc; ++k)
+        x.row(rows[nc+k]) -= tmp.row(k);
+    }
+  }
+
+  // L^* x = y
+  for(Index s = ns-1; s >= 0; --s)
+  {
+    const Index first = m_superFirst[s], nc = m_superFirst[s+1]-first, nr = m_rowPtr[s+1]-m_rowPtr[s];
+    const StorageIndex* rows = m_rows.data() + m_rowPtr[s];
+    ConstSupernodeBlock L = supernode(s);
+    typename DenseMatrix::RowsBlockXpr xs = x.middleRows(first,nc);
+    if(nr>nc)
+    {
+      tmp.resize(nr-nc, x.cols());
+      for(Index k = 0; k < nr-nc; ++k)
+        tmp.row(k) = x.row(rows[nc+k]);
+      xs.noalias() -= L.bottomRows(nr-nc).adjoint() * tmp;
+    }
+    L.topRows(nc).adjoint().template triangularView<Upper>().solveInPlace(xs);
+  }
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_SUPERNODAL_LLT_H
@@ -16,6 +16,185 @@ namespace Eigen {
 
 namespace internal {
 
+/** \internal
+  * Multithreaded version of conservative_sparse_sparse_product_impl (Gustavson's algorithm), for a SparseMatrix result.
+  *
+  * The columns of the result are split into ranges of about the same number of multiply-adds. A symbolic pass first
+  * counts the entries of each column of the result, so that the result can be allocated once, and a numeric pass then
+  * fills the columns concurrently. Each thread accumulates a column either in a small hash table sized from the
+  * number of multiply-adds of that column, or, for the columns whose products cover a significant part of the rows,
+  * in a dense array shared by all the columns it processes.
+  *
+  * \returns false without doing anything if a single thread is available or the product is too small.
+  */
+template<typename Lhs, typename Rhs, typename ResScalar, int ResOptions, typename ResStorageIndex>
+bool conservative_sparse_sparse_product_parallel(const Lhs& lhs, const Rhs& rhs,
+                                                 SparseMatrix<ResScalar,ResOptions,ResStorageIndex>& res, bool sortedInsertion)
+{
+  typedef typename remove_all_t<Rhs>::Scalar RhsScalar;
+  typedef ResStorageIndex StorageIndex;
+  typedef Matrix<StorageIndex,Dynamic,1> IndexVector;
+  typedef typename evaluator<Lhs>::InnerIterator LhsIterator;
+  typedef typename evaluator<Rhs>::InnerIterator RhsIterator;
+
+  const Index threads = parallel_loop_threads();
+  if(threads<2)
+    return false;
+  const Index rows = lhs.innerSize();
+  const Index cols = rhs.outerSize();
+  evaluator<Lhs> lhsEval(lhs);
+  evaluator<Rhs> rhsEval(rhs);
+
+  // number of multiply-adds of each column of the result, and ranges of columns with about the same number of them
+  IndexVector lhsSizes(lhs.outerSize());
+  for(Index k = 0; k < lhs.outerSize(); ++k)
+  {
+    StorageIndex count = 0;
+    for(LhsIterator it(lhsEval, k); it; ++it) ++count;
+    lhsSizes[k] = count;
+  }
+  Matrix<Index,Dynamic,1> flops(cols+1);
+  flops[0] = 0;
+  for(Index j = 0; j < cols; ++j)
+  {
+    Index count = 0;
+    for(RhsIterator it(rhsEval, j); it; ++it) count += lhsSizes[it.index()];
+    flops[j+1] = flops[j] + count;
+  }
+  const Index totalFlops = flops[cols];
+  const Index tasks = (std::min)(4*threads, totalFlops/(Index(1)<<16));
+  if(tasks<2)
+    return false;
+  Matrix<Index,Dynamic,1> bounds(tasks+1);
+  for(Index t = 0; t <= tasks; ++t)
+    bounds[t] = std::lower_bound(flops.data(), flops.data()+cols, (totalFlops*t)/tasks) - flops.data();
+  bounds[tasks] = cols;
+
+  // The accumulator of a thread: a dense array indexed by the row for the columns with more than rows/DenseRatio
+  // multiply-adds, a hash table with open addressing otherwise.
+  enum { DenseRatio = 16 };
+  struct Accumulator
+  {
+    IndexVector denseStamp, hashKeys, rowList;
+    Matrix<ResScalar,Dynamic,1> denseValues, hashValues;
+  };
+  auto denseColumn = [&](Index j) { return (flops[j+1]-flops[j])*DenseRatio > rows; };
+  auto hashSize = [&](Index j) {
+    Index size = 16;
+    while(size < 2*(flops[j+1]-flops[j])) size *= 2;
+    return size;
+  };
+  auto hashSlot = [](StorageIndex* keys, Index mask, StorageIndex i) {
+    Index h = Index((numext::uint64_t(i) * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+    while(keys[h]!=i && keys[h]!=-1) h = (h+1) & mask;
+    return h;
+  };
+  // gathers the rows of the entries of the j-th column of the result into acc.rowList and returns their number,
+  // also accumulating their values if numeric is true
+  auto accumulate = [&](Accumulator& acc, Index j, bool numeric) -> Index {
+    Index nnz = 0;
+    if(denseColumn(j))
+    {
+      if(acc.denseStamp.size()==0)
+      {
+        acc.denseStamp.setConstant(rows, -1);
+        acc.denseValues.resize(rows);
+        acc.rowList.resize(rows);
+      }
+      const StorageIndex stamp = StorageIndex(j);
+      for(RhsIterator rhsIt(rhsEval, j); rhsIt; ++rhsIt)
+      {
+        const RhsScalar y = rhsIt.value();
+        for(LhsIterator lhsIt(lhsEval, rhsIt.index()); lhsIt; ++lhsIt)
+        {
+          const Index i = lhsIt.index();
+          if(acc.denseStamp[i]!=stamp)
+          {
+            acc.denseStamp[i] = stamp;
+            acc.rowList[nnz++] = StorageIndex(i);
+            if(numeric) acc.denseValues[i] = lhsIt.value() * y;
+          }
+          else if(numeric)
+            acc.denseValues[i] += lhsIt.value() * y;
+        }
+      }
+    }
+    else
+    {
+      const Index size = hashSize(j);
+      if(acc.hashKeys.size()<size)
+      {
+        acc.hashKeys.resize(size);
+        acc.hashValues.resize(size);
+        if(acc.rowList.size()<size) acc.rowList.resize(size);
+      }
+      StorageIndex* keys = acc.hashKeys.data();
+      std::fill(keys, keys+size, StorageIndex(-1));
+      for(RhsIterator rhsIt(rhsEval, j); rhsIt; ++rhsIt)
+      {
+        const RhsScalar y = rhsIt.value();
+        for(LhsIterator lhsIt(lhsEval, rhsIt.index()); lhsIt; ++lhsIt)
+        {
+          const StorageIndex i = StorageIndex(lhsIt.index());
+          const Index h = hashSlot(keys, size-1, i);
+          if(keys[h]==-1)
+          {
+            keys[h] = i;
+            acc.rowList[nnz++] = i;
+            if(numeric) acc.hashValues[h] = lhsIt.value() * y;
+          }
+          else if(numeric)
+            acc.hashValues[h] += lhsIt.value() * y;
+        }
+      }
+    }
+    return nnz;
+  };
+
+  // symbolic pass
+  res.setZero();
+  res.makeCompressed();
+  StorageIndex* outerIndex = res.outerIndexPtr();
+  outerIndex[0] = 0;
+  parallelize_tasks(tasks, [&](Index t) {
+    Accumulator acc;
+    for(Index j = bounds[t]; j < bounds[t+1]; ++j)
+      outerIndex[j+1] = StorageIndex(accumulate(acc, j, false));
+  });
+  for(Index j = 0; j < cols; ++j)
+  {
+    if(Index(outerIndex[j+1]) > Index(NumTraits<StorageIndex>::highest()) - outerIndex[j])
+      throw_std_bad_alloc();
+    outerIndex[j+1] += outerIndex[j];
+  }
+
+  // numeric pass
+  res.resizeNonZeros(outerIndex[cols]);
+  parallelize_tasks(tasks, [&](Index t) {
+    Accumulator acc;
+    for(Index j = bounds[t]; j < bounds[t+1]; ++j)
+    {
+      const Index nnz = accumulate(acc, j, true);
+      StorageIndex* resIndices = res.innerIndexPtr() + outerIndex[j];
+      ResScalar* resValues = res.valuePtr() + outerIndex[j];
+      std::copy_n(acc.rowList.data(), nnz, resIndices);
+      if(sortedInsertion)
+        std::sort(resIndices, resIndices+nnz);
+      const bool dense = denseColumn(j);
+      const Index mask = dense ? 0 : hashSize(j)-1;
+      for(Index k = 0; k < nnz; ++k)
+        resValues[k] = dense ? acc.denseValues[resIndices[k]] : acc.hashValues[hashSlot(acc.hashKeys.data(), mask, resIndices[k])];
+    }
+  });
+  return true;
+}
+
+template<typename Lhs, typename Rhs, typename ResultType>
+bool conservative_sparse_sparse_product_parallel(const Lhs&, const Rhs&, ResultType&, bool)
+{
+  return false;
+}
+
 template<typename Lhs, typename Rhs, typename ResultType>
 static void conservative_sparse_sparse_product_impl(const Lhs& lhs, const Rhs& rhs, ResultType& res, bool sortedInsertion = false)
 {
@@ -28,6 +207,9 @@ static void conservative_sparse_sparse_product_impl(const Lhs& lhs, const Rhs& r
   Index cols = rhs.outerSize();
   eigen_assert(lhs.outerSize() == rhs.innerSize());
 
+  if(conservative_sparse_sparse_product_parallel(lhs, rhs, res, sortedInsertion))
+    return;
+
   ei_declare_aligned_stack_constructed_variable(bool,   mask,     rows, 0);
   ei_declare_aligned_stack_constructed_variable(ResScalar, values,   rows, 0);
   ei_declare_aligned_stack_constructed_variable(Index,  indices,  rows, 0);
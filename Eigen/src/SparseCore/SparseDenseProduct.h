@@ -19,6 +19,53 @@ namespace internal {
 template <> struct product_promote_storage_type<Sparse,Dense, OuterProduct> { typedef Sparse ret; };
 template <> struct product_promote_storage_type<Dense,Sparse, OuterProduct> { typedef Sparse ret; };
 
+/** \internal
+  * Splits the outer range [0,outerSize) of a sparse matrix into \a parts contiguous ranges
+  * [bounds[k],bounds[k+1]) of about the same cost, counting one unit per stored non-zero and
+  * per outer vector. The cost is read from the outer index array of compressed expressions,
+  * while the other ones are split into ranges with the same number of outer vectors.
+  */
+template<typename Lhs, bool IsCompressed = std::is_base_of<SparseCompressedBase<Lhs>, Lhs>::value>
+struct sparse_nnz_balanced_partition
+{
+  static void run(const Lhs& lhs, Index parts, Index* bounds)
+  {
+    const Index n = lhs.outerSize();
+    for(Index k=0; k<=parts; ++k)
+      bounds[k] = (n*k)/parts;
+  }
+};
+
+template<typename Lhs>
+struct sparse_nnz_balanced_partition<Lhs, true>
+{
+  static void run(const Lhs& lhs, Index parts, Index* bounds)
+  {
+    const Index n = lhs.outerSize();
+    const typename Lhs::StorageIndex* outer = lhs.outerIndexPtr();
+    const Index total = Index(outer[n]-outer[0]) + n;
+    bounds[0] = 0;
+    for(Index k=1; k<parts; ++k)
+    {
+      // first outer index i such that cost(0..i) >= k*total/parts, with cost(0..i) = outer[i]-outer[0]+i
+      const Index target = (total*k)/parts;
+      Index lo = bounds[k-1], hi = n;
+      while(lo<hi)
+      {
+        Index mid = lo + (hi-lo)/2;
+        if(Index(outer[mid]-outer[0]) + mid < target) lo = mid+1;
+        else                                          hi = mid;
+      }
+      bounds[k] = lo;
+    }
+    bounds[parts] = n;
+  }
+};
+
+// This 20000 threshold has been found experimentally on 2D and 3D Poisson problems.
+// It basically represents the minimal amount of work to be done to be worth it.
+enum { SparseDenseProductParallelThreshold = 20000 };
+
 template<typename SparseLhsType, typename DenseRhsType, typename DenseResType,
          typename AlphaType,
          int LhsStorageOrder = ((SparseLhsType::Flags&RowMajorBit)==RowMajorBit) ? RowMajor : ColMajor,
@@ -38,28 +85,26 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, t
     LhsEval lhsEval(lhs);
     
     Index n = lhs.outerSize();
-#ifdef EIGEN_HAS_OPENMP
-    Eigen::initParallel();
-    Index threads = Eigen::nbThreads();
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_GEMM_THREADPOOL)
+    Index threads = parallel_loop_threads();
+    if(threads>1 && lhsEval.nonZerosEstimate() > SparseDenseProductParallelThreshold)
+    {
+      // each thread processes a range of rows holding about the same number of non-zeros
+      ei_declare_aligned_stack_constructed_variable(Index,bounds,threads+1,0);
+      sparse_nnz_balanced_partition<Lhs>::run(lhs, threads, bounds);
+      parallelize_tasks(threads, [&](Index t) {
+        for(Index c=0; c<rhs.cols(); ++c)
+          for(Index i=bounds[t]; i<bounds[t+1]; ++i)
+            processRow(lhsEval,rhs,res,alpha,i,c);
+      });
+      return;
+    }
 #endif
     
     for(Index c=0; c<rhs.cols(); ++c)
     {
-#ifdef EIGEN_HAS_OPENMP
-      // This 20000 threshold has been found experimentally on 2D and 3D Poisson problems.
-      // It basically represents the minimal amount of work to be done to be worth it.
-      if(threads>1 && lhsEval.nonZerosEstimate() > 20000)
-      {
-        #pragma omp parallel for schedule(dynamic,(n+threads*4-1)/(threads*4)) num_threads(threads)
-        for(Index i=0; i<n; ++i)
-          processRow(lhsEval,rhs,res,alpha,i,c);
-      }
-      else
-#endif
-      {
-        for(Index i=0; i<n; ++i)
-          processRow(lhsEval,rhs,res,alpha,i,c);
-      }
+      for(Index i=0; i<n; ++i)
+        processRow(lhsEval,rhs,res,alpha,i,c);
     }
   }
   
@@ -103,15 +148,53 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, A
   static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const AlphaType& alpha)
   {
     LhsEval lhsEval(lhs);
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_GEMM_THREADPOOL)
+    Index threads = parallel_loop_threads();
+    // Every column scatters into the whole result, so each thread accumulates its range of columns
+    // into a private copy of the result, which are then summed. This is only worth it if the
+    // non-zeros outnumber the coefficients of these copies.
+    if(threads>1 && lhsEval.nonZerosEstimate() > SparseDenseProductParallelThreshold
+                 && lhsEval.nonZerosEstimate() > threads*lhs.rows())
+    {
+      runParallel(lhs, lhsEval, rhs, res, alpha, threads);
+      return;
+    }
+#endif
     for(Index c=0; c<rhs.cols(); ++c)
     {
       for(Index j=0; j<lhs.outerSize(); ++j)
-      {
-//        typename Res::Scalar rhs_j = alpha * rhs.coeff(j,c);
-        typename ScalarBinaryOpTraits<AlphaType, typename Rhs::Scalar>::ReturnType rhs_j(alpha * rhs.coeff(j,c));
-        for(LhsInnerIterator it(lhsEval,j); it ;++it)
-          res.coeffRef(it.index(),c) += it.value() * rhs_j;
-      }
+        processCol(lhsEval, rhs, res, alpha, j, c, c);
+    }
+  }
+
+  template<typename ResType>
+  static void processCol(const LhsEval& lhsEval, const DenseRhsType& rhs, ResType& res, const AlphaType& alpha, Index j, Index rhsCol, Index resCol)
+  {
+//    typename Res::Scalar rhs_j = alpha * rhs.coeff(j,rhsCol);
+    typename ScalarBinaryOpTraits<AlphaType, typename Rhs::Scalar>::ReturnType rhs_j(alpha * rhs.coeff(j,rhsCol));
+    for(LhsInnerIterator it(lhsEval,j); it ;++it)
+      res.coeffRef(it.index(),resCol) += it.value() * rhs_j;
+  }
+
+  static void runParallel(const SparseLhsType& lhs, const LhsEval& lhsEval, const DenseRhsType& rhs, DenseResType& res, const AlphaType& alpha, Index threads)
+  {
+    typedef Matrix<typename Res::Scalar,Dynamic,Dynamic> PartialType;
+    const Index rows = lhs.rows();
+    ei_declare_aligned_stack_constructed_variable(Index,bounds,threads+1,0);
+    sparse_nnz_balanced_partition<Lhs>::run(lhs, threads, bounds);
+    PartialType partial(rows, threads);
+    for(Index c=0; c<rhs.cols(); ++c)
+    {
+      parallelize_tasks(threads, [&](Index t) {
+        partial.col(t).setZero();
+        for(Index j=bounds[t]; j<bounds[t+1]; ++j)
+          processCol(lhsEval, rhs, partial, alpha, j, c, t);
+      });
+      // sum the partial results by blocks of rows
+      parallelize_tasks(threads, [&](Index t) {
+        const Index r0 = (rows*t)/threads, r1 = (rows*(t+1))/threads;
+        res.col(c).segment(r0,r1-r0) += partial.middleRows(r0,r1-r0).rowwise().sum();
+      });
     }
   }
 };
@@ -129,23 +212,21 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, t
     Index n = lhs.rows();
     LhsEval lhsEval(lhs);
 
-#ifdef EIGEN_HAS_OPENMP
-    Eigen::initParallel();
-    Index threads = Eigen::nbThreads();
-    // This 20000 threshold has been found experimentally on 2D and 3D Poisson problems.
-    // It basically represents the minimal amount of work to be done to be worth it.
-    if(threads>1 && lhsEval.nonZerosEstimate()*rhs.cols() > 20000)
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_GEMM_THREADPOOL)
+    Index threads = parallel_loop_threads();
+    if(threads>1 && lhsEval.nonZerosEstimate()*rhs.cols() > SparseDenseProductParallelThreshold)
     {
-      #pragma omp parallel for schedule(dynamic,(n+threads*4-1)/(threads*4)) num_threads(threads)
-      for(Index i=0; i<n; ++i)
-        processRow(lhsEval,rhs,res,alpha,i);
+      ei_declare_aligned_stack_constructed_variable(Index,bounds,threads+1,0);
+      sparse_nnz_balanced_partition<Lhs>::run(lhs, threads, bounds);
+      parallelize_tasks(threads, [&](Index t) {
+        for(Index i=bounds[t]; i<bounds[t+1]; ++i)
+          processRow(lhsEval,rhs,res,alpha,i);
+      });
+      return;
     }
-    else
 #endif
-    {
-      for(Index i=0; i<n; ++i)
-        processRow(lhsEval, rhs, res, alpha, i);
-    }
+    for(Index i=0; i<n; ++i)
+      processRow(lhsEval, rhs, res, alpha, i);
   }
 
   static void processRow(const LhsEval& lhsEval, const DenseRhsType& rhs, Res& res, const typename Res::Scalar& alpha, Index i)
@@ -1090,6 +1090,124 @@ private:
 
 namespace internal {
 
+// Multithreaded version of set_from_triplets for random access iterators. Each thread counts and scatters a
+// contiguous chunk of the triplets, and the chunks are placed one after the other within each inner vector, so
+// that duplicates are combined in the order of the triplets as in the sequential version. The inner vectors are
+// then collapsed, compacted into the final storage, and sorted if needed, by ranges of about the same number of
+// entries. The per-thread counters and duplicate trackers need tasks*max(innerSize,outerSize) indices, so the
+// number of tasks is bounded to keep them smaller than the triplets.
+// Returns false without doing anything when the range is too small or a single thread is available.
+template <typename InputIterator, typename SparseMatrixType, typename DupFunctor>
+bool set_from_triplets_parallel(const InputIterator& begin, const InputIterator& end, SparseMatrixType& mat,
+                                DupFunctor dup_func, std::random_access_iterator_tag) {
+  constexpr bool IsRowMajor = SparseMatrixType::IsRowMajor;
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+  typedef Matrix<StorageIndex, Dynamic, 1> IndexVector;
+  const Index size = end - begin;
+  const Index outerSize = mat.outerSize(), innerSize = mat.innerSize();
+  const Index tasks = numext::mini(parallel_loop_threads(), size / numext::maxi(numext::maxi(outerSize, innerSize), Index(1) << 15));
+  if (tasks < 2) return false;
+  if (size > Index(NumTraits<StorageIndex>::highest())) internal::throw_std_bad_alloc();
+
+  mat.resize(mat.rows(), mat.cols());
+  StorageIndex* outerIndex = mat.outerIndexPtr();
+  auto chunk = [&](Index t) { return begin + (size * t) / tasks; };
+  auto outerRange = [&](Index t) { return (outerSize * t) / tasks; };
+
+  // number of entries of each inner vector in each chunk, then position of the first one
+  Matrix<StorageIndex, Dynamic, Dynamic> position(outerSize, tasks);
+  parallelize_tasks(tasks, [&](Index t) {
+    StorageIndex* count = position.col(t).data();
+    std::fill(count, count + outerSize, StorageIndex(0));
+    for (InputIterator it = chunk(t); it != chunk(t + 1); ++it) {
+      eigen_assert(it->row() >= 0 && it->row() < mat.rows() && it->col() >= 0 && it->col() < mat.cols());
+      count[IsRowMajor ? it->row() : it->col()]++;
+    }
+  });
+  outerIndex[0] = 0;
+  parallelize_tasks(tasks, [&](Index t) {
+    for (Index j = outerRange(t); j < outerRange(t + 1); ++j) outerIndex[j + 1] = position.row(j).sum();
+  });
+  std::partial_sum(outerIndex, outerIndex + outerSize + 1, outerIndex);
+  parallelize_tasks(tasks, [&](Index t) {
+    for (Index j = outerRange(t); j < outerRange(t + 1); ++j) {
+      StorageIndex p = outerIndex[j];
+      for (Index s = 0; s < tasks; ++s) {
+        const StorageIndex count = position(j, s);
+        position(j, s) = p;
+        p += count;
+      }
+    }
+  });
+
+  // scatter the triplets
+  mat.resizeNonZeros(size);
+  parallelize_tasks(tasks, [&](Index t) {
+    StorageIndex* back = position.col(t).data();
+    for (InputIterator it = chunk(t); it != chunk(t + 1); ++it) {
+      const StorageIndex k = back[IsRowMajor ? it->row() : it->col()]++;
+      mat.data().index(k) = convert_index<StorageIndex>(IsRowMajor ? it->col() : it->row());
+      mat.data().value(k) = it->value();
+    }
+  });
+
+  // ranges of inner vectors with about the same number of entries
+  IndexVector bounds(tasks + 1);
+  for (Index t = 0; t <= tasks; ++t)
+    bounds[t] = StorageIndex(std::upper_bound(outerIndex, outerIndex + outerSize, StorageIndex((size * t) / tasks)) - outerIndex);
+  bounds[0] = 0;
+  bounds[tasks] = StorageIndex(outerSize);
+
+  // collapse the duplicates at the beginning of each inner vector
+  IndexVector nonZeros(outerSize + 1);
+  nonZeros[0] = 0;
+  parallelize_tasks(tasks, [&](Index t) {
+    IndexVector wi = IndexVector::Constant(innerSize, -1);
+    for (Index j = bounds[t]; j < bounds[t + 1]; ++j) {
+      const StorageIndex start = outerIndex[j];
+      StorageIndex count = start;
+      for (StorageIndex k = start; k < outerIndex[j + 1]; ++k) {
+        const StorageIndex i = mat.data().index(k);
+        if (wi[i] >= start) {
+          mat.data().value(wi[i]) = dup_func(mat.data().value(wi[i]), mat.data().value(k));
+        } else {
+          mat.data().value(count) = mat.data().value(k);
+          mat.data().index(count) = i;
+          wi[i] = count++;
+        }
+      }
+      nonZeros[j + 1] = count - start;
+    }
+  });
+  std::partial_sum(nonZeros.data(), nonZeros.data() + outerSize + 1, nonZeros.data());
+
+  // compact and sort
+  typename SparseMatrixType::Storage data;
+  data.resize(nonZeros[outerSize]);
+  parallelize_tasks(tasks, [&](Index t) {
+    for (Index j = bounds[t]; j < bounds[t + 1]; ++j) {
+      const Index count = nonZeros[j + 1] - nonZeros[j];
+      std::copy_n(mat.data().indexPtr() + outerIndex[j], count, data.indexPtr() + nonZeros[j]);
+      std::copy_n(mat.data().valuePtr() + outerIndex[j], count, data.valuePtr() + nonZeros[j]);
+      if (!std::is_sorted(data.indexPtr() + nonZeros[j], data.indexPtr() + nonZeros[j + 1])) {
+        CompressedStorageIterator<Scalar, StorageIndex> first(nonZeros[j], data.indexPtr(), data.valuePtr());
+        CompressedStorageIterator<Scalar, StorageIndex> last(nonZeros[j + 1], data.indexPtr(), data.valuePtr());
+        std::sort(first, last, std::less<>());
+      }
+    }
+  });
+  mat.data().swap(data);
+  std::copy_n(nonZeros.data(), outerSize + 1, outerIndex);
+  return true;
+}
+
+template <typename InputIterator, typename SparseMatrixType, typename DupFunctor>
+bool set_from_triplets_parallel(const InputIterator&, const InputIterator&, SparseMatrixType&, DupFunctor,
+                                std::input_iterator_tag) {
+  return false;
+}
+
 // Creates a compressed sparse matrix from a range of unsorted triplets
 // Requires temporary storage to handle duplicate entries
 template <typename InputIterator, typename SparseMatrixType, typename DupFunctor>
@@ -1100,6 +1218,9 @@ void set_from_triplets(const InputIterator& begin, const InputIterator& end, Spa
   typedef typename SparseMatrixType::StorageIndex StorageIndex;
   typedef typename VectorX<StorageIndex>::AlignedMapType IndexMap;
   if (begin == end) return;
+  if (set_from_triplets_parallel(begin, end, mat, dup_func,
+                                 typename std::iterator_traits<InputIterator>::iterator_category()))
+    return;
 
   // free innerNonZeroPtr (if present) and zero outerIndexPtr
   mat.resize(mat.rows(), mat.cols());
@@ -1239,6 +1360,11 @@ void set_from_triplets_sorted(const InputIterator& begin, const InputIterator& e
   * \warning The list of triplets is read multiple times (at least twice). Therefore, it is not recommended to define
   * an abstract iterator over a complex data-structure that would be expensive to evaluate. The triplets should rather
   * be explicitly stored into a std::vector for instance.
+  *
+  * When multi-threading is enabled (see \ref TopicMultiThreading) and the iterators are random access iterators,
+  * large ranges of triplets are split among the threads, which count, scatter, collapse and sort the entries
+  * concurrently. The result is the same, including the order in which duplicates are combined, but this requires
+  * an additional temporary copy of the final entries.
   */
 template<typename Scalar, int Options_, typename StorageIndex_>
 template<typename InputIterators>
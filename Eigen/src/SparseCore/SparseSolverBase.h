@@ -56,6 +56,50 @@ solve_sparse_through_dense_panels(const Decomposition &dec, const Rhs& rhs, Dest
   dest = dest_dense.sparseView();
 }
 
+/** \internal
+  * \returns a 64 bits hash of the dimensions of \a mat and of the positions of its stored entries, ignoring their values.
+  * Sparse solvers use it to detect that a new matrix has the same pattern as the one they analyzed.
+  */
+template<typename Derived>
+numext::uint64_t sparse_pattern_fingerprint(const SparseMatrixBase<Derived>& mat)
+{
+  typedef evaluator<Derived> EvaluatorType;
+  const numext::uint64_t k = 0xff51afd7ed558ccdULL;
+  numext::uint64_t h = 0xcbf29ce484222325ULL;
+  auto mix = [&](numext::uint64_t v) { h = (h ^ v) * k; h ^= h >> 32; };
+  mix(numext::uint64_t(mat.rows()));
+  mix(numext::uint64_t(mat.cols()));
+  EvaluatorType eval(mat.derived());
+  for(Index j = 0; j < mat.outerSize(); ++j)
+  {
+    numext::uint64_t count = 0;
+    for(typename EvaluatorType::InnerIterator it(eval,j); it; ++it, ++count)
+      mix(numext::uint64_t(it.index()));
+    mix(count);
+  }
+  return h;
+}
+
+/** \internal
+  * \returns whether the \a n first entries of \a indices form a permutation of {0,...,n-1}.
+  * Sparse solvers use it to validate the permutations of a deserialized analysis.
+  */
+template<typename IndexVector>
+bool is_permutation_indices(const IndexVector& indices, Index n)
+{
+  if(indices.size()<n)
+    return false;
+  Matrix<bool,Dynamic,1> seen = Matrix<bool,Dynamic,1>::Constant(n, false);
+  for(Index i = 0; i < n; ++i)
+  {
+    Index k = indices(i);
+    if(k<0 || k>=n || seen(k))
+      return false;
+    seen(k) = true;
+  }
+  return true;
+}
+
 } // end namespace internal
 
 /** \class SparseSolverBase
@@ -171,6 +171,183 @@ struct sparse_solve_triangular_selector<Lhs,Rhs,Mode,Upper,ColMajor>
   }
 };
 
+/** \internal
+  * Level schedule of a sparse triangular matrix stored in row-major order, for parallel forward and backward substitutions.
+  *
+  * The level of a row is one more than the largest level of the rows it depends on, so that the unknowns of a level
+  * only depend on the unknowns of the previous levels and can be computed concurrently. The schedule only depends on
+  * the pattern of the matrix: it is computed once by analyze(), and each call to solveInPlace() then processes the
+  * wide levels one after the other, their rows being split among the threads (see parallelize_tasks()). Consecutive
+  * narrow levels are not worth a synchronization: they are merged and their rows are solved in their natural order,
+  * which is also what happens to all rows when a single thread is available.
+  *
+  * As with the sequential row-major forward substitution, the strictly lower entries of each row must be stored
+  * before its diagonal entry and its strictly upper entries when \c Mode contains \c Lower.
+  */
+template<typename StorageIndex>
+class sparse_triangular_levels
+{
+  public:
+    typedef Matrix<StorageIndex,Dynamic,1> IndexVector;
+
+    enum { MinRowsPerTask = 512 };
+
+    sparse_triangular_levels() : m_levels(0) {}
+
+    /** \returns whether analyze() has been called since the last call to clear() */
+    bool isAnalyzed() const { return m_segmentPtr.size()>0; }
+
+    /** \returns the number of levels, that is the length of the longest chain of dependencies */
+    Index levels() const { return m_levels; }
+
+    void clear()
+    {
+      m_levels = 0;
+      m_segmentPtr.resize(0);
+      m_rows.resize(0);
+    }
+
+    /** Computes the levels of the rows of the triangular part \a Mode of \a lhs */
+    template<int Mode, typename Lhs>
+    void analyze(const Lhs& lhs)
+    {
+      EIGEN_STATIC_ASSERT(bool(int(traits<Lhs>::Flags)&RowMajorBit), THIS_METHOD_IS_ONLY_FOR_ROW_MAJOR_MATRICES);
+      typedef evaluator<Lhs> LhsEval;
+      typedef typename LhsEval::InnerIterator LhsIterator;
+      const Index n = lhs.rows();
+      LhsEval lhsEval(lhs);
+      IndexVector level(n);
+      StorageIndex numLevels = 0;
+      for(Index k = 0; k < n; ++k)
+      {
+        const Index i = (Mode & Lower) ? k : n-1-k;
+        StorageIndex l = 0;
+        for(LhsIterator it(lhsEval, i); it; ++it)
+        {
+          const Index j = it.index();
+          if((Mode & Lower) ? j>=i : j<=i)
+          {
+            if(Mode & Lower) break;
+            continue;
+          }
+          l = (std::max)(l, StorageIndex(level[j]+1));
+        }
+        level[i] = l;
+        numLevels = (std::max)(numLevels, StorageIndex(l+1));
+      }
+      m_levels = numLevels;
+
+      // rows sorted by level, in the order of the substitution within a level
+      IndexVector levelPtr = IndexVector::Zero(numLevels+1);
+      for(Index i = 0; i < n; ++i)
+        levelPtr[level[i]+1]++;
+      for(Index l = 0; l < numLevels; ++l)
+        levelPtr[l+1] += levelPtr[l];
+      m_rows.resize(n);
+      IndexVector pos = levelPtr.head(numLevels);
+      for(Index k = 0; k < n; ++k)
+      {
+        const Index i = (Mode & Lower) ? k : n-1-k;
+        m_rows[pos[level[i]]++] = StorageIndex(i);
+      }
+
+      // segments: each wide level on its own (with a negative start), and the runs of narrow levels
+      std::vector<StorageIndex> segments;
+      bool narrowRun = false;
+      for(Index l = 0; l < numLevels; ++l)
+      {
+        if(levelPtr[l+1]-levelPtr[l] >= 2*Index(MinRowsPerTask))
+        {
+          segments.push_back(-levelPtr[l]-1);
+          narrowRun = false;
+        }
+        else if(!narrowRun)
+        {
+          segments.push_back(levelPtr[l]);
+          narrowRun = true;
+        }
+      }
+      segments.push_back(StorageIndex(n));
+      m_segmentPtr = Map<const IndexVector>(segments.data(), segments.size());
+
+      // a run of narrow levels can be solved in the natural order of its rows
+      for(Index k = 0; k+1 < m_segmentPtr.size(); ++k)
+        if(m_segmentPtr[k]>=0)
+        {
+          StorageIndex* begin = m_rows.data() + segmentStart(k);
+          StorageIndex* end = m_rows.data() + segmentStart(k+1);
+          if(Mode & Lower) std::sort(begin, end);
+          else             std::sort(begin, end, std::greater<StorageIndex>());
+        }
+    }
+
+    /** Solves \a lhs.triangularView<Mode>() * X = \a other in place, \a lhs having the pattern given to analyze() */
+    template<int Mode, typename Lhs, typename Rhs>
+    void solveInPlace(const Lhs& lhs, Rhs& other) const
+    {
+      EIGEN_STATIC_ASSERT(bool(int(traits<Lhs>::Flags)&RowMajorBit), THIS_METHOD_IS_ONLY_FOR_ROW_MAJOR_MATRICES);
+      typedef evaluator<Lhs> LhsEval;
+      typedef typename LhsEval::InnerIterator LhsIterator;
+      typedef typename Rhs::Scalar Scalar;
+      eigen_assert(isAnalyzed() && m_rows.size()==lhs.rows() && lhs.rows()==other.rows());
+
+      LhsEval lhsEval(lhs);
+      auto solveRow = [&](Index i) {
+        for(Index col = 0; col < other.cols(); ++col)
+        {
+          Scalar tmp = other.coeff(i,col);
+          Scalar diag(1);
+          for(LhsIterator it(lhsEval, i); it; ++it)
+          {
+            const Index j = it.index();
+            if(j==i)
+            {
+              diag = it.value();
+              if(Mode & Lower) break;
+            }
+            else if((Mode & Lower) ? j<i : j>i)
+              tmp -= it.value() * other.coeff(j,col);
+            else if(Mode & Lower)
+              break;
+          }
+          other.coeffRef(i,col) = (Mode & UnitDiag) ? tmp : Scalar(tmp/diag);
+        }
+      };
+
+      const Index n = lhs.rows();
+      const Index threads = parallel_loop_threads();
+      if(threads<=1)
+      {
+        for(Index k = 0; k < n; ++k)
+          solveRow((Mode & Lower) ? k : n-1-k);
+        return;
+      }
+      for(Index s = 0; s+1 < m_segmentPtr.size(); ++s)
+      {
+        const Index begin = segmentStart(s), end = segmentStart(s+1);
+        if(m_segmentPtr[s]>=0)
+        {
+          for(Index k = begin; k < end; ++k)
+            solveRow(m_rows[k]);
+          continue;
+        }
+        const Index count = end-begin;
+        const Index tasks = (std::min)(threads, count/Index(MinRowsPerTask));
+        parallelize_tasks(tasks, [&](Index t) {
+          for(Index k = begin + (count*t)/tasks; k < begin + (count*(t+1))/tasks; ++k)
+            solveRow(m_rows[k]);
+        });
+      }
+    }
+
+  protected:
+    Index segmentStart(Index s) const { return m_segmentPtr[s]<0 ? -m_segmentPtr[s]-1 : m_segmentPtr[s]; }
+
+    Index m_levels;
+    IndexVector m_segmentPtr;  // start of each segment in m_rows, encoded as -start-1 for the wide levels, followed by the number of rows
+    IndexVector m_rows;        // rows sorted by level
+};
+
 } // end namespace internal
 
 #ifndef EIGEN_PARSED_BY_DOXYGEN
@@ -158,12 +158,12 @@ class SparseLU : public SparseSolverBase<SparseLU<MatrixType_,OrderingType_> >,
     
   public:
 
-    SparseLU():m_lastError(""),m_Ustore(0,0,0,0,0,0),m_symmetricmode(false),m_diagpivotthresh(1.0),m_detPermR(1)
+    SparseLU():m_factorizationIsOk(false),m_analysisIsOk(false),m_analyzedCols(0),m_lastError(""),m_Ustore(0,0,0,0,0,0),m_symmetricmode(false),m_cachedAnalysis(false),m_hasFingerprint(false),m_patternFingerprint(0),m_diagpivotthresh(1.0),m_detPermR(1)
     {
       initperfvalues(); 
     }
     explicit SparseLU(const MatrixType& matrix)
-      : m_lastError(""),m_Ustore(0,0,0,0,0,0),m_symmetricmode(false),m_diagpivotthresh(1.0),m_detPermR(1)
+      : m_factorizationIsOk(false),m_analysisIsOk(false),m_analyzedCols(0),m_lastError(""),m_Ustore(0,0,0,0,0,0),m_symmetricmode(false),m_cachedAnalysis(false),m_hasFingerprint(false),m_patternFingerprint(0),m_diagpivotthresh(1.0),m_detPermR(1)
     {
       initperfvalues(); 
       compute(matrix);
@@ -184,12 +184,79 @@ class SparseLU : public SparseSolverBase<SparseLU<MatrixType_,OrderingType_> >,
       */
     void compute (const MatrixType& matrix)
     {
-      // Analyze 
-      analyzePattern(matrix); 
+      // Analyze, unless the pattern is the one of the last analysis in the cached analysis mode
+      if(!m_cachedAnalysis || !m_analysisIsOk || !m_hasFingerprint || internal::sparse_pattern_fingerprint(matrix)!=m_patternFingerprint)
+        analyzePattern(matrix); 
       //Factorize
       factorize(matrix);
     } 
 
+    /** Enables or disables the cached analysis mode, which is disabled by default.
+      *
+      * In this mode, compute() hashes the positions of the non-zeros of its input matrix, and skips analyzePattern()
+      * when they match the ones of the matrix given to the last analysis. Calling compute() in a loop over matrices
+      * sharing the same pattern then costs a single ordering and elimination tree computation.
+      *
+      * \sa serializeAnalysis()
+      */
+    void setCachedAnalysis(bool enable)
+    {
+      m_cachedAnalysis = enable;
+    }
+
+    /** \returns whether the cached analysis mode is enabled
+      * \sa setCachedAnalysis() */
+    bool cachedAnalysis() const { return m_cachedAnalysis; }
+
+    /** \returns the size in bytes of the buffer needed by serializeAnalysis() */
+    size_t serializedAnalysisSize() const
+    {
+      eigen_assert(m_analysisIsOk && "analyzePattern() should be called first");
+      return Eigen::serialize_size(analysisHeader(), m_perm_c.indices(), m_etree);
+    }
+
+    /** Writes the symbolic analysis (column permutation and column elimination tree) to the buffer [\a dest, \a end),
+      * so that it can be restored by deserializeAnalysis(), possibly in another process.
+      *
+      * \returns the address following the serialized data, or \c nullptr if the buffer is too small.
+      *
+      * \sa serializedAnalysisSize(), deserializeAnalysis()
+      */
+    uint8_t* serializeAnalysis(uint8_t* dest, uint8_t* end) const
+    {
+      eigen_assert(m_analysisIsOk && "analyzePattern() should be called first");
+      return Eigen::serialize(dest, end, analysisHeader(), m_perm_c.indices(), m_etree);
+    }
+
+    /** Restores a symbolic analysis written by serializeAnalysis().
+      * factorize() can then be called right away on matrices having the analyzed pattern, and so can compute()
+      * in the cached analysis mode if the analysis was computed in this mode.
+      *
+      * \returns the address following the serialized data, or \c nullptr if the data are invalid.
+      *
+      * \sa serializeAnalysis()
+      */
+    const uint8_t* deserializeAnalysis(const uint8_t* src, const uint8_t* end)
+    {
+      AnalysisHeader header;
+      IndexVector perm, etree;
+      src = Eigen::deserialize(src, end, header, perm, etree);
+      m_analysisIsOk = false;
+      m_factorizationIsOk = false;
+      m_isInitialized = false;
+      m_info = InvalidInput;
+      if(src==nullptr || !isValidAnalysis(header, perm, etree))
+        return nullptr;
+      m_analyzedCols = header.cols;
+      m_perm_c.indices() = perm;
+      m_etree = etree;
+      m_symmetricmode = header.symmetric;
+      m_hasFingerprint = header.hasFingerprint;
+      m_patternFingerprint = header.fingerprint;
+      m_analysisIsOk = true;
+      return src;
+    }
+
     /** \returns an expression of the transposed of the factored matrix.
       *
       * A typical usage is to solve for the transposed problem A^T x = b:
@@ -229,11 +296,14 @@ class SparseLU : public SparseSolverBase<SparseLU<MatrixType_,OrderingType_> >,
       return adjointView;
     }
     
-    inline Index rows() const { return m_mat.rows(); }
-    inline Index cols() const { return m_mat.cols(); }
+    inline Index rows() const { return m_analyzedCols; }
+    inline Index cols() const { return m_analyzedCols; }
     /** Indicate that the pattern of the input matrix is symmetric */
     void isSymmetric(bool sym)
     {
+      // the analysis depends on this mode
+      if(sym!=m_symmetricmode)
+        m_hasFingerprint = false;
       m_symmetricmode = sym;
     }
     
@@ -469,11 +539,53 @@ class SparseLU : public SparseSolverBase<SparseLU<MatrixType_,OrderingType_> >,
       m_perfv.colblk = 8; 
       m_perfv.fillfactor = 20;  
     }
+
+    /** \internal header of the serialized analysis */
+    struct AnalysisHeader {
+      Index cols;
+      numext::uint64_t fingerprint;
+      bool hasFingerprint;
+      bool symmetric;
+    };
+
+    AnalysisHeader analysisHeader() const
+    {
+      AnalysisHeader header = {m_analyzedCols, m_patternFingerprint, m_hasFingerprint, m_symmetricmode};
+      return header;
+    }
+
+    /** \internal \returns whether \a perm and \a etree are a column permutation and a column elimination tree
+      * that analyzePattern() could have computed for a matrix having \a header.cols columns */
+    static bool isValidAnalysis(const AnalysisHeader& header, const IndexVector& perm, const IndexVector& etree)
+    {
+      const Index n = header.cols;
+      if(n<0 || n>=Index(NumTraits<StorageIndex>::highest()) || etree.size()<n)
+        return false;
+      if(perm.size()!=0 && (perm.size()!=n || !internal::is_permutation_indices(perm, n)))
+        return false;
+      // Each column has a parent of larger index, the roots having the virtual parent n
+      for(Index j = 0; j < n; ++j)
+        if(etree(j)<=j || etree(j)>n)
+          return false;
+      if(!header.symmetric)
+      {
+        // Outside of the symmetric mode, the supernodes are detected assuming the tree is postordered
+        IndexVector post, tree(n+1);
+        tree.head(n) = etree.head(n);
+        tree(n) = StorageIndex(n);
+        internal::treePostorder(StorageIndex(n), tree, post);
+        for(Index j = 0; j < n; ++j)
+          if(post(j)!=j)
+            return false;
+      }
+      return true;
+    }
       
     // Variables 
     mutable ComputationInfo m_info;
     bool m_factorizationIsOk;
     bool m_analysisIsOk;
+    Index m_analyzedCols; // Number of columns of the analyzed matrix
     std::string m_lastError;
     NCMatrix m_mat; // The input (permuted ) matrix 
     SCMatrix m_Lstore; // The lower triangular matrix (supernodal)
@@ -486,6 +598,9 @@ class SparseLU : public SparseSolverBase<SparseLU<MatrixType_,OrderingType_> >,
                                
     // SparseLU options 
     bool m_symmetricmode;
+    bool m_cachedAnalysis;
+    bool m_hasFingerprint;
+    numext::uint64_t m_patternFingerprint; // hash of the pattern of the analyzed matrix (cached analysis mode)
     // values for performance 
     internal::perfvalues m_perfv;
     RealScalar m_diagpivotthresh; // Specifies the threshold used for a diagonal entry to be an acceptable pivot
@@ -517,6 +632,8 @@ void SparseLU<MatrixType, OrderingType>::analyzePattern(const MatrixType& mat)
   
   // Firstly, copy the whole input matrix. 
   m_mat = mat;
+  m_analyzedCols = mat.cols();
+  m_factorizationIsOk = false;
   
   // Compute fill-in ordering
   OrderingType ord; 
@@ -570,6 +687,8 @@ void SparseLU<MatrixType, OrderingType>::analyzePattern(const MatrixType& mat)
     
   } // end postordering 
   
+  m_hasFingerprint = m_cachedAnalysis;
+  m_patternFingerprint = m_cachedAnalysis ? internal::sparse_pattern_fingerprint(mat) : 0;
   m_analysisIsOk = true; 
 }
 
@@ -600,6 +719,7 @@ void SparseLU<MatrixType, OrderingType>::factorize(const MatrixType& matrix)
   using internal::emptyIdxLU;
   eigen_assert(m_analysisIsOk && "analyzePattern() should be called first"); 
   eigen_assert((matrix.rows() == matrix.cols()) && "Only for squared matrices");
+  eigen_assert((matrix.cols() == m_analyzedCols) && "The matrix should have the size of the analyzed one");
   
   m_isInitialized = true;
   
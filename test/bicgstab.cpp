@@ -15,20 +15,62 @@ template<typename T, typename I_> void test_bicgstab_T()
   BiCGSTAB<SparseMatrix<T,0,I_>, DiagonalPreconditioner<T> >     bicgstab_colmajor_diag;
   BiCGSTAB<SparseMatrix<T,0,I_>, IdentityPreconditioner    >     bicgstab_colmajor_I;
   BiCGSTAB<SparseMatrix<T,0,I_>, IncompleteLUT<T,I_> >              bicgstab_colmajor_ilut;
+  BiCGSTAB<SparseMatrix<T,0,I_>, DiagonalPreconditioner<T> >     bicgstab_colmajor_diag_fused;
   //BiCGSTAB<SparseMatrix<T>, SSORPreconditioner<T> >     bicgstab_colmajor_ssor;
 
   bicgstab_colmajor_diag.setTolerance(NumTraits<T>::epsilon()*4);
   bicgstab_colmajor_ilut.setTolerance(NumTraits<T>::epsilon()*4);
+  bicgstab_colmajor_diag_fused.setTolerance(NumTraits<T>::epsilon()*4);
+  bicgstab_colmajor_diag_fused.setFusedIterations(true);
   
   CALL_SUBTEST( check_sparse_square_solving(bicgstab_colmajor_diag)  );
 //   CALL_SUBTEST( check_sparse_square_solving(bicgstab_colmajor_I)     );
   CALL_SUBTEST( check_sparse_square_solving(bicgstab_colmajor_ilut)     );
+  CALL_SUBTEST( check_sparse_square_solving(bicgstab_colmajor_diag_fused) );
   //CALL_SUBTEST( check_sparse_square_solving(bicgstab_colmajor_ssor)     );
 }
 
+// The fused iterations split their vector operations into blocks once the problem is large enough,
+// and must converge to the same solution as the default iterations.
+template<typename T> void test_bicgstab_fused_large()
+{
+  typedef SparseMatrix<T> SparseMatrixType;
+  typedef Matrix<T,Dynamic,1> VectorType;
+
+  // 2D convection-diffusion operator, several times longer than the threshold of the fused kernels
+  const Index g = internal::random<Index>(520, 600);
+  const Index n = g*g;
+  std::vector<Triplet<T> > triplets;
+  for(Index i = 0; i < g; ++i)
+    for(Index j = 0; j < g; ++j)
+    {
+      Index k = i*g+j;
+      triplets.push_back(Triplet<T>(k, k, T(4.5)));
+      if(i>0)   triplets.push_back(Triplet<T>(k, k-g, T(-1)));
+      if(i<g-1) triplets.push_back(Triplet<T>(k, k+g, T(-1)));
+      if(j>0)   triplets.push_back(Triplet<T>(k, k-1, T(-1.5)));
+      if(j<g-1) triplets.push_back(Triplet<T>(k, k+1, T(-0.5)));
+    }
+  SparseMatrixType A(n, n);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  VectorType b = VectorType::Random(n);
+
+  BiCGSTAB<SparseMatrixType> bicg;
+  bicg.setTolerance(typename NumTraits<T>::Real(1e-10));
+  bicg.compute(A);
+  VectorType x_ref = bicg.solve(b);
+  VERIFY_IS_EQUAL(bicg.info(), Success);
+  bicg.setFusedIterations(true);
+  VectorType x = bicg.solve(b);
+  VERIFY_IS_EQUAL(bicg.info(), Success);
+  VERIFY_IS_APPROX(x, x_ref);
+  VERIFY_IS_APPROX(A * x, b);
+}
+
 EIGEN_DECLARE_TEST(bicgstab)
 {
   CALL_SUBTEST_1((test_bicgstab_T<double,int>()) );
   CALL_SUBTEST_2((test_bicgstab_T<std::complex<double>, int>()));
   CALL_SUBTEST_3((test_bicgstab_T<double,long int>()));
+  CALL_SUBTEST_4((test_bicgstab_fused_large<double>()));
 }
@@ -406,6 +406,52 @@ template<typename MatrixType> void cholesky_definiteness(const MatrixType& m)
   }
 }
 
+// The blocked LDLT must pick the same pivots as the unblocked one and agree with it on the factors.
+template<typename MatrixType, int UpLo> void cholesky_ldlt_blocked(Index size)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  typedef Transpositions<Dynamic> TranspositionType;
+
+  // Positive definite, indefinite, and indefinite with exactly zero trailing diagonal entries.
+  MatrixType a = MatrixType::Random(size,size);
+  std::vector<MatrixType> symms;
+  symms.push_back(a * a.adjoint() + MatrixType::Identity(size,size));
+  symms.push_back(a + a.adjoint());
+  symms.push_back(a + a.adjoint());
+  symms.back().diagonal().tail(size/3).setZero();
+
+  for(size_t t = 0; t < symms.size(); ++t)
+  {
+    MatrixType unblocked = symms[t], blocked = symms[t];
+    TranspositionType tr_unblocked(size), tr_blocked(size);
+    VectorType tmp(size);
+    internal::SignMatrix sign_unblocked = internal::ZeroSign, sign_blocked = internal::ZeroSign;
+    bool ok_unblocked = internal::ldlt_inplace<UpLo>::unblocked(unblocked, tr_unblocked, tmp, sign_unblocked);
+    bool ok_blocked = internal::ldlt_inplace<UpLo>::blocked(blocked, tr_blocked, tmp, sign_blocked);
+
+    VERIFY_IS_EQUAL(ok_blocked, ok_unblocked);
+    VERIFY(sign_blocked == sign_unblocked);
+    VERIFY(tr_blocked.indices() == tr_unblocked.indices());
+    // Without pivoting on the updated diagonal the indefinite factors can exhibit a large
+    // growth, so only the positive definite factors are compared coefficient-wise.
+    if(t>0)
+      continue;
+    if(UpLo==Lower)
+      VERIFY_IS_APPROX(MatrixType(blocked.template triangularView<Lower>()), MatrixType(unblocked.template triangularView<Lower>()));
+    else
+      VERIFY_IS_APPROX(MatrixType(blocked.template triangularView<Upper>()), MatrixType(unblocked.template triangularView<Upper>()));
+  }
+
+  const MatrixType& spd = symms[0];
+  LDLT<MatrixType,UpLo> ldlt(spd);
+  VERIFY(ldlt.info()==Success);
+  VERIFY(ldlt.isPositive());
+  VERIFY_IS_APPROX(spd, ldlt.reconstructedMatrix());
+  VectorType rhs = VectorType::Random(size);
+  VERIFY_IS_APPROX(spd * ldlt.solve(rhs), rhs);
+}
+
 template<typename>
 void cholesky_faillure_cases()
 {
@@ -528,5 +574,10 @@ EIGEN_DECLARE_TEST(cholesky)
 
   CALL_SUBTEST_2( cholesky_faillure_cases<void>() );
 
+  CALL_SUBTEST_10(( cholesky_ldlt_blocked<MatrixXd,Lower>(internal::random<int>(300,600)) ));
+  CALL_SUBTEST_10(( cholesky_ldlt_blocked<MatrixXd,Upper>(internal::random<int>(32,300)) ));
+  CALL_SUBTEST_11(( cholesky_ldlt_blocked<MatrixXcf,Lower>(internal::random<int>(32,300)) ));
+  CALL_SUBTEST_11(( cholesky_ldlt_blocked<MatrixXcf,Upper>(internal::random<int>(300,400)) ));
+
   TEST_SET_BUT_UNUSED_VARIABLE(nb_temporaries)
 }
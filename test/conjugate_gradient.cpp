@@ -18,12 +18,77 @@ template<typename T, typename I_> void test_conjugate_gradient_T()
   ConjugateGradient<SparseMatrixType, Lower|Upper> cg_colmajor_loup_diag;
   ConjugateGradient<SparseMatrixType, Lower, IdentityPreconditioner> cg_colmajor_lower_I;
   ConjugateGradient<SparseMatrixType, Upper, IdentityPreconditioner> cg_colmajor_upper_I;
+  ConjugateGradient<SparseMatrixType, Lower|Upper> cg_colmajor_loup_diag_fused;
+  ConjugateGradient<SparseMatrixType, Lower, IdentityPreconditioner> cg_colmajor_lower_I_fused;
+  cg_colmajor_loup_diag_fused.setFusedIterations(true);
+  cg_colmajor_lower_I_fused.setFusedIterations(true);
 
   CALL_SUBTEST( check_sparse_spd_solving(cg_colmajor_lower_diag)  );
   CALL_SUBTEST( check_sparse_spd_solving(cg_colmajor_upper_diag)  );
   CALL_SUBTEST( check_sparse_spd_solving(cg_colmajor_loup_diag)   );
   CALL_SUBTEST( check_sparse_spd_solving(cg_colmajor_lower_I)     );
   CALL_SUBTEST( check_sparse_spd_solving(cg_colmajor_upper_I)     );
+  CALL_SUBTEST( check_sparse_spd_solving(cg_colmajor_loup_diag_fused) );
+  CALL_SUBTEST( check_sparse_spd_solving(cg_colmajor_lower_I_fused)   );
+}
+
+// The fused iterations split their vector operations into blocks once the problem is large enough,
+// and must converge to the same solution as the default iterations.
+template<typename T> void test_conjugate_gradient_fused_large()
+{
+  typedef SparseMatrix<T> SparseMatrixType;
+  typedef Matrix<T,Dynamic,1> VectorType;
+
+  // 2D Laplacian
+  const Index g = internal::random<Index>(260, 300);
+  const Index n = g*g;
+  std::vector<Triplet<T> > triplets;
+  for(Index i = 0; i < g; ++i)
+    for(Index j = 0; j < g; ++j)
+    {
+      Index k = i*g+j;
+      triplets.push_back(Triplet<T>(k, k, T(4.5)));
+      if(i>0)   triplets.push_back(Triplet<T>(k, k-g, T(-1)));
+      if(i<g-1) triplets.push_back(Triplet<T>(k, k+g, T(-1)));
+      if(j>0)   triplets.push_back(Triplet<T>(k, k-1, T(-1)));
+      if(j<g-1) triplets.push_back(Triplet<T>(k, k+1, T(-1)));
+    }
+  SparseMatrixType A(n, n);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  VectorType b = VectorType::Random(n);
+
+  ConjugateGradient<SparseMatrixType, Lower|Upper> cg;
+  cg.setTolerance(typename NumTraits<T>::Real(1e-10));
+  cg.compute(A);
+  VectorType x_ref = cg.solve(b);
+  VERIFY_IS_EQUAL(cg.info(), Success);
+  cg.setFusedIterations(true);
+  VectorType x = cg.solve(b);
+  VERIFY_IS_EQUAL(cg.info(), Success);
+  VERIFY_IS_APPROX(x, x_ref);
+
+  // 1D problem several times longer than the threshold of the fused kernels, with a single triangular half stored
+  const Index m = internal::random<Index>(4*65536, 5*65536);
+  triplets.clear();
+  for(Index k = 0; k < m; ++k)
+  {
+    triplets.push_back(Triplet<T>(k, k, T(2.5)));
+    if(k>0) triplets.push_back(Triplet<T>(k, k-1, T(-1)));
+  }
+  SparseMatrixType L(m, m);
+  L.setFromTriplets(triplets.begin(), triplets.end());
+  VectorType c = VectorType::Random(m);
+
+  ConjugateGradient<SparseMatrixType, Lower, IdentityPreconditioner> cg_lower;
+  cg_lower.setTolerance(typename NumTraits<T>::Real(1e-10));
+  cg_lower.compute(L);
+  VectorType y_ref = cg_lower.solve(c);
+  VERIFY_IS_EQUAL(cg_lower.info(), Success);
+  cg_lower.setFusedIterations(true);
+  VectorType y = cg_lower.solve(c);
+  VERIFY_IS_EQUAL(cg_lower.info(), Success);
+  VERIFY_IS_APPROX(y, y_ref);
+  VERIFY_IS_APPROX(L.template selfadjointView<Lower>() * y, c);
 }
 
 EIGEN_DECLARE_TEST(conjugate_gradient)
@@ -31,4 +96,5 @@ EIGEN_DECLARE_TEST(conjugate_gradient)
   CALL_SUBTEST_1(( test_conjugate_gradient_T<double,int>() ));
   CALL_SUBTEST_2(( test_conjugate_gradient_T<std::complex<double>, int>() ));
   CALL_SUBTEST_3(( test_conjugate_gradient_T<double,long int>() ));
+  CALL_SUBTEST_4(( test_conjugate_gradient_fused_large<double>() ));
 }
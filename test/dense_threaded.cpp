@@ -0,0 +1,217 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_GEMM_THREADPOOL
+#include "main.h"
+
+// Coefficient-wise assignments split between the threads compute each coefficient
+// with the same kernel as the sequential ones, so the results must be identical.
+template<typename MatrixType>
+void test_parallel_assign(int num_threads)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  typedef Array<Scalar,Dynamic,Dynamic,MatrixType::Options> ArrayType;
+
+  const Index rows = internal::random<Index>(500, 900);
+  const Index cols = internal::random<Index>(500, 900);
+  MatrixType a = MatrixType::Random(rows, cols);
+  MatrixType b = MatrixType::Random(rows, cols);
+  VectorType x = VectorType::Random(rows*cols);
+  VectorType y = VectorType::Random(rows*cols);
+  const Scalar alpha = internal::random<Scalar>();
+
+  // References computed without any thread pool.
+  setGemmThreadPool(nullptr);
+  MatrixType ref_cwise = (a.array() * b.array()).exp().matrix() + alpha * a;
+  VectorType ref_axpy = x + alpha * y;
+  VectorType ref_axpy_back = ref_axpy - alpha * y;
+  MatrixType ref_block = a.block(1, 3, rows-5, cols-4) - b.block(2, 1, rows-5, cols-4);
+  MatrixType ref_transposed = a.transpose() + b.transpose();
+  MatrixType ref_unary = a.unaryExpr([](const Scalar& v) { return v * v + Scalar(1); });
+  MatrixType ref_product = a.topLeftCorner(64, 64) * b.topLeftCorner(64, 64);
+
+  ThreadPool pool(num_threads);
+  setGemmThreadPool(&pool);
+
+  // linear vectorized traversal
+  MatrixType c;
+  c.parallel() = (a.array() * b.array()).exp().matrix() + alpha * a;
+  VERIFY_IS_EQUAL(c, ref_cwise);
+  ArrayType ca;
+  ca.parallel() = (a.array() * b.array()).exp() + alpha * a.array();
+  VERIFY_IS_EQUAL(ca.matrix(), ref_cwise);
+
+  VectorType z = x;
+  z.parallel() += alpha * y;
+  VERIFY_IS_EQUAL(z, ref_axpy);
+  z.parallel() -= alpha * y;
+  VERIFY_IS_EQUAL(z, ref_axpy_back);
+
+  // unaligned start, and automatic transposition of the destination
+  const Index offset = internal::random<Index>(1, 3);
+  VectorType w = VectorType::Zero(rows*cols + offset);
+  w.segment(offset, rows*cols).parallel() = x + alpha * y;
+  VERIFY_IS_EQUAL(VectorType(w.segment(offset, rows*cols)), ref_axpy);
+  Matrix<Scalar,1,Dynamic> wt;
+  wt.parallel() = x + alpha * y;
+  VERIFY_IS_EQUAL(VectorType(wt.transpose()), ref_axpy);
+
+  // slice vectorized traversal
+  MatrixType d = MatrixType::Zero(rows+3, cols+2);
+  d.block(2, 1, rows-5, cols-4).parallel() = a.block(1, 3, rows-5, cols-4) - b.block(2, 1, rows-5, cols-4);
+  VERIFY_IS_EQUAL(MatrixType(d.block(2, 1, rows-5, cols-4)), ref_block);
+  VERIFY_IS_EQUAL(d.row(0).squaredNorm(), RealScalar(0));
+  VERIFY_IS_EQUAL(d.col(cols+1).squaredNorm(), RealScalar(0));
+
+  // mixed storage orders and non vectorizable expressions
+  c.parallel() = a.transpose() + b.transpose();
+  VERIFY_IS_EQUAL(c, ref_transposed);
+  c.parallel() = a.unaryExpr([](const Scalar& v) { return v * v + Scalar(1); });
+  VERIFY_IS_EQUAL(c, ref_unary);
+
+  // products are evaluated as by a regular assignment
+  c.parallel() = a.topLeftCorner(64, 64) * b.topLeftCorner(64, 64);
+  VERIFY_IS_APPROX(c, ref_product);
+
+  // small assignments stay on the calling thread
+  Matrix<Scalar,4,4> s = Matrix<Scalar,4,4>::Zero();
+  s.parallel() += a.template topLeftCorner<4,4>();
+  VERIFY_IS_EQUAL(s, MatrixType(a.topLeftCorner(4,4)));
+
+  // counter-based random numbers can be generated concurrently
+  c.parallel() = MatrixType::CounterRandom(rows, cols, 42);
+  VERIFY_IS_EQUAL(c, MatrixType(MatrixType::CounterRandom(rows, cols, 42)));
+
+  // assignments issued from a pool thread run sequentially
+  MatrixType c_inner;
+  Barrier done(1);
+  pool.Schedule([&]() { c_inner.parallel() = (a.array() * b.array()).exp().matrix() + alpha * a; done.Notify(); });
+  done.Wait();
+  VERIFY_IS_EQUAL(c_inner, ref_cwise);
+
+  setGemmThreadPool(nullptr);
+}
+
+// Large reductions written with parallel() are computed by blocks of fixed size combined
+// in a fixed order, so the results must not depend on the number of threads.
+template<typename MatrixType>
+void test_parallel_redux(int num_threads)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  typedef Matrix<RealScalar,Dynamic,Dynamic,MatrixType::Options> RealMatrixType;
+  typedef Matrix<RealScalar,Dynamic,1> RealVectorType;
+
+  const Index rows = internal::random<Index>(300, 600);
+  const Index cols = internal::random<Index>(300, 600);
+  MatrixType a = (MatrixType::Random(rows, cols).array() + Scalar(2)).matrix();
+  MatrixType tall = (MatrixType::Random(internal::random<Index>(33000, 40000), 3).array() + Scalar(2)).matrix();
+  VectorType x = a.reshaped();
+
+  // min and max planted twice, the first occurrence being the expected one
+  RealMatrixType r = a.real();
+  const Index i0 = internal::random<Index>(0, rows/2-1), j0 = internal::random<Index>(0, cols/2-1);
+  const Index i1 = internal::random<Index>(rows/2, rows-1), j1 = internal::random<Index>(cols/2, cols-1);
+  r(i0, j0) = r(i1, j1) = RealScalar(-5);
+  r(i1, j0) = r(i0, j1) = RealScalar(5);
+  RealVectorType rv = r.reshaped();
+  Index min_i = 0, min_j = 0, max_i = 0, max_j = 0, min_k = 0, max_k = 0;
+
+  auto reductions = [&]() {
+    std::vector<Scalar> res;
+    res.push_back(a.parallel().sum());
+    res.push_back(x.parallel().sum());
+    res.push_back(a.block(1, 1, rows-2, cols-1).parallel().sum());
+    res.push_back(tall.block(1, 0, tall.rows()-2, 3).parallel().sum());
+    res.push_back(a.parallel().redux([](const Scalar& u, const Scalar& v) { return u + v; }));
+    res.push_back(a.parallel().squaredNorm());
+    res.push_back(x.parallel().dot(x.reverse()));
+    res.push_back(a.parallel().stableNorm());
+    res.push_back(x.parallel().stableNorm());
+    res.push_back(a.parallel().blueNorm());
+    res.push_back(x.parallel().blueNorm());
+    res.push_back(r.parallel().minCoeff(&min_i, &min_j));
+    res.push_back(r.parallel().maxCoeff(&max_i, &max_j));
+    res.push_back(rv.parallel().minCoeff(&min_k));
+    res.push_back(rv.parallel().maxCoeff(&max_k));
+    res.push_back(Scalar(rv.parallel().maxCoeff()));
+    res.push_back(Scalar(min_i + rows*min_j));
+    res.push_back(Scalar(max_i + rows*max_j));
+    res.push_back(Scalar(min_k));
+    res.push_back(Scalar(max_k));
+    return res;
+  };
+
+  setGemmThreadPool(nullptr);
+  const std::vector<Scalar> ref = reductions();
+  VERIFY_IS_APPROX(ref[0], a.sum());
+  VERIFY_IS_APPROX(ref[1], ref[0]);
+  VERIFY_IS_APPROX(ref[3], tall.block(1, 0, tall.rows()-2, 3).colwise().sum().sum());
+  VERIFY_IS_APPROX(ref[4], ref[0]);
+  VERIFY_IS_APPROX(ref[5], Scalar(a.squaredNorm()));
+  VERIFY_IS_APPROX(ref[6], x.dot(x.reverse()));
+  VERIFY_IS_APPROX(ref[7], Scalar(a.stableNorm()));
+  VERIFY_IS_APPROX(ref[8], ref[7]);
+  VERIFY_IS_APPROX(ref[9], ref[7]);
+  VERIFY_IS_APPROX(ref[10], ref[7]);
+  VERIFY_IS_EQUAL(ref[11], Scalar(-5));
+  VERIFY_IS_EQUAL(ref[12], Scalar(5));
+  VERIFY_IS_EQUAL(ref[15], Scalar(5));
+  VERIFY_IS_EQUAL(min_i, i0); VERIFY_IS_EQUAL(min_j, j0);
+  VERIFY_IS_EQUAL(max_i, MatrixType::IsRowMajor ? i0 : i1);
+  VERIFY_IS_EQUAL(max_j, MatrixType::IsRowMajor ? j1 : j0);
+  VERIFY_IS_EQUAL(min_k, i0 + rows*j0);
+  VERIFY_IS_EQUAL(max_k, numext::mini(i1 + rows*j0, i0 + rows*j1));
+
+  ThreadPool pool(num_threads);
+  setGemmThreadPool(&pool);
+  const std::vector<Scalar> res = reductions();
+  VERIFY_IS_EQUAL(Map<const VectorType>(res.data(), res.size()), Map<const VectorType>(ref.data(), ref.size()));
+
+  // NaN propagation
+  r(i1, j1) = rv(i1 + rows*j1) = NumTraits<RealScalar>::quiet_NaN();
+  VERIFY((numext::isnan)(r.parallel().template minCoeff<PropagateNaN>(&min_i, &min_j)));
+  VERIFY_IS_EQUAL(min_i, i1); VERIFY_IS_EQUAL(min_j, j1);
+  VERIFY_IS_EQUAL(r.parallel().template minCoeff<PropagateNumbers>(&min_i, &min_j), RealScalar(-5));
+  VERIFY_IS_EQUAL(min_i, i0); VERIFY_IS_EQUAL(min_j, j0);
+  VERIFY((numext::isnan)(rv.parallel().template maxCoeff<PropagateNaN>(&max_k)));
+  VERIFY_IS_EQUAL(max_k, i1 + rows*j1);
+  VERIFY((numext::isnan)(r.parallel().sum()));
+  VERIFY((numext::isnan)(r.parallel().stableNorm()));
+  VERIFY((numext::isnan)(rv.parallel().blueNorm()));
+
+  // Random() is not safe to evaluate from several threads, and is reduced sequentially as without parallel()
+  const unsigned int seed = internal::random<unsigned int>();
+  std::srand(seed);
+  const Scalar random_sum = MatrixType::Random(rows, cols).sum();
+  const RealScalar random_norm = RealMatrixType::Random(rows, cols).stableNorm();
+  const RealScalar random_min = RealVectorType::Random(rows*cols).minCoeff(&min_k);
+  std::srand(seed);
+  VERIFY_IS_EQUAL(MatrixType::Random(rows, cols).parallel().sum(), random_sum);
+  VERIFY_IS_EQUAL(RealMatrixType::Random(rows, cols).parallel().stableNorm(), random_norm);
+  VERIFY_IS_EQUAL(RealVectorType::Random(rows*cols).parallel().minCoeff(&max_k), random_min);
+  VERIFY_IS_EQUAL(max_k, min_k);
+
+  setGemmThreadPool(nullptr);
+}
+
+EIGEN_DECLARE_TEST(dense_threaded)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( test_parallel_assign<MatrixXf>(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_2(( test_parallel_assign<MatrixXd>(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_3(( test_parallel_assign<Matrix<double,Dynamic,Dynamic,RowMajor> >(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_4(( test_parallel_assign<MatrixXcf>(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_1(( test_parallel_redux<MatrixXf>(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_2(( test_parallel_redux<MatrixXd>(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_3(( test_parallel_redux<Matrix<double,Dynamic,Dynamic,RowMajor> >(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_4(( test_parallel_redux<MatrixXcf>(internal::random<int>(2, 8)) ));
+  }
+}
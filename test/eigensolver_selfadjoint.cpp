@@ -190,6 +190,67 @@ template<typename MatrixType> void selfadjointeigensolver(const MatrixType& m)
   }
 }
 
+// The blocked tridiagonalization must produce the same reflectors as the unblocked one.
+template<typename MatrixType> void tridiagonalization_blocked(Index size)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+
+  MatrixType a = MatrixType::Random(size,size);
+  MatrixType symmA = a + a.adjoint();
+  symmA.template triangularView<StrictlyUpper>().setZero();
+
+  MatrixType unblocked = symmA, blocked = symmA;
+  VectorType h_unblocked(size-1), h_blocked(size-1);
+  internal::tridiagonalization_inplace_unblocked(unblocked, h_unblocked);
+  internal::tridiagonalization_inplace_blocked(blocked, h_blocked, internal::random<Index>(1,48));
+  VERIFY_IS_APPROX(MatrixType(blocked.template triangularView<Lower>()), MatrixType(unblocked.template triangularView<Lower>()));
+  VERIFY_IS_APPROX(h_blocked, h_unblocked);
+
+  Tridiagonalization<MatrixType> tri(symmA);
+  MatrixType q = tri.matrixQ();
+  VERIFY_IS_UNITARY(q);
+  VERIFY_IS_APPROX(MatrixType(symmA.template selfadjointView<Lower>()), q * MatrixType(tri.matrixT()) * q.adjoint());
+}
+
+template<typename MatrixType> void selfadjointeigensolver_divide_and_conquer(Index size)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<RealScalar,Dynamic,1> RealVectorType;
+
+  // A random matrix, and matrices with clustered and multiple eigenvalues, which exercise the deflation.
+  MatrixType a = MatrixType::Random(size,size);
+  MatrixType u = MatrixType::Random(size,3);
+  std::vector<MatrixType> symms;
+  symms.push_back(a + a.adjoint());
+  symms.push_back(MatrixType::Identity(size,size) + u * u.adjoint());
+  symms.push_back(MatrixType::Identity(size,size) + RealScalar(1e3) * NumTraits<RealScalar>::epsilon() * (a + a.adjoint()));
+
+  for(size_t t = 0; t < symms.size(); ++t)
+  {
+    const MatrixType& symm = symms[t];
+    SelfAdjointEigenSolver<MatrixType> eiQR(symm);
+    SelfAdjointEigenSolver<MatrixType> eiDC(symm, ComputeEigenvectors|DivideAndConquer);
+    VERIFY_IS_EQUAL(eiDC.info(), Success);
+    VERIFY_IS_APPROX(eiDC.eigenvalues(), eiQR.eigenvalues());
+    VERIFY_IS_UNITARY(eiDC.eigenvectors());
+    VERIFY_IS_APPROX(symm * eiDC.eigenvectors(), eiDC.eigenvectors() * eiDC.eigenvalues().asDiagonal());
+  }
+
+  // the 1-2-1 tridiagonal matrix has the known eigenvalues 2-2cos(k pi/(n+1))
+  RealVectorType diag = RealVectorType::Constant(size, RealScalar(2));
+  RealVectorType subdiag = RealVectorType::Constant(size-1, RealScalar(-1));
+  SelfAdjointEigenSolver<MatrixType> eiTri;
+  eiTri.computeFromTridiagonal(diag, subdiag, ComputeEigenvectors|DivideAndConquer);
+  VERIFY_IS_EQUAL(eiTri.info(), Success);
+  RealVectorType expected(size);
+  for(Index k = 0; k < size; ++k)
+    expected(k) = RealScalar(2) - RealScalar(2) * numext::cos(RealScalar(k+1) * RealScalar(EIGEN_PI) / RealScalar(size+1));
+  VERIFY_IS_APPROX(eiTri.eigenvalues(), expected);
+  VERIFY_IS_UNITARY(eiTri.eigenvectors());
+}
+
 template<int>
 void bug_854()
 {
@@ -266,6 +327,13 @@ EIGEN_DECLARE_TEST(eigensolver_selfadjoint)
     CALL_SUBTEST_7( selfadjointeigensolver(Matrix<double,2,2>()) );
   }
   
+  CALL_SUBTEST_14( tridiagonalization_blocked<MatrixXd>(internal::random<int>(129,400)) );
+  CALL_SUBTEST_14( tridiagonalization_blocked<MatrixXcf>(internal::random<int>(129,300)) );
+
+  CALL_SUBTEST_15( selfadjointeigensolver_divide_and_conquer<MatrixXd>(internal::random<int>(26,300)) );
+  CALL_SUBTEST_15( selfadjointeigensolver_divide_and_conquer<MatrixXcd>(internal::random<int>(26,200)) );
+  CALL_SUBTEST_15( selfadjointeigensolver_divide_and_conquer<MatrixXf>(internal::random<int>(26,200)) );
+
   CALL_SUBTEST_13( bug_854<0>() );
   CALL_SUBTEST_13( bug_1014<0>() );
   CALL_SUBTEST_13( bug_1204<0>() );
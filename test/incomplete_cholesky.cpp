@@ -28,6 +28,43 @@ template<typename T, typename I_> void test_incomplete_cholesky_T()
   CALL_SUBTEST( check_sparse_spd_solving(cg_illt_uplo_amd) );
 }
 
+// The level-scheduled substitutions used by the incomplete factorizations must match the plain triangular solves.
+template<typename Scalar> void test_triangular_levels()
+{
+  typedef SparseMatrix<Scalar,RowMajor> RowMajorMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+
+  // random triangular matrix with few dependencies per row, hence a few wide levels
+  const Index n = internal::random<Index>(5000, 20000);
+  std::vector<Triplet<Scalar> > triplets;
+  for(Index i = 0; i < n; ++i)
+  {
+    triplets.push_back(Triplet<Scalar>(i, i, Scalar(4) + internal::random<Scalar>()));
+    for(int k = 0; k < 3 && i > 0; ++k)
+    {
+      triplets.push_back(Triplet<Scalar>(i, internal::random<Index>(0, i-1), internal::random<Scalar>()));
+      triplets.push_back(Triplet<Scalar>(n-1-i, internal::random<Index>(n-i, n-1), internal::random<Scalar>()));
+    }
+  }
+  RowMajorMatrix T(n, n);
+  T.setFromTriplets(triplets.begin(), triplets.end());
+  DenseMatrix b = DenseMatrix::Random(n, 2);
+
+  internal::sparse_triangular_levels<int> lower, upper;
+  lower.template analyze<Lower>(T);
+  upper.template analyze<Upper>(T);
+  VERIFY(lower.levels() < n/4);
+  DenseMatrix x = b;
+  lower.template solveInPlace<Lower>(T, x);
+  VERIFY_IS_APPROX(x, T.template triangularView<Lower>().solve(b));
+  x = b;
+  lower.template solveInPlace<UnitLower>(T, x);
+  VERIFY_IS_APPROX(x, T.template triangularView<UnitLower>().solve(b));
+  x = b;
+  upper.template solveInPlace<Upper>(T, x);
+  VERIFY_IS_APPROX(x, T.template triangularView<Upper>().solve(b));
+}
+
 template<int>
 void bug1150()
 {
@@ -65,4 +102,6 @@ EIGEN_DECLARE_TEST(incomplete_cholesky)
   CALL_SUBTEST_3(( test_incomplete_cholesky_T<double,long int>() ));
 
   CALL_SUBTEST_1(( bug1150<0>() ));
+  CALL_SUBTEST_4(( test_triangular_levels<double>() ));
+  CALL_SUBTEST_5(( test_triangular_levels<std::complex<double> >() ));
 }
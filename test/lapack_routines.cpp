@@ -0,0 +1,253 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+#include <Eigen/QR>
+#include <Eigen/Eigenvalues>
+
+// Routines of Eigen's LAPACK library, which take the complex arrays as arrays of doubles.
+extern "C" {
+#define EIGEN_LAPACK_TEST_DECLARE(S, GQR, MQR)                                                          \
+  int S##geqrf_(int*, int*, double*, int*, double*, double*, int*, int*);                               \
+  int S##GQR##_(int*, int*, int*, double*, int*, double*, double*, int*, int*);                         \
+  int S##MQR##_(char*, char*, int*, int*, int*, double*, int*, double*, double*, int*, double*, int*, int*); \
+  int S##gels_(char*, int*, int*, int*, double*, int*, double*, int*, double*, int*, int*);              \
+  int S##gesv_(int*, int*, double*, int*, int*, double*, int*, int*);                                   \
+  int S##posv_(char*, int*, int*, double*, int*, double*, int*, int*);                                  \
+  int S##getrf_(int*, int*, double*, int*, int*, int*);                                                 \
+  int S##getri_(int*, double*, int*, int*, double*, int*, int*);
+EIGEN_LAPACK_TEST_DECLARE(d, orgqr, ormqr)
+EIGEN_LAPACK_TEST_DECLARE(z, ungqr, unmqr)
+#undef EIGEN_LAPACK_TEST_DECLARE
+int dsyevd_(char*, char*, int*, double*, int*, double*, double*, int*, int*, int*, int*);
+}
+
+struct lapack_routines
+{
+  decltype(&dgeqrf_) geqrf;
+  decltype(&dorgqr_) gqr;
+  decltype(&dormqr_) mqr;
+  decltype(&dgels_)  gels;
+  decltype(&dgesv_)  gesv;
+  decltype(&dposv_)  posv;
+  decltype(&dgetrf_) getrf;
+  decltype(&dgetri_) getri;
+};
+
+template<typename Scalar> lapack_routines routines();
+template<> lapack_routines routines<double>()
+{
+  lapack_routines r = {&dgeqrf_, &dorgqr_, &dormqr_, &dgels_, &dgesv_, &dposv_, &dgetrf_, &dgetri_};
+  return r;
+}
+template<> lapack_routines routines<std::complex<double> >()
+{
+  lapack_routines r = {&zgeqrf_, &zungqr_, &zunmqr_, &zgels_, &zgesv_, &zposv_, &zgetrf_, &zgetri_};
+  return r;
+}
+
+template<typename Derived>
+double* lapack_data(DenseBase<Derived>& m)
+{
+  return reinterpret_cast<double*>(m.derived().data());
+}
+
+template<typename Scalar> char adjoint_op() { return NumTraits<Scalar>::IsComplex ? 'C' : 'T'; }
+
+template<typename Scalar> void lapack_qr(int m, int n)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> Mat;
+  typedef Matrix<Scalar,Dynamic,1> Vec;
+  const lapack_routines lapack = routines<Scalar>();
+  int k = (std::min)(m,n), lda = m, info = -1, lwork = -1;
+  Mat A = Mat::Random(m,n), QR = A;
+  Vec tau(k), work(1);
+
+  lapack.geqrf(&m, &n, lapack_data(QR), &lda, lapack_data(tau), lapack_data(work), &lwork, &info);
+  VERIFY_IS_EQUAL(info, 0);
+  lwork = int(numext::real(work(0)));
+  work.resize(lwork);
+  lapack.geqrf(&m, &n, lapack_data(QR), &lda, lapack_data(tau), lapack_data(work), &lwork, &info);
+  VERIFY_IS_EQUAL(info, 0);
+
+  // The reflectors are the ones of HouseholderQR, whose coefficients are the conjugates of LAPACK's
+  HouseholderQR<Mat> hqr(A);
+  VERIFY_IS_APPROX(QR, hqr.matrixQR());
+  VERIFY_IS_APPROX(tau, hqr.hCoeffs().conjugate());
+
+  // Q*R = A with the thin Q given by orgqr/ungqr
+  Mat Q = QR.leftCols(k);
+  lwork = int(work.size());
+  lapack.gqr(&m, &k, &k, lapack_data(Q), &lda, lapack_data(tau), lapack_data(work), &lwork, &info);
+  VERIFY_IS_EQUAL(info, 0);
+  Mat R = QR.topRows(k).template triangularView<Upper>();
+  VERIFY_IS_APPROX(Q*R, A);
+  VERIFY_IS_APPROX(Q.adjoint()*Q, Mat::Identity(k,k));
+
+  // ormqr/unmqr apply the same Q
+  int p = internal::random<int>(1,10);
+  char left = 'L', right = 'R', notr = 'N', adj = adjoint_op<Scalar>();
+  Mat C = Mat::Random(m,p), QC = C, QhC = C, D = Mat::Random(p,m), DQ = D;
+  work.resize((std::max)(m,p));
+  lwork = int(work.size());
+  lapack.mqr(&left, &notr, &m, &p, &k, lapack_data(QR), &lda, lapack_data(tau), lapack_data(QC), &m, lapack_data(work), &lwork, &info);
+  VERIFY_IS_EQUAL(info, 0);
+  lapack.mqr(&left, &adj, &m, &p, &k, lapack_data(QR), &lda, lapack_data(tau), lapack_data(QhC), &m, lapack_data(work), &lwork, &info);
+  VERIFY_IS_EQUAL(info, 0);
+  lapack.mqr(&right, &notr, &p, &m, &k, lapack_data(QR), &lda, lapack_data(tau), lapack_data(DQ), &p, lapack_data(work), &lwork, &info);
+  VERIFY_IS_EQUAL(info, 0);
+  VERIFY_IS_APPROX(QC, Mat(hqr.householderQ()) * C);
+  VERIFY_IS_APPROX(QhC.topRows(k), Q.adjoint() * C);
+  VERIFY_IS_APPROX(DQ.leftCols(k), D * Q);
+}
+
+// A reflector built as the reference xLARFG does, rather than by geqrf: H^H (alpha, x) = (beta, 0) with
+// H = I - tau (1, v) (1, v)^H, beta = -sign(real(alpha)) |(alpha, x)|, tau = (beta-alpha)/beta and v = x/(alpha-beta).
+template<typename Scalar> void lapack_mqr_reference_reflector(int m)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> Mat;
+  typedef Matrix<Scalar,Dynamic,1> Vec;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  const lapack_routines lapack = routines<Scalar>();
+  Vec x = Vec::Random(m);
+  const Scalar alpha = x(0);
+  const RealScalar beta = (numext::real(alpha) >= RealScalar(0) ? -1 : 1) * x.norm();
+  Vec tau(1);
+  tau(0) = (beta-alpha)/beta;
+  Mat V(m,1);
+  V(0,0) = Scalar(1);
+  V.col(0).tail(m-1) = x.tail(m-1) / (alpha-beta);
+
+  int one = 1, lwork = 1, info = -1;
+  char left = 'L', adj = adjoint_op<Scalar>();
+  Vec work(1), y = x;
+  lapack.mqr(&left, &adj, &m, &one, &one, lapack_data(V), &m, lapack_data(tau), lapack_data(y), &m, lapack_data(work), &lwork, &info);
+  VERIFY_IS_EQUAL(info, 0);
+  VERIFY_IS_APPROX(y(0), Scalar(beta));
+  VERIFY(y.tail(m-1).isMuchSmallerThan(x.norm()));
+}
+
+template<typename Scalar> void lapack_gels(int m, int n)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> Mat;
+  typedef Matrix<Scalar,Dynamic,1> Vec;
+  const lapack_routines lapack = routines<Scalar>();
+  int nrhs = internal::random<int>(1,4), mn = (std::min)(m,n), ldb = (std::max)(m,n), info = -1, lwork = -1;
+  char notr = 'N', adj = adjoint_op<Scalar>();
+  Mat A = Mat::Random(m,n);
+  Vec work(1);
+
+  // A X = B: least squares solution if m >= n, minimum norm solution otherwise
+  Mat B = Mat::Zero(ldb,nrhs), A1 = A;
+  B.topRows(m).setRandom();
+  Mat X = m >= n ? Mat(A.householderQr().solve(B.topRows(m)))
+                 : Mat(A.adjoint() * (A*A.adjoint()).ldlt().solve(B.topRows(m)));
+  lapack.gels(&notr, &m, &n, &nrhs, lapack_data(A1), &m, lapack_data(B), &ldb, lapack_data(work), &lwork, &info);
+  VERIFY_IS_EQUAL(info, 0);
+  lwork = int(numext::real(work(0)));
+  VERIFY(lwork >= mn + (std::max)(mn,nrhs));
+  work.resize(lwork);
+  lapack.gels(&notr, &m, &n, &nrhs, lapack_data(A1), &m, lapack_data(B), &ldb, lapack_data(work), &lwork, &info);
+  VERIFY_IS_EQUAL(info, 0);
+  VERIFY_IS_APPROX(B.topRows(n), X);
+
+  // A^H X = B: minimum norm solution if m >= n, least squares solution otherwise
+  Mat A2 = A;
+  B.setZero();
+  B.topRows(n).setRandom();
+  X = m >= n ? Mat(A * (A.adjoint()*A).ldlt().solve(B.topRows(n)))
+             : Mat(A.adjoint().householderQr().solve(B.topRows(n)));
+  lapack.gels(&adj, &m, &n, &nrhs, lapack_data(A2), &m, lapack_data(B), &ldb, lapack_data(work), &lwork, &info);
+  VERIFY_IS_EQUAL(info, 0);
+  VERIFY_IS_APPROX(B.topRows(m), X);
+}
+
+template<typename Scalar> void lapack_square_solvers(int n)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> Mat;
+  typedef Matrix<Scalar,Dynamic,1> Vec;
+  const lapack_routines lapack = routines<Scalar>();
+  int nrhs = internal::random<int>(1,4), info = -1;
+  Matrix<int,Dynamic,1> ipiv(n);
+  Mat A = Mat::Random(n,n) + Scalar(n)*Mat::Identity(n,n), B = Mat::Random(n,nrhs);
+
+  // gesv
+  Mat LU = A, X = B;
+  lapack.gesv(&n, &nrhs, lapack_data(LU), &n, ipiv.data(), lapack_data(X), &n, &info);
+  VERIFY_IS_EQUAL(info, 0);
+  VERIFY_IS_APPROX(A*X, B);
+
+  // getri on the factors of getrf
+  Mat Ainv = A;
+  Vec work(1);
+  int lwork = -1;
+  lapack.getrf(&n, &n, lapack_data(Ainv), &n, ipiv.data(), &info);
+  VERIFY_IS_EQUAL(info, 0);
+  lapack.getri(&n, lapack_data(Ainv), &n, ipiv.data(), lapack_data(work), &lwork, &info);
+  VERIFY_IS_EQUAL(info, 0);
+  lwork = int(numext::real(work(0)));
+  work.resize(lwork);
+  lapack.getri(&n, lapack_data(Ainv), &n, ipiv.data(), lapack_data(work), &lwork, &info);
+  VERIFY_IS_EQUAL(info, 0);
+  VERIFY_IS_APPROX(A*Ainv, Mat::Identity(n,n));
+
+  // posv, from either triangle
+  Mat M = Mat::Random(n,n), S = M*M.adjoint() + Mat::Identity(n,n);
+  char uplos[2] = {'L', 'U'};
+  for(int u = 0; u < 2; ++u)
+  {
+    Mat L = S;
+    X = B;
+    lapack.posv(&uplos[u], &n, &nrhs, lapack_data(L), &n, lapack_data(X), &n, &info);
+    VERIFY_IS_EQUAL(info, 0);
+    VERIFY_IS_APPROX(S*X, B);
+  }
+}
+
+void lapack_syevd(int n)
+{
+  typedef Matrix<double,Dynamic,Dynamic> Mat;
+  typedef Matrix<double,Dynamic,1> Vec;
+  Mat M = Mat::Random(n,n), A = M + M.transpose();
+  Vec w(n), work(1);
+  Matrix<int,Dynamic,1> iwork(1);
+  int lwork = -1, liwork = -1, info = -1;
+  char jobz = 'V', uplo = 'U';
+  Mat V = A;
+  V.triangularView<StrictlyLower>().setZero();
+  dsyevd_(&jobz, &uplo, &n, V.data(), &n, w.data(), work.data(), &lwork, iwork.data(), &liwork, &info);
+  VERIFY_IS_EQUAL(info, 0);
+  lwork = int(work(0));
+  liwork = iwork(0);
+  work.resize(lwork);
+  iwork.resize(liwork);
+  dsyevd_(&jobz, &uplo, &n, V.data(), &n, w.data(), work.data(), &lwork, iwork.data(), &liwork, &info);
+  VERIFY_IS_EQUAL(info, 0);
+  VERIFY_IS_APPROX(w, SelfAdjointEigenSolver<Mat>(A, EigenvaluesOnly).eigenvalues());
+  VERIFY_IS_APPROX(A*V, V*w.asDiagonal());
+  VERIFY_IS_APPROX(V.transpose()*V, Mat::Identity(n,n));
+}
+
+EIGEN_DECLARE_TEST(lapack_routines)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    int m = internal::random<int>(1,EIGEN_TEST_MAX_SIZE/4), n = internal::random<int>(1,m);
+    CALL_SUBTEST_1(( lapack_qr<double>(m, n) ));
+    CALL_SUBTEST_1(( lapack_qr<double>(n, m) ));
+    CALL_SUBTEST_2(( lapack_qr<std::complex<double> >(m, n) ));
+    CALL_SUBTEST_2(( lapack_qr<std::complex<double> >(n, m) ));
+    CALL_SUBTEST_1(( lapack_mqr_reference_reflector<double>(m) ));
+    CALL_SUBTEST_2(( lapack_mqr_reference_reflector<std::complex<double> >(m) ));
+    CALL_SUBTEST_1(( lapack_gels<double>(m, n) ));
+    CALL_SUBTEST_1(( lapack_gels<double>(n, m) ));
+    CALL_SUBTEST_2(( lapack_gels<std::complex<double> >(m, n) ));
+    CALL_SUBTEST_2(( lapack_gels<std::complex<double> >(n, m) ));
+    CALL_SUBTEST_1(( lapack_square_solvers<double>(m) ));
+    CALL_SUBTEST_2(( lapack_square_solvers<std::complex<double> >(m) ));
+    CALL_SUBTEST_1(( lapack_syevd(m) ));
+  }
+}
@@ -0,0 +1,98 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_GEMM_THREADPOOL
+#include "main.h"
+
+template<typename MatrixType>
+void test_parallelize_gemm(int num_threads)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  const Index n = internal::random<Index>(200, 400);
+  const Index m = internal::random<Index>(200, 400);
+  const Index k = internal::random<Index>(1, 300);
+  MatrixType a = MatrixType::Random(n, k);
+  MatrixType b = MatrixType::Random(k, m);
+  MatrixType c(n, m);
+
+  // Reference computed without any thread pool.
+  setGemmThreadPool(nullptr);
+  VERIFY_IS_EQUAL(nbThreads(), 1);
+  MatrixType ref = a * b;
+
+  ThreadPool pool(num_threads);
+  setGemmThreadPool(&pool);
+  VERIFY(getGemmThreadPool() == &pool);
+  VERIFY_IS_EQUAL(nbThreads(), num_threads);
+
+  c.noalias() = a * b;
+  VERIFY_IS_APPROX(c, ref);
+  c.noalias() = a.transpose().transpose() * b;
+  VERIFY_IS_APPROX(c, ref);
+  c.noalias() = Scalar(2) * a * b - ref;
+  VERIFY_IS_APPROX(c, ref);
+
+  // setNbThreads can only lower the number of threads taken from the pool.
+  setNbThreads(2);
+  VERIFY_IS_EQUAL(nbThreads(), (std::min)(2, num_threads));
+  c.noalias() = a * b;
+  VERIFY_IS_APPROX(c, ref);
+  setNbThreads(0);
+
+  // Products issued from a pool thread must run sequentially instead of waiting on the pool.
+  MatrixType c_inner(n, m);
+  Barrier done(1);
+  pool.Schedule([&]() { c_inner.noalias() = a * b; done.Notify(); });
+  done.Wait();
+  VERIFY_IS_APPROX(c_inner, ref);
+
+  // Concurrent products from several user threads share the pool safely.
+  std::vector<MatrixType> results(4, MatrixType(n, m));
+  std::vector<std::thread> users;
+  for (int t = 0; t < 4; ++t)
+    users.emplace_back([&, t]() { results[t].noalias() = a * b; });
+  for (std::thread& user : users) user.join();
+  for (int t = 0; t < 4; ++t)
+    VERIFY_IS_APPROX(results[t], ref);
+
+  setGemmThreadPool(nullptr);
+}
+
+void test_nested_parallel_loops(int num_threads)
+{
+  ThreadPool pool(num_threads);
+  setGemmThreadPool(&pool);
+  const Index num_tasks = internal::parallel_loop_threads();
+  VERIFY_IS_EQUAL(num_tasks, Index(num_threads));
+
+  // Every task, including the one run by the calling thread, sees itself inside a parallel region,
+  // so that the loops it starts run sequentially instead of waiting on a busy pool.
+  std::vector<Index> inner_threads(num_tasks, -1);
+  std::vector<Index> inner_calls(num_tasks, 0);
+  internal::parallelize_tasks(num_tasks, [&](Index i) {
+    inner_threads[i] = internal::parallel_loop_threads();
+    internal::parallelize_tasks(3, [&](Index) { ++inner_calls[i]; });
+  });
+  for (Index i = 0; i < num_tasks; ++i) {
+    VERIFY_IS_EQUAL(inner_threads[i], Index(1));
+    VERIFY_IS_EQUAL(inner_calls[i], Index(3));
+  }
+  VERIFY_IS_EQUAL(internal::parallel_loop_threads(), Index(num_threads));
+
+  setGemmThreadPool(nullptr);
+}
+
+EIGEN_DECLARE_TEST(product_threaded)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( test_parallelize_gemm<MatrixXf>(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_2(( test_parallelize_gemm<MatrixXd>(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_3(( test_parallelize_gemm<Matrix<double,Dynamic,Dynamic,RowMajor> >(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_4(( test_parallelize_gemm<MatrixXcf>(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_5(( test_nested_parallel_loops(internal::random<int>(2, 8)) ));
+  }
+}
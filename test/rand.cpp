@@ -54,8 +54,67 @@ template<typename Scalar> void check_histogram(Scalar x, Scalar y, int bins)
   VERIFY( (((hist.cast<double>()/double(f))-1.0).abs()<0.03).all() );
 }
 
+template<typename Scalar> void check_counter_random()
+{
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic,ColMajor> ColMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMatrix;
+  const Index rows = internal::random<Index>(1,67);
+  const Index cols = internal::random<Index>(1,31);
+  const numext::uint64_t seed = internal::random<unsigned>();
+
+  // The values only depend on the seed and on the coefficient position,
+  // whatever the storage order and the traversal (packets or scalars).
+  ColMatrix a = ColMatrix::CounterRandom(rows, cols, seed);
+  RowMatrix b = RowMatrix::CounterRandom(rows, cols, seed);
+  ColMatrix c(rows, cols);
+  for(Index j=0; j<cols; ++j)
+    for(Index i=0; i<rows; ++i)
+      c(i,j) = ColMatrix::CounterRandom(rows, cols, seed).coeff(i,j);
+  VERIFY_IS_CWISE_EQUAL(a, b);
+  VERIFY_IS_CWISE_EQUAL(a, c);
+
+  Matrix<Scalar,Dynamic,1> v(rows*cols);
+  v.setCounterRandom(seed);
+  VERIFY_IS_CWISE_EQUAL(v, a.reshaped());
+  VERIFY_IS_CWISE_EQUAL(v.tail(rows*cols-1), (Matrix<Scalar,Dynamic,1>::CounterRandom(rows*cols, seed).tail(rows*cols-1)));
+
+  Matrix<Scalar,4,3> f = Matrix<Scalar,4,3>::CounterRandom(seed);
+  VERIFY_IS_CWISE_EQUAL(f, (ColMatrix::CounterRandom(4, 3, seed)));
+
+  ColMatrix d(rows, cols);
+  d.setCounterRandom(seed+1);
+  VERIFY((a.array()!=d.array()).any() || rows*cols==1);
+
+  // Floating point values are in [-1,1) with a mean close to zero.
+  Matrix<Scalar,Dynamic,1> large = Matrix<Scalar,Dynamic,1>::CounterRandom(100000, seed);
+  VERIFY((large.real().array() >= RealScalar(-1)).all() && (large.real().array() < RealScalar(1)).all());
+  VERIFY(numext::abs(large.real().mean()) < RealScalar(0.01));
+}
+
 EIGEN_DECLARE_TEST(rand)
 {
+  // Known answers of Threefry-2x32-20.
+  numext::uint64_t block = 0;
+  numext::uint32_t words[2];
+  internal::threefry2x32_20<1>(&block, 0, words);
+  VERIFY_IS_EQUAL(words[0], 0x6b200159u);
+  VERIFY_IS_EQUAL(words[1], 0x99ba4efeu);
+  block = 0x85a308d3243f6a88ull;
+  internal::threefry2x32_20<1>(&block, 0x0370734413198a2eull, words);
+  VERIFY_IS_EQUAL(words[0], 0xc4923a9cu);
+  VERIFY_IS_EQUAL(words[1], 0x483df7a0u);
+
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST(check_counter_random<float>());
+    CALL_SUBTEST(check_counter_random<double>());
+    CALL_SUBTEST(check_counter_random<std::complex<float> >());
+  }
+  {
+    VectorXi v = VectorXi::CounterRandom(10000, 42);
+    VERIFY(v.minCoeff() < -(1<<30) && v.maxCoeff() > (1<<30));
+  }
+
   long long_ref = NumTraits<long>::highest()/10;
   // the minimum guarantees that these conversions are safe
   auto char_offset = static_cast<signed char>((std::min)(g_repeat, 64));
@@ -9,6 +9,34 @@
 
 #include "sparse_solver.h"
 
+// Supernodes are only amalgamated along the elimination tree, so none of them spans two blocks of a block diagonal matrix.
+template<typename Solver> void check_supernodal_block_diagonal(Solver& solver)
+{
+  typedef typename Solver::MatrixType Mat;
+  typedef typename Mat::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+
+  const Index blocks = internal::random<Index>(2, 40);
+  std::vector<Triplet<Scalar> > triplets;
+  Index n = 0;
+  for(Index b = 0; b < blocks; ++b)
+  {
+    const Index size = internal::random<Index>(1, 3);
+    for(Index j = 0; j < size; ++j)
+      for(Index i = 0; i < size; ++i)
+        triplets.push_back(Triplet<Scalar>(n+i, n+j, i==j ? Scalar(size+1) : Scalar(1)));
+    n += size;
+  }
+  Mat A(n, n);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  DenseVector b = DenseVector::Random(n);
+
+  solver.compute(A);
+  VERIFY_IS_EQUAL(solver.info(), Success);
+  VERIFY_IS_EQUAL(solver.supernodes(), blocks);
+  VERIFY_IS_APPROX(A * solver.solve(b), b);
+}
+
 template<typename T, typename I_, int flag> void test_simplicial_cholesky_T()
 {
   typedef SparseMatrix<T,flag,I_> SparseMatrixType;
@@ -20,6 +48,11 @@ template<typename T, typename I_, int flag> void test_simplicial_cholesky_T()
   SimplicialLDLT<    SparseMatrixType, Upper> ldlt_colmajor_upper_amd;
   SimplicialLDLT<    SparseMatrixType, Lower, NaturalOrdering<I_> > ldlt_colmajor_lower_nat;
   SimplicialLDLT<    SparseMatrixType, Upper, NaturalOrdering<I_> > ldlt_colmajor_upper_nat;
+  SupernodalLLT<     SparseMatrixType, Lower> snllt_colmajor_lower_amd;
+  SupernodalLLT<     SparseMatrixType, Upper> snllt_colmajor_upper_amd;
+  SupernodalLLT<     SparseMatrixType, Lower, NaturalOrdering<I_> > snllt_colmajor_lower_nat;
+  SimplicialLLT<     SparseMatrixType, Lower, NestedDissectionOrdering<I_> > llt_colmajor_lower_nd;
+  SupernodalLLT<     SparseMatrixType, Upper, NestedDissectionOrdering<I_> > snllt_colmajor_upper_nd;
 
   check_sparse_spd_solving(chol_colmajor_lower_amd);
   check_sparse_spd_solving(chol_colmajor_upper_amd);
@@ -27,6 +60,8 @@ template<typename T, typename I_, int flag> void test_simplicial_cholesky_T()
   check_sparse_spd_solving(llt_colmajor_upper_amd);
   check_sparse_spd_solving(ldlt_colmajor_lower_amd);
   check_sparse_spd_solving(ldlt_colmajor_upper_amd);
+  check_sparse_spd_solving(snllt_colmajor_lower_amd);
+  check_sparse_spd_solving(snllt_colmajor_upper_amd);
   
   check_sparse_spd_determinant(chol_colmajor_lower_amd);
   check_sparse_spd_determinant(chol_colmajor_upper_amd);
@@ -34,9 +69,114 @@ template<typename T, typename I_, int flag> void test_simplicial_cholesky_T()
   check_sparse_spd_determinant(llt_colmajor_upper_amd);
   check_sparse_spd_determinant(ldlt_colmajor_lower_amd);
   check_sparse_spd_determinant(ldlt_colmajor_upper_amd);
+  check_sparse_spd_determinant(snllt_colmajor_lower_amd);
+  check_sparse_spd_determinant(snllt_colmajor_upper_amd);
+  
+  check_sparse_spd_cached_analysis(chol_colmajor_lower_amd);
+  check_sparse_spd_cached_analysis(llt_colmajor_upper_amd);
+  check_sparse_spd_cached_analysis(ldlt_colmajor_lower_amd);
+  check_sparse_spd_cached_analysis(snllt_colmajor_lower_amd);
+
+  check_sparse_spd_analysis_mode(llt_colmajor_lower_amd, ldlt_colmajor_lower_amd);
+  chol_colmajor_upper_amd.setMode(SimplicialCholeskyLLT);
+  check_sparse_spd_analysis_mode(chol_colmajor_upper_amd, ldlt_colmajor_upper_amd);
+  {
+    // factorize() redoes an analysis computed in the other mode
+    typedef Matrix<T,Dynamic,Dynamic> DenseMatrix;
+    typedef Matrix<T,Dynamic,1> DenseVector;
+    SparseMatrixType A, halfA;
+    DenseMatrix dA;
+    generate_sparse_spd_problem(chol_colmajor_upper_amd, A, halfA, dA, 200);
+    DenseVector b = DenseVector::Random(A.rows());
+    chol_colmajor_upper_amd.analyzePattern(A);
+    chol_colmajor_upper_amd.setMode(SimplicialCholeskyLDLT);
+    chol_colmajor_upper_amd.factorize(A);
+    VERIFY(chol_colmajor_upper_amd.info() == Success);
+    VERIFY(chol_colmajor_upper_amd.solve(b).isApprox(dA.llt().solve(b),test_precision<T>()));
+  }
   
   check_sparse_spd_solving(ldlt_colmajor_lower_nat, (std::min)(300,EIGEN_TEST_MAX_SIZE), 1000);
   check_sparse_spd_solving(ldlt_colmajor_upper_nat, (std::min)(300,EIGEN_TEST_MAX_SIZE), 1000);
+  check_sparse_spd_solving(snllt_colmajor_lower_nat, (std::min)(300,EIGEN_TEST_MAX_SIZE), 1000);
+  check_supernodal_block_diagonal(snllt_colmajor_lower_nat);
+  check_sparse_spd_solving(llt_colmajor_lower_nd, (std::min)(1000,EIGEN_TEST_MAX_SIZE), 3000);
+  check_sparse_spd_solving(snllt_colmajor_upper_nd, (std::min)(1000,EIGEN_TEST_MAX_SIZE), 3000);
+  check_sparse_spd_determinant(llt_colmajor_lower_nd);
+}
+
+// 3D Laplacian with one in \a hole_rate missing couplings, whose factor has large supernodes and a wide elimination tree
+template<typename Scalar> SparseMatrix<Scalar> laplacian_3d(Index g, int hole_rate)
+{
+  std::vector<Triplet<Scalar> > triplets;
+  for(Index i = 0; i < g; ++i)
+    for(Index j = 0; j < g; ++j)
+      for(Index l = 0; l < g; ++l)
+      {
+        Index k = (i*g+j)*g+l;
+        triplets.push_back(Triplet<Scalar>(k, k, Scalar(6.5)));
+        if(hole_rate>0 && internal::random<int>(0,hole_rate)==0) continue;
+        if(i>0) triplets.push_back(Triplet<Scalar>(k, k-g*g, Scalar(-1)));
+        if(j>0) triplets.push_back(Triplet<Scalar>(k, k-g, Scalar(-1)));
+        if(l>0) triplets.push_back(Triplet<Scalar>(k, k-1, Scalar(-1)));
+      }
+  SparseMatrix<Scalar> A(g*g*g, g*g*g);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  return A;
+}
+
+// SupernodalLLT must match the simplicial factorization on a problem large enough for its subtrees to be
+// factorized independently.
+template<typename Scalar> void test_supernodal_llt_laplacian()
+{
+  typedef SparseMatrix<Scalar> SparseMatrixType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+
+  SparseMatrixType A = laplacian_3d<Scalar>(internal::random<Index>(14, 20), 0);
+  const Index n = A.rows();
+  DenseMatrix b = DenseMatrix::Random(n, 3);
+
+  SimplicialLLT<SparseMatrixType> ref(A);
+  VERIFY_IS_EQUAL(ref.info(), Success);
+  SupernodalLLT<SparseMatrixType> llt(A);
+  VERIFY_IS_EQUAL(llt.info(), Success);
+  VERIFY(llt.supernodes() < n);
+  DenseMatrix x = llt.solve(b);
+  VERIFY_IS_APPROX(x, ref.solve(b));
+  VERIFY_IS_APPROX(A.template selfadjointView<Lower>() * x, b);
+
+  // same pattern, new values
+  A.diagonal().array() += Scalar(1);
+  llt.factorize(A);
+  VERIFY_IS_EQUAL(llt.info(), Success);
+  x = llt.solve(b);
+  VERIFY_IS_APPROX(A.template selfadjointView<Lower>() * x, b);
+}
+
+// NestedDissectionOrdering must return a valid permutation, which does not depend on how its independent
+// subgraphs are scheduled, also when some subgraphs are disconnected.
+template<typename Scalar> void test_nested_dissection_laplacian()
+{
+  typedef SparseMatrix<Scalar> SparseMatrixType;
+  typedef PermutationMatrix<Dynamic,Dynamic,int> PermutationType;
+
+  SparseMatrixType A = laplacian_3d<Scalar>(internal::random<Index>(12, 18), 20);
+  const Index n = A.rows();
+
+  PermutationType p, p_again;
+  NestedDissectionOrdering<int> ordering;
+  ordering(A.template selfadjointView<Lower>(), p);
+  VERIFY_IS_EQUAL(p.size(), n);
+  Matrix<int,Dynamic,1> sorted = p.indices();
+  std::sort(sorted.data(), sorted.data()+n);
+  VERIFY((sorted == Matrix<int,Dynamic,1>::LinSpaced(n, 0, int(n-1))));
+  ordering(A.template selfadjointView<Lower>(), p_again);
+  VERIFY(p_again.indices() == p.indices());
+
+  Matrix<Scalar,Dynamic,1> b = Matrix<Scalar,Dynamic,1>::Random(n);
+  SupernodalLLT<SparseMatrixType, Lower, NestedDissectionOrdering<int> > llt(A);
+  VERIFY_IS_EQUAL(llt.info(), Success);
+  Matrix<Scalar,Dynamic,1> x = llt.solve(b);
+  VERIFY_IS_APPROX(A.template selfadjointView<Lower>() * x, b);
 }
 
 EIGEN_DECLARE_TEST(simplicial_cholesky)
@@ -44,6 +184,8 @@ EIGEN_DECLARE_TEST(simplicial_cholesky)
   CALL_SUBTEST_11(( test_simplicial_cholesky_T<double,               int, ColMajor>() ));
   CALL_SUBTEST_12(( test_simplicial_cholesky_T<std::complex<double>, int, ColMajor>() ));
   CALL_SUBTEST_13(( test_simplicial_cholesky_T<double,          long int, ColMajor>() ));
+  CALL_SUBTEST_14(( test_supernodal_llt_laplacian<double>() ));
+  CALL_SUBTEST_15(( test_nested_dissection_laplacian<double>() ));
   CALL_SUBTEST_21(( test_simplicial_cholesky_T<double,               int, RowMajor>() ));
   CALL_SUBTEST_22(( test_simplicial_cholesky_T<std::complex<double>, int, RowMajor>() ));
   CALL_SUBTEST_23(( test_simplicial_cholesky_T<double,          long int, RowMajor>() ));
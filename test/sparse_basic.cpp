@@ -799,6 +799,44 @@ void big_sparse_triplet(Index rows, Index cols, double density) {
   VERIFY_IS_APPROX(sum, m.sum());
 }
 
+// Many triplets with many duplicates, as split among threads by the multi-threaded assembly.
+template<typename SparseMatrixType>
+void big_sparse_triplet_duplicates() {
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Triplet<Scalar,int> TripletType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+
+  const Index rows = internal::random<Index>(1000, 2000);
+  const Index cols = internal::random<Index>(1000, 2000);
+  const Index size = internal::random<Index>(100000, 300000);
+  std::vector<TripletType> triplets;
+  triplets.reserve(size);
+  DenseMatrix refMat_sum = DenseMatrix::Zero(rows, cols), refMat_last = DenseMatrix::Zero(rows, cols);
+  for(Index k = 0; k < size; ++k)
+  {
+    TripletType t(internal::random<int>(0, int(rows-1)), internal::random<int>(0, int(cols/10)), internal::random<Scalar>());
+    triplets.push_back(t);
+    refMat_sum(t.row(), t.col()) += t.value();
+    refMat_last(t.row(), t.col()) = t.value();
+  }
+
+  SparseMatrixType m(rows, cols);
+  m.setFromTriplets(triplets.begin(), triplets.end());
+  VERIFY(m.isCompressed());
+  VERIFY_IS_EQUAL(m.innerIndicesAreSorted(), m.outerSize());
+  VERIFY_IS_APPROX(m, refMat_sum);
+  m.setFromTriplets(triplets.begin(), triplets.end(), [](const Scalar&, const Scalar& b) { return b; });
+  VERIFY_IS_EQUAL(m.innerIndicesAreSorted(), m.outerSize());
+  VERIFY_IS_EQUAL((m.toDense() - refMat_last).norm(), 0);
+
+  // triplets already sorted
+  std::sort(triplets.begin(), triplets.end(), [](const TripletType& a, const TripletType& b) {
+    return SparseMatrixType::IsRowMajor ? (a.row() != b.row() ? a.row() < b.row() : a.col() < b.col())
+                                        : (a.col() != b.col() ? a.col() < b.col() : a.row() < b.row()); });
+  m.setFromTriplets(triplets.begin(), triplets.end());
+  VERIFY_IS_APPROX(m, refMat_sum);
+}
+
 template<int>
 void bug1105()
 {
@@ -849,6 +887,8 @@ EIGEN_DECLARE_TEST(sparse_basic)
   // Regression test for bug 900: (manually insert higher values here, if you have enough RAM):
   CALL_SUBTEST_5(( big_sparse_triplet<SparseMatrix<float, RowMajor, int>>(10000, 10000, 0.125)));
   CALL_SUBTEST_5(( big_sparse_triplet<SparseMatrix<double, ColMajor, long int>>(10000, 10000, 0.125)));
+  CALL_SUBTEST_3(( big_sparse_triplet_duplicates<SparseMatrix<double>>() ));
+  CALL_SUBTEST_2(( big_sparse_triplet_duplicates<SparseMatrix<std::complex<float>, RowMajor, long int>>() ));
 
   CALL_SUBTEST_5(bug1105<0>());
 }
@@ -461,6 +461,105 @@ void test_mixing_types()
   VERIFY_IS_APPROX( dC2 = sC1 * dR1.col(0), dC3 = sC1 * dR1.template cast<Cplx>().col(0) );
 }
 
+// Large sparse * dense products of a matrix with a few much denser rows and columns, such that
+// the multi-threaded kernels cannot balance their work by the row counts alone.
+template<typename SparseMatrixType> void sparse_product_skewed()
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  typedef Matrix<Scalar,Dynamic,Dynamic> ColMajorDense;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMajorDense;
+
+  const Index rows = internal::random<Index>(3000, 6000);
+  const Index cols = internal::random<Index>(3000, 6000);
+  std::vector<Triplet<Scalar> > triplets;
+  for(Index j = 0; j < cols; ++j)
+    for(int k = 0; k < 24; ++k)
+      triplets.push_back(Triplet<Scalar>(internal::random<Index>(0,rows-1), j, internal::random<Scalar>()));
+  for(Index j = 0; j < cols; j += 3)
+    triplets.push_back(Triplet<Scalar>(0, j, internal::random<Scalar>()));
+  for(Index i = 0; i < rows; i += 3)
+    triplets.push_back(Triplet<Scalar>(i, cols-1, internal::random<Scalar>()));
+  SparseMatrixType m(rows, cols);
+  m.setFromTriplets(triplets.begin(), triplets.end());
+
+  DenseVector x = DenseVector::Random(cols);
+  DenseVector xt = DenseVector::Random(rows);
+  ColMajorDense X = ColMajorDense::Random(cols, 3);
+  RowMajorDense Xr = X;
+
+  // references accumulated entry by entry
+  DenseVector ref = DenseVector::Zero(rows), ref_t = DenseVector::Zero(cols);
+  ColMajorDense ref_X = ColMajorDense::Zero(rows, 3);
+  for(Index j = 0; j < m.outerSize(); ++j)
+    for(typename SparseMatrixType::InnerIterator it(m, j); it; ++it)
+    {
+      ref(it.row()) += it.value() * x(it.col());
+      ref_t(it.col()) += it.value() * xt(it.row());
+      ref_X.row(it.row()) += it.value() * X.row(it.col());
+    }
+
+  DenseVector y = m * x;
+  VERIFY_IS_APPROX(y, ref);
+  y = m.transpose() * xt;
+  VERIFY_IS_APPROX(y, ref_t);
+  y = xt.transpose() * m;
+  VERIFY_IS_APPROX(y, ref_t);
+  ColMajorDense Y = m * X;
+  VERIFY_IS_APPROX(Y, ref_X);
+  RowMajorDense Yr = m * Xr;
+  VERIFY_IS_APPROX(ColMajorDense(Yr), ref_X);
+  y = ref;
+  y.noalias() += Scalar(2) * (m * x);
+  VERIFY_IS_APPROX(y, Scalar(3) * ref);
+}
+
+// Large sparse * sparse products with columns of very different numbers of entries,
+// so that both the hash and the dense accumulators are used.
+template<typename Scalar> void sparse_sparse_product_skewed()
+{
+  typedef SparseMatrix<Scalar> ColMatrix;
+  typedef SparseMatrix<Scalar,RowMajor> RowMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+
+  const Index rows = internal::random<Index>(500, 1000);
+  const Index depth = internal::random<Index>(500, 1000);
+  const Index cols = internal::random<Index>(300, 600);
+  auto random_sparse = [](Index r, Index c) {
+    std::vector<Triplet<Scalar> > triplets;
+    for(Index j = 0; j < c; ++j)
+    {
+      const Index count = internal::random<int>(0, 5) == 0 ? internal::random<Index>(50, 150) : internal::random<Index>(0, 4);
+      for(Index k = 0; k < count; ++k)
+        triplets.push_back(Triplet<Scalar>(internal::random<Index>(0, r-1), j, internal::random<Scalar>()));
+    }
+    ColMatrix m(r, c);
+    m.setFromTriplets(triplets.begin(), triplets.end());
+    return m;
+  };
+  ColMatrix A = random_sparse(rows, depth);
+  ColMatrix B = random_sparse(depth, cols);
+  RowMatrix rowA = A, rowB = B;
+  DenseMatrix refAB = A.toDense() * B.toDense();
+
+  ColMatrix AB = A * B;
+  VERIFY_IS_EQUAL(AB.innerIndicesAreSorted(), AB.outerSize());
+  VERIFY_IS_APPROX(AB.toDense(), refAB);
+
+  ColMatrix AAt = A * A.transpose();
+  VERIFY_IS_EQUAL(AAt.innerIndicesAreSorted(), AAt.outerSize());
+  VERIFY_IS_APPROX(AAt.toDense(), A.toDense() * A.toDense().transpose());
+
+  RowMatrix rowAB = rowA * rowB;
+  VERIFY_IS_EQUAL(rowAB.nonZeros(), AB.nonZeros());
+  VERIFY_IS_EQUAL(rowAB.innerIndicesAreSorted(), rowAB.outerSize());
+  VERIFY_IS_APPROX(rowAB.toDense(), refAB);
+
+  // mixed storage orders
+  VERIFY_IS_APPROX(ColMatrix(A * rowB).toDense(), refAB);
+  VERIFY_IS_APPROX(RowMatrix(rowA * B).toDense(), refAB);
+}
+
 // Test mixed storage types
 template<int OrderA, int OrderB, int OrderC>
 void test_mixed_storage_imp() {
@@ -526,5 +625,11 @@ EIGEN_DECLARE_TEST(sparse_product)
 
     CALL_SUBTEST_5( (test_mixing_types<float>()) );
     CALL_SUBTEST_5( (test_mixed_storage()) );
+
+    CALL_SUBTEST_6( (sparse_product_skewed<SparseMatrix<double> >()) );
+    CALL_SUBTEST_6( (sparse_product_skewed<SparseMatrix<double,RowMajor> >()) );
+    CALL_SUBTEST_7( (sparse_product_skewed<SparseMatrix<std::complex<float> > >()) );
+    CALL_SUBTEST_6( (sparse_sparse_product_skewed<double>()) );
+    CALL_SUBTEST_7( (sparse_sparse_product_skewed<std::complex<double> >()) );
   }
 }
@@ -654,6 +654,173 @@ template<typename Solver> void check_sparse_square_abs_determinant(Solver& solve
   }
 }
 
+// Refactorizes matrices in the cached analysis mode, and restores a serialized analysis in another solver.
+template<typename Solver>
+void check_sparse_cached_analysis(Solver& solver, const typename Solver::MatrixType& A, const typename Solver::MatrixType& B)
+{
+  typedef typename Solver::MatrixType Mat;
+  typedef typename Mat::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+
+  DenseVector b = DenseVector::Random(A.rows());
+  DenseVector c = DenseVector::Random(B.rows());
+  DenseVector refX = DenseMatrix(A).householderQr().solve(b);
+  DenseVector refY = DenseMatrix(B).householderQr().solve(c);
+  Mat A2 = A;
+  A2 *= Scalar(2);
+
+  solver.setCachedAnalysis(true);
+  VERIFY(solver.cachedAnalysis());
+  solver.compute(A);
+  VERIFY(solver.info() == Success);
+  VERIFY(solver.solve(b).isApprox(refX,test_precision<Scalar>()));
+
+  // same pattern, the analysis is reused
+  solver.compute(A2);
+  VERIFY(solver.info() == Success);
+  VERIFY((Scalar(2)*solver.solve(b)).isApprox(refX,test_precision<Scalar>()));
+
+  // restore the serialized analysis in another solver
+  std::vector<uint8_t> buffer(solver.serializedAnalysisSize());
+  uint8_t* buffer_end = buffer.data() + buffer.size();
+  VERIFY(solver.serializeAnalysis(buffer.data(), buffer_end) == buffer_end);
+  VERIFY(solver.serializeAnalysis(buffer.data(), buffer_end-1) == nullptr);
+  {
+    Solver solver2;
+    VERIFY(solver2.deserializeAnalysis(buffer.data(), buffer_end-1) == nullptr);
+    VERIFY(solver2.deserializeAnalysis(buffer.data(), buffer_end) == buffer_end);
+    solver2.factorize(A);
+    VERIFY(solver2.info() == Success);
+    VERIFY(solver2.solve(b).isApprox(refX,test_precision<Scalar>()));
+    solver2.setCachedAnalysis(true);
+    solver2.compute(A2);
+    VERIFY(solver2.info() == Success);
+    VERIFY((Scalar(2)*solver2.solve(b)).isApprox(refX,test_precision<Scalar>()));
+  }
+
+  // a corrupted analysis is rejected, unless only unused bytes are overwritten
+  const int invalid = -3;
+  Index rejected = 0;
+  for(size_t k = 0; k+sizeof(int) <= buffer.size(); k += sizeof(int))
+  {
+    std::vector<uint8_t> corrupted(buffer);
+    std::memcpy(corrupted.data()+k, &invalid, sizeof(int));
+    Solver solver3;
+    if(solver3.deserializeAnalysis(corrupted.data(), corrupted.data()+corrupted.size()) == nullptr)
+    {
+      ++rejected;
+      continue;
+    }
+    solver3.factorize(A);
+    VERIFY(solver3.info() == Success);
+    VERIFY(solver3.solve(b).isApprox(refX,test_precision<Scalar>()));
+  }
+  VERIFY(rejected > Index(buffer.size()/sizeof(int))/2);
+
+  // so is a permutation mapping two indices to the same one, found as a vector of size n holding a permutation
+  if(A.cols() >= 2)
+  {
+    typedef typename Mat::StorageIndex StorageIndex;
+    typedef Matrix<StorageIndex,Dynamic,1> IndexVector;
+    const Index n = A.cols(), perm_header[2] = {n, 1};
+    const uint8_t* perm_header_begin = reinterpret_cast<const uint8_t*>(perm_header);
+    uint8_t* perm = buffer.data();
+    IndexVector indices(n), sorted;
+    for(;;)
+    {
+      perm = std::search(perm, buffer_end, perm_header_begin, perm_header_begin+sizeof(perm_header));
+      VERIFY(perm != buffer_end);
+      perm += sizeof(perm_header);
+      if(perm + n*sizeof(StorageIndex) > buffer_end)
+        continue;
+      std::memcpy(indices.data(), perm, n*sizeof(StorageIndex));
+      sorted = indices;
+      std::sort(sorted.data(), sorted.data()+n);
+      if(sorted == IndexVector::LinSpaced(n, 0, StorageIndex(n-1)))
+        break;
+    }
+    std::memcpy(perm, perm+sizeof(StorageIndex), sizeof(StorageIndex));
+    Solver solver3;
+    VERIFY(solver3.deserializeAnalysis(buffer.data(), buffer_end) == nullptr);
+  }
+
+  // a different pattern triggers a new analysis
+  solver.compute(B);
+  VERIFY(solver.info() == Success);
+  VERIFY(solver.solve(c).isApprox(refY,test_precision<Scalar>()));
+  solver.compute(A);
+  VERIFY(solver.info() == Success);
+  VERIFY(solver.solve(b).isApprox(refX,test_precision<Scalar>()));
+  solver.setCachedAnalysis(false);
+}
+
+template<typename Solver> void check_sparse_spd_cached_analysis(Solver& solver)
+{
+  typedef typename Solver::MatrixType Mat;
+  typedef typename Mat::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+
+  for (int i = 0; i < g_repeat; i++) {
+    Mat A, halfA, B, halfB;
+    DenseMatrix dA, dB;
+    generate_sparse_spd_problem(solver, A, halfA, dA, 100);
+    generate_sparse_spd_problem(solver, B, halfB, dB, 100);
+    check_sparse_cached_analysis(solver, A, B);
+  }
+}
+
+// an analysis computed by a Cholesky solver in LLT mode is rejected by a solver in LDLT mode, and conversely
+template<typename LLTSolver, typename LDLTSolver> void check_sparse_spd_analysis_mode(LLTSolver& llt, LDLTSolver& ldlt)
+{
+  typedef typename LLTSolver::MatrixType Mat;
+  typedef typename Mat::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+
+  Mat A, halfA;
+  DenseMatrix dA;
+  generate_sparse_spd_problem(llt, A, halfA, dA, 200);
+  DenseVector b = DenseVector::Random(A.rows());
+  DenseVector refX = dA.llt().solve(b);
+
+  llt.analyzePattern(A);
+  std::vector<uint8_t> llt_buffer(llt.serializedAnalysisSize());
+  VERIFY(llt.serializeAnalysis(llt_buffer.data(), llt_buffer.data()+llt_buffer.size()) != nullptr);
+  ldlt.analyzePattern(A);
+  std::vector<uint8_t> ldlt_buffer(ldlt.serializedAnalysisSize());
+  VERIFY(ldlt.serializeAnalysis(ldlt_buffer.data(), ldlt_buffer.data()+ldlt_buffer.size()) != nullptr);
+
+  VERIFY(ldlt.deserializeAnalysis(llt_buffer.data(), llt_buffer.data()+llt_buffer.size()) == nullptr);
+  VERIFY(llt.deserializeAnalysis(ldlt_buffer.data(), ldlt_buffer.data()+ldlt_buffer.size()) == nullptr);
+
+  VERIFY(llt.deserializeAnalysis(llt_buffer.data(), llt_buffer.data()+llt_buffer.size()) != nullptr);
+  llt.factorize(A);
+  VERIFY(llt.info() == Success);
+  VERIFY(llt.solve(b).isApprox(refX,test_precision<Scalar>()));
+  VERIFY(ldlt.deserializeAnalysis(ldlt_buffer.data(), ldlt_buffer.data()+ldlt_buffer.size()) != nullptr);
+  ldlt.factorize(A);
+  VERIFY(ldlt.info() == Success);
+  VERIFY(ldlt.solve(b).isApprox(refX,test_precision<Scalar>()));
+}
+
+template<typename Solver> void check_sparse_square_cached_analysis(Solver& solver)
+{
+  typedef typename Solver::MatrixType Mat;
+  typedef typename Mat::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+
+  for (int i = 0; i < g_repeat; i++) {
+    Mat A, B;
+    DenseMatrix dA, dB;
+    generate_sparse_square_problem(solver, A, dA, 100);
+    generate_sparse_square_problem(solver, B, dB, 100);
+    A.makeCompressed();
+    B.makeCompressed();
+    check_sparse_cached_analysis(solver, A, B);
+  }
+}
+
 template<typename Solver, typename DenseMat>
 void generate_sparse_leastsquare_problem(Solver&, typename Solver::MatrixType& A, DenseMat& dA, int maxSize = 300, int options = ForceNonZeroDiag)
 {
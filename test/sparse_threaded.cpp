@@ -0,0 +1,304 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_GEMM_THREADPOOL
+#include "main.h"
+#include <Eigen/SparseCore>
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/SparseCholesky>
+
+// The sparse kernels split between the threads of the pool are checked against their sequential
+// versions here; their results on their own are checked by the tests of each module.
+
+// Random sparse matrix with a few much denser rows and columns, so that
+// partitioning by row counts would be unbalanced.
+template<typename SparseMatrixType>
+SparseMatrixType random_skewed_sparse(Index rows, Index cols)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  std::vector<Triplet<Scalar> > triplets;
+  for(Index j = 0; j < cols; ++j)
+    for(int k = 0; k < 24; ++k)
+      triplets.push_back(Triplet<Scalar>(internal::random<Index>(0,rows-1), j, internal::random<Scalar>()));
+  for(Index j = 0; j < cols; j += 3)
+    triplets.push_back(Triplet<Scalar>(0, j, internal::random<Scalar>()));
+  for(Index i = 0; i < rows; i += 3)
+    triplets.push_back(Triplet<Scalar>(i, cols-1, internal::random<Scalar>()));
+  SparseMatrixType m(rows, cols);
+  m.setFromTriplets(triplets.begin(), triplets.end());
+  return m;
+}
+
+// 2D Laplacian-like operator on a g x g grid, symmetric when \a west == \a east
+template<typename Scalar>
+SparseMatrix<Scalar> grid_operator(Index g, Scalar west, Scalar east)
+{
+  std::vector<Triplet<Scalar> > triplets;
+  for(Index i = 0; i < g; ++i)
+    for(Index j = 0; j < g; ++j)
+    {
+      Index k = i*g+j;
+      triplets.push_back(Triplet<Scalar>(k, k, Scalar(4.5)));
+      if(i>0)   triplets.push_back(Triplet<Scalar>(k, k-g, Scalar(-1)));
+      if(i<g-1) triplets.push_back(Triplet<Scalar>(k, k+g, Scalar(-1)));
+      if(j>0)   triplets.push_back(Triplet<Scalar>(k, k-1, west));
+      if(j<g-1) triplets.push_back(Triplet<Scalar>(k, k+1, east));
+    }
+  SparseMatrix<Scalar> A(g*g, g*g);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  return A;
+}
+
+template<typename SparseMatrixType>
+void test_parallel_spmv(int num_threads)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> ColMajorDense;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMajorDense;
+
+  const Index rows = internal::random<Index>(3000, 6000);
+  const Index cols = internal::random<Index>(3000, 6000);
+  SparseMatrixType m = random_skewed_sparse<SparseMatrixType>(rows, cols);
+  VectorType x = VectorType::Random(cols);
+  VectorType xt = VectorType::Random(rows);
+  ColMajorDense X = ColMajorDense::Random(cols, 3);
+  RowMajorDense Xr = X;
+
+  // References computed without any thread pool.
+  setGemmThreadPool(nullptr);
+  VectorType ref = m * x;
+  VectorType ref_t = m.transpose() * xt;
+  ColMajorDense ref_X = m * X;
+  VectorType ref_acc = ref + Scalar(2) * (m * x);
+
+  ThreadPool pool(num_threads);
+  setGemmThreadPool(&pool);
+
+  VectorType y = m * x;
+  VERIFY_IS_APPROX(y, ref);
+  y = m.transpose() * xt;
+  VERIFY_IS_APPROX(y, ref_t);
+  y = xt.transpose() * m;
+  VERIFY_IS_APPROX(y, ref_t);
+  ColMajorDense Y = m * X;
+  VERIFY_IS_APPROX(Y, ref_X);
+  RowMajorDense Yr = m * Xr;
+  VERIFY_IS_APPROX(ColMajorDense(Yr), ref_X);
+  y = ref;
+  y.noalias() += Scalar(2) * (m * x);
+  VERIFY_IS_APPROX(y, ref_acc);
+
+  // Products issued from a pool thread run sequentially.
+  VectorType y_inner;
+  Barrier done(1);
+  pool.Schedule([&]() { y_inner = m * x; done.Notify(); });
+  done.Wait();
+  VERIFY_IS_APPROX(y_inner, ref);
+
+  setGemmThreadPool(nullptr);
+}
+
+template<typename Scalar>
+void test_parallel_fused_iterations(int num_threads)
+{
+  typedef SparseMatrix<Scalar> SparseMatrixType;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+
+  // large enough for the vector operations to be split
+  const Index g = internal::random<Index>(260, 300);
+  SparseMatrixType A = grid_operator<Scalar>(g, Scalar(-1), Scalar(-1));
+  VectorType b = VectorType::Random(g*g);
+
+  ConjugateGradient<SparseMatrixType, Lower|Upper> cg;
+  BiCGSTAB<SparseMatrixType> bicg;
+  cg.setTolerance(typename NumTraits<Scalar>::Real(1e-10));
+  bicg.setTolerance(typename NumTraits<Scalar>::Real(1e-10));
+  cg.setFusedIterations(true);
+  bicg.setFusedIterations(true);
+  cg.compute(A);
+  bicg.compute(A);
+
+  setGemmThreadPool(nullptr);
+  VectorType x_cg = cg.solve(b), x_bicg = bicg.solve(b);
+
+  ThreadPool pool(num_threads);
+  setGemmThreadPool(&pool);
+
+  VectorType x = cg.solve(b);
+  VERIFY_IS_EQUAL(cg.info(), Success);
+  VERIFY_IS_APPROX(x, x_cg);
+  x = bicg.solve(b);
+  VERIFY_IS_EQUAL(bicg.info(), Success);
+  VERIFY_IS_APPROX(x, x_bicg);
+
+  setGemmThreadPool(nullptr);
+}
+
+template<typename Scalar>
+void test_parallel_supernodal_llt(int num_threads)
+{
+  typedef SparseMatrix<Scalar> SparseMatrixType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+
+  // 3D Laplacian with a few holes, whose elimination tree is wide and may be a forest
+  const Index g = internal::random<Index>(12, 18);
+  const Index n = g*g*g;
+  std::vector<Triplet<Scalar> > triplets;
+  for(Index i = 0; i < g; ++i)
+    for(Index j = 0; j < g; ++j)
+      for(Index l = 0; l < g; ++l)
+      {
+        Index k = (i*g+j)*g+l;
+        triplets.push_back(Triplet<Scalar>(k, k, Scalar(6.5)));
+        if(internal::random<int>(0,20)==0) continue;
+        if(i>0) triplets.push_back(Triplet<Scalar>(k, k-g*g, Scalar(-1)));
+        if(j>0) triplets.push_back(Triplet<Scalar>(k, k-g, Scalar(-1)));
+        if(l>0) triplets.push_back(Triplet<Scalar>(k, k-1, Scalar(-1)));
+      }
+  SparseMatrixType A(n, n);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  DenseMatrix b = DenseMatrix::Random(n, 3);
+
+  setGemmThreadPool(nullptr);
+  typedef PermutationMatrix<Dynamic,Dynamic,int> PermutationType;
+  PermutationType p_ref;
+  NestedDissectionOrdering<int> ordering;
+  ordering(A.template selfadjointView<Lower>(), p_ref);
+  SupernodalLLT<SparseMatrixType> llt_ref(A);
+  DenseMatrix x_ref = llt_ref.solve(b);
+
+  ThreadPool pool(num_threads);
+  setGemmThreadPool(&pool);
+
+  // the independent subgraphs are dissected concurrently, in any order
+  PermutationType p;
+  ordering(A.template selfadjointView<Lower>(), p);
+  VERIFY(p.indices() == p_ref.indices());
+
+  // the independent subtrees are factorized concurrently
+  SupernodalLLT<SparseMatrixType> llt(A);
+  VERIFY_IS_EQUAL(llt.info(), Success);
+  VERIFY_IS_EQUAL(llt.supernodes(), llt_ref.supernodes());
+  VERIFY_IS_APPROX(llt.solve(b), x_ref);
+
+  SupernodalLLT<SparseMatrixType, Lower, NestedDissectionOrdering<int> > llt_nd(A);
+  VERIFY_IS_EQUAL(llt_nd.info(), Success);
+  VERIFY_IS_APPROX(llt_nd.solve(b), x_ref);
+
+  setGemmThreadPool(nullptr);
+}
+
+template<typename Scalar>
+void test_parallel_incomplete_factorizations(int num_threads)
+{
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+
+  // the triangular solves of the preconditioners process the rows of a level concurrently
+  const Index g = internal::random<Index>(60, 120);
+  SparseMatrix<Scalar> A = grid_operator<Scalar>(g, Scalar(-1.5), Scalar(-0.5));
+  SparseMatrix<Scalar> S = grid_operator<Scalar>(g, Scalar(-1), Scalar(-1));
+  VectorType rhs = VectorType::Random(g*g);
+
+  setGemmThreadPool(nullptr);
+  IncompleteLUT<Scalar> ilut_ref(A);
+  IncompleteCholesky<Scalar> ichol_ref(S);
+  VectorType y_ilut = ilut_ref.solve(rhs), y_ichol = ichol_ref.solve(rhs);
+
+  ThreadPool pool(num_threads);
+  setGemmThreadPool(&pool);
+
+  IncompleteLUT<Scalar> ilut(A);
+  IncompleteCholesky<Scalar> ichol(S);
+  VERIFY_IS_APPROX(ilut.solve(rhs), y_ilut);
+  VERIFY_IS_APPROX(ichol.solve(rhs), y_ichol);
+
+  setGemmThreadPool(nullptr);
+}
+
+template<typename SparseMatrixType>
+void test_parallel_set_from_triplets(int num_threads)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Triplet<Scalar,int> TripletType;
+
+  const Index rows = internal::random<Index>(1000, 3000);
+  const Index cols = internal::random<Index>(1000, 3000);
+  const Index size = internal::random<Index>(100000, 300000);
+  std::vector<TripletType> triplets;
+  triplets.reserve(size);
+  for(Index k = 0; k < size; ++k)
+    triplets.push_back(TripletType(internal::random<int>(0, int(rows-1)), internal::random<int>(0, int(cols/10)),
+                                   internal::random<Scalar>()));
+  auto keep_last = [](const Scalar&, const Scalar& b) { return b; };
+
+  setGemmThreadPool(nullptr);
+  SparseMatrixType ref_sum(rows, cols), ref_last(rows, cols);
+  ref_sum.setFromTriplets(triplets.begin(), triplets.end());
+  ref_last.setFromTriplets(triplets.begin(), triplets.end(), keep_last);
+
+  ThreadPool pool(num_threads);
+  setGemmThreadPool(&pool);
+
+  // the ranges of triplets are split among the threads
+  SparseMatrixType m_sum(rows, cols), m_last(rows, cols);
+  m_sum.setFromTriplets(triplets.begin(), triplets.end());
+  m_last.setFromTriplets(triplets.begin(), triplets.end(), keep_last);
+  VERIFY_IS_EQUAL(m_sum.nonZeros(), ref_sum.nonZeros());
+  VERIFY_IS_APPROX(m_sum, ref_sum);
+  VERIFY_IS_EQUAL((m_last - ref_last).norm(), 0);
+
+  setGemmThreadPool(nullptr);
+}
+
+template<typename Scalar>
+void test_parallel_sparse_sparse_product(int num_threads)
+{
+  typedef SparseMatrix<Scalar> ColMatrix;
+  typedef SparseMatrix<Scalar,RowMajor> RowMatrix;
+
+  const Index rows = internal::random<Index>(1000, 3000);
+  const Index depth = internal::random<Index>(1000, 3000);
+  const Index cols = internal::random<Index>(500, 1500);
+  ColMatrix A = random_skewed_sparse<ColMatrix>(rows, depth);
+  ColMatrix B = random_skewed_sparse<ColMatrix>(depth, cols);
+  RowMatrix rowA = A, rowB = B;
+
+  setGemmThreadPool(nullptr);
+  ColMatrix refAB = A * B;
+  RowMatrix refRowAB = rowA * rowB;
+
+  ThreadPool pool(num_threads);
+  setGemmThreadPool(&pool);
+
+  // the columns of the result are filled concurrently
+  ColMatrix AB = A * B;
+  VERIFY_IS_EQUAL(AB.nonZeros(), refAB.nonZeros());
+  VERIFY_IS_APPROX(AB, refAB);
+  RowMatrix rowAB = rowA * rowB;
+  VERIFY_IS_EQUAL(rowAB.nonZeros(), refRowAB.nonZeros());
+  VERIFY_IS_APPROX(rowAB, refRowAB);
+
+  setGemmThreadPool(nullptr);
+}
+
+EIGEN_DECLARE_TEST(sparse_threaded)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( test_parallel_spmv<SparseMatrix<double> >(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_2(( test_parallel_spmv<SparseMatrix<double,RowMajor> >(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_3(( test_parallel_spmv<SparseMatrix<std::complex<float> > >(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_4(( test_parallel_fused_iterations<double>(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_5(( test_parallel_supernodal_llt<double>(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_6(( test_parallel_incomplete_factorizations<double>(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_6(( test_parallel_incomplete_factorizations<std::complex<double> >(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_7(( test_parallel_set_from_triplets<SparseMatrix<double> >(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_7(( test_parallel_set_from_triplets<SparseMatrix<std::complex<float>,RowMajor,long> >(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_8(( test_parallel_sparse_sparse_product<double>(internal::random<int>(2, 8)) ));
+    CALL_SUBTEST_8(( test_parallel_sparse_sparse_product<std::complex<double> >(internal::random<int>(2, 8)) ));
+  }
+}
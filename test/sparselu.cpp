@@ -23,16 +23,21 @@ template<typename T> void test_sparselu_T()
   SparseLU<SparseMatrix<T, ColMajor> /*, COLAMDOrdering<int>*/ > sparselu_colamd; // COLAMDOrdering is the default
   SparseLU<SparseMatrix<T, ColMajor>, AMDOrdering<int> > sparselu_amd; 
   SparseLU<SparseMatrix<T, ColMajor, long int>, NaturalOrdering<long int> > sparselu_natural;
+  SparseLU<SparseMatrix<T, ColMajor>, NestedDissectionOrdering<int> > sparselu_nd;
   
   check_sparse_square_solving(sparselu_colamd,  300, 100000, true); 
   check_sparse_square_solving(sparselu_amd,     300,  10000, true);
   check_sparse_square_solving(sparselu_natural, 300,   2000, true);
+  check_sparse_square_solving(sparselu_nd,      600,  10000, true);
   
   check_sparse_square_abs_determinant(sparselu_colamd);
   check_sparse_square_abs_determinant(sparselu_amd);
   
   check_sparse_square_determinant(sparselu_colamd);
   check_sparse_square_determinant(sparselu_amd);
+
+  check_sparse_square_cached_analysis(sparselu_colamd);
+  check_sparse_square_cached_analysis(sparselu_natural);
 }
 
 EIGEN_DECLARE_TEST(sparselu)
@@ -460,7 +460,7 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
           packed_lhs_, packed_rhs_);
 
       if (parallelize_by_sharding_dim_only_) {
-        const int num_worker_threads = device_.numThreadsInPool();
+        const int num_worker_threads = numPreallocatedThreadLocalBlocks();
 
         if (shard_by_col) {
           can_use_thread_local_packed_ = new std::atomic<bool>[nn_];
@@ -469,12 +469,14 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
                                                   std::memory_order_relaxed);
 
           Index num_blocks = num_worker_threads * gn_;
-          thread_local_pre_alocated_mem_ = kernel_.allocateSlices(  //
-              device_,                                              //
-              /*num_lhs=*/0,                                        //
-              /*num_rhs=*/num_blocks,                               //
-              /*num_slices=*/1,                                     //
-              /*lhs_blocks=*/nullptr, &rhs_thread_local_pre_allocated_);
+          if (num_blocks > 0) {
+            thread_local_pre_alocated_mem_ = kernel_.allocateSlices(  //
+                device_,                                              //
+                /*num_lhs=*/0,                                        //
+                /*num_rhs=*/num_blocks,                               //
+                /*num_slices=*/1,                                     //
+                /*lhs_blocks=*/nullptr, &rhs_thread_local_pre_allocated_);
+          }
 
         } else {
           can_use_thread_local_packed_ = new std::atomic<bool>[nm_];
@@ -483,12 +485,14 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
                                                   std::memory_order_relaxed);
 
           Index num_blocks = num_worker_threads * gm_;
-          thread_local_pre_alocated_mem_ = kernel_.allocateSlices(  //
-              device_,                                              //
-              /*num_lhs=*/num_blocks,                               //
-              /*num_rhs=*/0,                                        //
-              /*num_slices=*/1, &lhs_thread_local_pre_allocated_,   //
-              /*rhs_blocks=*/nullptr);
+          if (num_blocks > 0) {
+            thread_local_pre_alocated_mem_ = kernel_.allocateSlices(  //
+                device_,                                              //
+                /*num_lhs=*/num_blocks,                               //
+                /*num_rhs=*/0,                                        //
+                /*num_slices=*/1, &lhs_thread_local_pre_allocated_,   //
+                /*rhs_blocks=*/nullptr);
+          }
         }
       }
     }
@@ -500,7 +504,9 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
       }
       kernel_.deallocate(device_, packed_mem_);
       if (parallelize_by_sharding_dim_only_) {
-        kernel_.deallocate(device_, thread_local_pre_alocated_mem_);
+        if (numPreallocatedThreadLocalBlocks() > 0) {
+          kernel_.deallocate(device_, thread_local_pre_alocated_mem_);
+        }
         delete[] can_use_thread_local_packed_;
       }
     }
@@ -624,7 +630,7 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
     // different from the thread that was used for packing.
 
     // Handle for pre-allocated thread local memory buffers.
-    BlockMemHandle thread_local_pre_alocated_mem_;
+    BlockMemHandle thread_local_pre_alocated_mem_ = BlockMemHandle();
 
     // Only one of these will be initialized depending on shard_by_col value
     // (the size will be `num_worker_threads * num_grains_in_the_sharding_dim`).
@@ -639,6 +645,12 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
     // unique threads in a system is below or equal to the number of threads in
     // a thread pool. We will fallback on dynamic memory allocation after that.
 
+    // With a NUMA aware pool, the blocks are allocated by the threads using
+    // them, so that they land on the node of the thread.
+    int numPreallocatedThreadLocalBlocks() const {
+      return device_.numNumaNodes() > 1 ? 0 : device_.numThreadsInPool();
+    }
+
     // ThreadLocalBlocks is a container for Lhs or Rhs thread local buffers. Its
     // size is equal to the grain size in Lhs/Rhs sharding dimension.
     template <typename BlockType>
@@ -705,7 +717,7 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
      public:
       ThreadLocalBlocksInitialize(EvalParallelContext& ctx)
           : ctx_(ctx),
-            num_worker_threads_(ctx_.device_.numThreadsInPool()) {}
+            num_worker_threads_(ctx_.numPreallocatedThreadLocalBlocks()) {}
 
       void operator()(Blocks& blocks) {
         const int n = ctx_.num_thread_local_allocations_.fetch_add(
@@ -219,6 +219,18 @@ class IndexMapper {
   array<Index, NumDims> m_gpuOutputStrides;
 };
 
+// Algorithms used to evaluate a convolution on the CPU.
+enum TensorConvolutionStrategy {
+  // One multiply-add per output coefficient and kernel tap.
+  ConvolveDirect,
+  // Patches of the input are gathered into a matrix which is multiplied by a Toeplitz matrix built from the
+  // kernel with the tensor contraction kernels.
+  ConvolveIm2col,
+  // The input is split into overlapping tiles which are convolved with the kernel in the frequency domain
+  // (overlap-save).
+  ConvolveFFT
+};
+
 
 
 template<typename Dimensions, typename InputXprType, typename KernelXprType>
@@ -327,7 +339,7 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
   //===--------------------------------------------------------------------===//
 
   EIGEN_STRONG_INLINE TensorEvaluator(const XprType& op, const Device& device)
-      : m_inputImpl(op.inputExpression(), device), m_kernelImpl(op.kernelExpression(), device), m_kernelArg(op.kernelExpression()), m_kernel(NULL), m_local_kernel(false), m_device(device)
+      : m_inputImpl(op.inputExpression(), device), m_kernelImpl(op.kernelExpression(), device), m_kernelArg(op.kernelExpression()), m_result(NULL), m_kernel(NULL), m_local_kernel(false), m_device(device)
   {
     EIGEN_STATIC_ASSERT((static_cast<int>(TensorEvaluator<InputArgType, Device>::Layout) == static_cast<int>(TensorEvaluator<KernelArgType, Device>::Layout)), YOU_MADE_A_PROGRAMMING_MISTAKE);
 
@@ -360,6 +372,7 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
           m_kernelStride[0] = 1;
         }
         m_indexStride[i] = m_inputStride[index];
+        m_indices[i] = index;
       }
 
       m_outputStride[0] = 1;
@@ -379,6 +392,7 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
           m_kernelStride[NumKernelDims - 1] = 1;
         }
         m_indexStride[i] = m_inputStride[index];
+        m_indices[i] = index;
       }
 
       m_outputStride[NumDims - 1] = 1;
@@ -390,13 +404,20 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
 
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE const Dimensions& dimensions() const { return m_dimensions; }
 
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE bool evalSubExprsIfNeeded(Scalar*) {
+  EIGEN_STRONG_INLINE bool evalSubExprsIfNeeded(Scalar* data) {
     m_inputImpl.evalSubExprsIfNeeded(NULL);
     preloadKernel();
+    if (evalWithTransforms(data)) {
+      return data == NULL;
+    }
     return true;
   }
   EIGEN_STRONG_INLINE void cleanup() {
     m_inputImpl.cleanup();
+    if (m_result) {
+      m_device.deallocate_temp(m_result);
+      m_result = NULL;
+    }
     if (m_local_kernel) {
       m_device.deallocate((void*)m_kernel);
       m_local_kernel = false;
@@ -414,6 +435,9 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
 
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE CoeffReturnType coeff(Index index) const
   {
+    if (m_result) {
+      return m_result[index];
+    }
     CoeffReturnType result = CoeffReturnType(0);
     convolve(firstInput(index), 0, NumKernelDims-1, result);
     return result;
@@ -422,6 +446,9 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
   template<int LoadMode>
   EIGEN_DEVICE_FUNC PacketReturnType packet(const Index index) const
   {
+    if (m_result) {
+      return internal::ploadt<PacketReturnType, LoadMode>(m_result + index);
+    }
     Index indices[2] = {index, index+PacketSize-1};
     Index startInputs[2] = {0, 0};
     if (static_cast<int>(Layout) == static_cast<int>(ColMajor)) {
@@ -466,6 +493,9 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
 
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE TensorOpCost
   costPerCoeff(bool vectorized) const {
+    if (m_result) {
+      return TensorOpCost(sizeof(Scalar), 0, 0, vectorized, PacketSize);
+    }
     const double kernel_size = m_kernelImpl.dimensions().TotalSize();
     // We ignore the use of fused multiply-add.
     const double convolve_compute_cost =
@@ -481,9 +511,370 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
                                        PacketSize));
   }
 
-  EIGEN_DEVICE_FUNC EvaluatorPointerType data() const { return NULL; }
+  EIGEN_DEVICE_FUNC EvaluatorPointerType data() const { return m_result; }
 
  private:
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef std::complex<RealScalar> ComplexScalar;
+  // The im2col and FFT algorithms are only used for floating point coefficients.
+  static constexpr bool UseTransforms = internal::is_same<RealScalar, float>::value || internal::is_same<RealScalar, double>::value;
+
+  // Evaluates the whole convolution with the im2col or the FFT algorithm if they are estimated to be faster than
+  // the direct one, in data if it is not null, and returns whether it did.
+  EIGEN_DONT_INLINE bool evalWithTransforms(Scalar* data) {
+    const internal::TensorConvolutionStrategy strategy = chooseStrategy();
+    if (strategy == internal::ConvolveDirect) {
+      return false;
+    }
+    Scalar* result = data;
+    if (result == NULL) {
+      m_result = static_cast<Scalar*>(m_device.allocate_temp(dimensions().TotalSize() * sizeof(Scalar)));
+      result = m_result;
+    }
+    if (strategy == internal::ConvolveIm2col) {
+      evalIm2col(result);
+    } else {
+      evalFFT(result);
+    }
+    return true;
+  }
+
+  // Estimates the cost per output coefficient of each algorithm, in nanoseconds, and returns the cheapest one.
+  internal::TensorConvolutionStrategy chooseStrategy() const {
+    const double kernel_size = m_kernelImpl.dimensions().TotalSize();
+    const double total_size = m_dimensions.TotalSize();
+    if (!UseTransforms || kernel_size < 16 || kernel_size * total_size < 1e6) {
+      return internal::ConvolveDirect;
+    }
+    const double direct_cost = kernel_size * (PacketAccess ? 1.2 / PacketSize : 1.0);
+    const double im2col_cost = im2colCost();
+    array<Index, NumKernelDims> tile;
+    const double fft_cost = fftTiles(tile);
+    if (direct_cost <= im2col_cost && direct_cost <= fft_cost) {
+      return internal::ConvolveDirect;
+    }
+    return im2col_cost <= fft_cost ? internal::ConvolveIm2col : internal::ConvolveFFT;
+  }
+
+  // The im2col algorithm processes the outputs by blocks of consecutive coefficients along the convolved dimension
+  // with the smallest stride.
+  int im2colLine() const {
+    int line = 0;
+    for (int i = 1; i < NumKernelDims; ++i) {
+      if (m_indexStride[i] < m_indexStride[line]) line = i;
+    }
+    return line;
+  }
+
+  // Number of outputs per block: the power of two above the kernel size, between 16 and 64.
+  static Index im2colBlockSize(Index kernel_size, Index output_size) {
+    Index block = 16;
+    while (block < 64 && block < kernel_size) block *= 2;
+    return numext::mini(block, output_size);
+  }
+
+  double im2colCost() const {
+    const int line = im2colLine();
+    const Index kernel_size = m_kernelImpl.dimensions()[line];
+    const Index output_size = m_dimensions[m_indices[line]];
+    const Index block = im2colBlockSize(kernel_size, output_size);
+    const double depth = double(m_kernelImpl.dimensions().TotalSize() / kernel_size) * (kernel_size + block - 1);
+    // the matrix product, the gathering of the patches and the scattering of the products
+    const double block_cost = depth * block * 0.6 / PacketSize + depth * 0.3 + block * 0.5;
+    return block_cost * double(divup(output_size, block)) / double(output_size);
+  }
+
+  // Chooses the sizes of the FFT tiles along the convolved dimensions, and returns the cost per output coefficient.
+  double fftTiles(array<Index, NumKernelDims>& tile) const {
+    array<Index, NumKernelDims> min_log, max_log, log;
+    for (int i = 0; i < NumKernelDims; ++i) {
+      const Index kernel_size = m_kernelImpl.dimensions()[i];
+      const Index input_size = m_inputImpl.dimensions()[m_indices[i]];
+      min_log[i] = 0;
+      while ((Index(1) << min_log[i]) < kernel_size) ++min_log[i];
+      max_log[i] = min_log[i];
+      while ((Index(1) << max_log[i]) < input_size) ++max_log[i];
+      log[i] = min_log[i];
+    }
+    double best = NumTraits<double>::infinity();
+    for (;;) {
+      Index tile_size = 1;
+      double tiles = 1, outputs = 1, transform_cost = 0;
+      for (int i = 0; i < NumKernelDims; ++i) {
+        const Index output_size = m_dimensions[m_indices[i]];
+        const Index valid = (Index(1) << log[i]) - m_kernelImpl.dimensions()[i] + 1;
+        tile_size <<= log[i];
+        tiles *= double(divup(output_size, valid));
+        outputs *= double(output_size);
+        // the transforms along the first dimension of the tiles work on contiguous coefficients
+        transform_cost += (i == 0 ? 1.4 : 2.0) * log[i];
+      }
+      // larger tiles do not fit in the cache
+      if (tile_size <= (Index(1) << 14)) {
+        // the two transforms and the product with the spectrum of the kernel, shared by two real tiles, and the
+        // gathering and scattering of the coefficients
+        const double packing = NumTraits<Scalar>::IsComplex ? 1 : 2;
+        const double cost = tiles * tile_size * ((2 * transform_cost + 2.0) / packing + 2.5) / outputs;
+        if (cost < best) {
+          best = cost;
+          for (int i = 0; i < NumKernelDims; ++i) tile[i] = Index(1) << log[i];
+        }
+      }
+      int i = 0;
+      while (i < NumKernelDims && log[i] == max_log[i]) {
+        log[i] = min_log[i];
+        ++i;
+      }
+      if (i == NumKernelDims) break;
+      ++log[i];
+    }
+    return best;
+  }
+
+  // Splits the index of a line of output coefficients along the dimension skipped_dim into the offsets of its first
+  // coefficient in the input and in the output.
+  void lineOffsets(Index line, Index skipped_dim, Index& input_offset, Index& output_offset) const {
+    input_offset = 0;
+    output_offset = 0;
+    for (int d = 0; d < NumDims; ++d) {
+      if (d == skipped_dim) continue;
+      const Index idx = line % m_dimensions[d];
+      line /= m_dimensions[d];
+      input_offset += idx * m_inputStride[d];
+      output_offset += idx * m_outputStride[d];
+    }
+  }
+
+  template <bool Enabled = UseTransforms>
+  std::enable_if_t<!Enabled> evalIm2col(Scalar*) const {}
+  template <bool Enabled = UseTransforms>
+  std::enable_if_t<!Enabled> evalFFT(Scalar*) const {}
+
+  // Each column of the patch matrix holds the input coefficients needed by a block of consecutive outputs along the
+  // line dimension, for all the taps of the kernel along the other dimensions. The products of these patches with a
+  // Toeplitz matrix holding the kernel are the blocks of outputs.
+  template <bool Enabled = UseTransforms>
+  std::enable_if_t<Enabled> evalIm2col(Scalar* result) const {
+    typedef Tensor<Scalar, 2, ColMajor, Index> Matrix2;
+    typedef TensorMap<Matrix2> MapType;
+    const int line = im2colLine();
+    const Index line_dim = m_indices[line];
+    const Index kernel_size = m_kernelImpl.dimensions()[line];
+    const Index input_size = m_inputImpl.dimensions()[line_dim];
+    const Index output_size = m_dimensions[line_dim];
+    const Index input_stride = m_inputStride[line_dim];
+    const Index output_stride = m_outputStride[line_dim];
+    const Index block = im2colBlockSize(kernel_size, output_size);
+    const Index span = kernel_size + block - 1;
+    const Index taps = m_kernelImpl.dimensions().TotalSize() / kernel_size;
+    const Index depth = taps * span;
+    const Index blocks = divup(output_size, block);
+    const Index num_cols = (m_dimensions.TotalSize() / output_size) * blocks;
+
+    // offsets of the taps of the kernel along the other convolved dimensions
+    std::vector<Index> tap_input(taps), tap_kernel(taps);
+    for (Index t = 0; t < taps; ++t) {
+      Index rem = t;
+      tap_input[t] = 0;
+      tap_kernel[t] = 0;
+      for (int i = 0; i < NumKernelDims; ++i) {
+        if (i == line) continue;
+        const Index k = rem % m_kernelImpl.dimensions()[i];
+        rem /= m_kernelImpl.dimensions()[i];
+        tap_input[t] += k * m_indexStride[i];
+        tap_kernel[t] += k * m_kernelStride[i];
+      }
+    }
+    Matrix2 toeplitz(block, depth);
+    toeplitz.setZero();
+    for (Index t = 0; t < taps; ++t) {
+      for (Index r = 0; r < block; ++r) {
+        for (Index k = 0; k < kernel_size; ++k) {
+          toeplitz(r, t * span + r + k) = m_kernel[tap_kernel[t] + k * m_kernelStride[line]];
+        }
+      }
+    }
+
+    const Index chunk_cols = numext::maxi<Index>(1, numext::mini<Index>(num_cols, (Index(1) << 20) / depth));
+    Matrix2 patches(depth, chunk_cols), products(block, chunk_cols);
+    const array<IndexPair<Index>, 1> contract_dims = {IndexPair<Index>(1, 0)};
+    for (Index first = 0; first < num_cols; first += chunk_cols) {
+      const Index cols = numext::mini(chunk_cols, num_cols - first);
+      internal::device_parallel_for(m_device, cols, TensorOpCost(depth * sizeof(Scalar), depth * sizeof(Scalar), depth),
+                                         [&](Index begin, Index end) {
+        for (Index c = begin; c < end; ++c) {
+          Index input_offset, output_offset;
+          lineOffsets((first + c) / blocks, line_dim, input_offset, output_offset);
+          const Index start = ((first + c) % blocks) * block;
+          const Index size = numext::mini(span, input_size - start);
+          Scalar* patch = patches.data() + c * depth;
+          for (Index t = 0; t < taps; ++t, patch += span) {
+            const Index offset = input_offset + tap_input[t] + start * input_stride;
+            for (Index j = 0; j < size; ++j) patch[j] = m_inputImpl.coeff(offset + j * input_stride);
+            for (Index j = size; j < span; ++j) patch[j] = Scalar(0);
+          }
+        }
+      });
+      MapType(products.data(), block, cols).device(m_device) = toeplitz.contract(MapType(patches.data(), depth, cols), contract_dims);
+      internal::device_parallel_for(m_device, cols, TensorOpCost(block * sizeof(Scalar), block * sizeof(Scalar), block),
+                                         [&](Index begin, Index end) {
+        for (Index c = begin; c < end; ++c) {
+          Index input_offset, output_offset;
+          lineOffsets((first + c) / blocks, line_dim, input_offset, output_offset);
+          const Index start = ((first + c) % blocks) * block;
+          const Index size = numext::mini(block, output_size - start);
+          const Scalar* product = products.data() + c * block;
+          for (Index j = 0; j < size; ++j) result[output_offset + (start + j) * output_stride] = product[j];
+        }
+      });
+    }
+  }
+
+  template <typename T>
+  static std::enable_if_t<NumTraits<T>::IsComplex, T> fromComplex(const ComplexScalar& x) { return x; }
+  template <typename T>
+  static std::enable_if_t<!NumTraits<T>::IsComplex, T> fromComplex(const ComplexScalar& x) { return x.real(); }
+
+  // Overlap-save: the input is split into tiles overlapping by the size of the kernel minus one along each convolved
+  // dimension. The circular convolution of a tile with the reversed kernel, computed by FFT, holds the outputs whose
+  // inputs all lie in the tile. Real tiles are transformed by pairs, as the real and imaginary parts of a complex one.
+  template <bool Enabled = UseTransforms>
+  std::enable_if_t<Enabled> evalFFT(Scalar* result) const {
+    typedef Tensor<ComplexScalar, NumKernelDims, ColMajor, Index> Tile;
+    typedef Tensor<ComplexScalar, NumKernelDims + 1, ColMajor, Index> Tiles;
+    array<Index, NumKernelDims> tile, valid, grid;
+    fftTiles(tile);
+    Index tile_size = 1, num_tiles = m_dimensions.TotalSize();
+    array<int, NumKernelDims> fft_dims;
+    for (int i = 0; i < NumKernelDims; ++i) {
+      const Index output_size = m_dimensions[m_indices[i]];
+      valid[i] = tile[i] - m_kernelImpl.dimensions()[i] + 1;
+      grid[i] = divup(output_size, valid[i]);
+      tile_size *= tile[i];
+      num_tiles = num_tiles / output_size * grid[i];
+      fft_dims[i] = i;
+    }
+
+    Tile reversed_kernel(tile);
+    reversed_kernel.setZero();
+    for (Index k = 0; k < m_kernelImpl.dimensions().TotalSize(); ++k) {
+      Index rem = k, kernel_offset = 0, tile_offset = 0, tile_stride = 1;
+      for (int i = 0; i < NumKernelDims; ++i) {
+        const Index kernel_size = m_kernelImpl.dimensions()[i];
+        const Index idx = rem % kernel_size;
+        rem /= kernel_size;
+        kernel_offset += idx * m_kernelStride[i];
+        tile_offset += (kernel_size - 1 - idx) * tile_stride;
+        tile_stride *= tile[i];
+      }
+      reversed_kernel.data()[tile_offset] = ComplexScalar(m_kernel[kernel_offset]);
+    }
+    const Tile spectrum = reversed_kernel.template fft<BothParts, FFT_FORWARD>(fft_dims);
+
+    // Splits the index of a tile into its position in the grid of tiles and the offsets of its first input and
+    // output coefficients.
+    auto tile_offsets = [&](Index t, array<Index, NumKernelDims>& start, Index& input_offset, Index& output_offset) {
+      for (int i = 0; i < NumKernelDims; ++i) {
+        start[i] = (t % grid[i]) * valid[i];
+        t /= grid[i];
+      }
+      input_offset = 0;
+      output_offset = 0;
+      for (int d = 0; d < NumDims; ++d) {
+        Index idx = 0;
+        bool convolved = false;
+        for (int i = 0; i < NumKernelDims; ++i) {
+          if (m_indices[i] == d) {
+            idx = start[i];
+            convolved = true;
+          }
+        }
+        if (!convolved) {
+          idx = t % m_dimensions[d];
+          t /= m_dimensions[d];
+        }
+        input_offset += idx * m_inputStride[d];
+        output_offset += idx * m_outputStride[d];
+      }
+    };
+
+    const Index rows = tile_size / tile[0];
+    const Index packing = NumTraits<Scalar>::IsComplex ? 1 : 2;
+    const Index chunk_tiles = numext::maxi<Index>(1, (Index(1) << 18) / tile_size);
+    const Index num_chunks = divup(num_tiles, chunk_tiles);
+    double log_size = 0;
+    for (Index size = tile_size; size > 1; size >>= 1) ++log_size;
+    const TensorOpCost chunk_cost(chunk_tiles * tile_size * sizeof(Scalar), chunk_tiles * tile_size * sizeof(Scalar),
+                                  chunk_tiles * tile_size * 10 * log_size);
+    internal::device_parallel_for(m_device, num_chunks, chunk_cost, [&](Index begin, Index end) {
+      array<Index, NumKernelDims + 1> tiles_dims;
+      for (int i = 0; i < NumKernelDims; ++i) tiles_dims[i] = tile[i];
+      for (Index chunk = begin; chunk < end; ++chunk) {
+        const Index first = chunk * chunk_tiles;
+        const Index count = numext::mini(chunk_tiles, num_tiles - first);
+        tiles_dims[NumKernelDims] = divup(count, packing);
+        Tiles x(tiles_dims);
+        x.setZero();
+        for (Index t = 0; t < count; ++t) {
+          array<Index, NumKernelDims> start;
+          Index input_offset, output_offset;
+          tile_offsets(first + t, start, input_offset, output_offset);
+          const Index part = t % packing;
+          ComplexScalar* dst = x.data() + (t / packing) * tile_size;
+          for (Index row = 0; row < rows; ++row, dst += tile[0]) {
+            Index rem = row, offset = input_offset, size = m_inputImpl.dimensions()[m_indices[0]] - start[0];
+            for (int i = 1; i < NumKernelDims; ++i) {
+              const Index idx = rem % tile[i];
+              rem /= tile[i];
+              if (start[i] + idx >= m_inputImpl.dimensions()[m_indices[i]]) size = 0;
+              offset += idx * m_inputStride[m_indices[i]];
+            }
+            size = numext::maxi<Index>(0, numext::mini(size, tile[0]));
+            for (Index j = 0; j < size; ++j) {
+              const Scalar value = m_inputImpl.coeff(offset + j * m_inputStride[m_indices[0]]);
+              if (packing == 1) {
+                dst[j] = ComplexScalar(value);
+              } else {
+                reinterpret_cast<RealScalar*>(dst)[2 * j + part] = numext::real(value);
+              }
+            }
+          }
+        }
+        Tiles y = x.template fft<BothParts, FFT_FORWARD>(fft_dims);
+        for (Index t = 0; t < tiles_dims[NumKernelDims]; ++t) {
+          ComplexScalar* dst = y.data() + t * tile_size;
+          for (Index j = 0; j < tile_size; ++j) dst[j] *= spectrum.data()[j];
+        }
+        x = y.template fft<BothParts, FFT_REVERSE>(fft_dims);
+        for (Index t = 0; t < count; ++t) {
+          array<Index, NumKernelDims> start;
+          Index input_offset, output_offset;
+          tile_offsets(first + t, start, input_offset, output_offset);
+          const Index part = t % packing;
+          const ComplexScalar* src = x.data() + (t / packing) * tile_size;
+          for (Index row = 0; row < rows; ++row, src += tile[0]) {
+            Index rem = row, offset = output_offset;
+            bool inside = true;
+            for (int i = 1; i < NumKernelDims; ++i) {
+              const Index idx = rem % tile[i] - (m_kernelImpl.dimensions()[i] - 1);
+              rem /= tile[i];
+              if (idx < 0 || start[i] + idx >= m_dimensions[m_indices[i]]) inside = false;
+              offset += idx * m_outputStride[m_indices[i]];
+            }
+            if (!inside) continue;
+            const Index first_valid = m_kernelImpl.dimensions()[0] - 1;
+            const Index size = numext::mini(valid[0], m_dimensions[m_indices[0]] - start[0]);
+            for (Index j = 0; j < size; ++j) {
+              const ComplexScalar& value = src[first_valid + j];
+              result[offset + j * m_outputStride[m_indices[0]]] =
+                  packing == 1 ? fromComplex<Scalar>(value) : Scalar(part == 0 ? value.real() : value.imag());
+            }
+          }
+        }
+      }
+    });
+  }
+
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Index firstInput(Index index) const {
     Index startInput = 0;
     if (static_cast<int>(Layout) == static_cast<int>(ColMajor)) {
@@ -504,27 +895,33 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
   }
 
   EIGEN_DEVICE_FUNC void convolve(Index firstIndex, Index firstKernel, int DimIndex, CoeffReturnType& accum) const {
-    for (int j = 0; j < m_kernelImpl.dimensions()[DimIndex]; ++j) {
-      const Index input = firstIndex + j * m_indexStride[DimIndex];
-      const Index kernel = firstKernel + j * m_kernelStride[DimIndex];
-      if (DimIndex > 0) {
-        convolve(input, kernel, DimIndex-1, accum);
-      } else {
-        accum += m_inputImpl.coeff(input) * m_kernel[kernel];
+    if (DimIndex > 0) {
+      for (int j = 0; j < m_kernelImpl.dimensions()[DimIndex]; ++j) {
+        convolve(firstIndex + j * m_indexStride[DimIndex], firstKernel + j * m_kernelStride[DimIndex], DimIndex-1, accum);
+      }
+    } else {
+      // Accumulate in a local variable, which stays in a register even if this function is not inlined.
+      CoeffReturnType sum = accum;
+      for (int j = 0; j < m_kernelImpl.dimensions()[0]; ++j) {
+        sum += m_inputImpl.coeff(firstIndex + j * m_indexStride[0]) * m_kernel[firstKernel + j * m_kernelStride[0]];
       }
+      accum = sum;
     }
   }
 
   template <typename Packet>
   EIGEN_DEVICE_FUNC void convolvePacket(Index firstIndex, Index firstKernel, int DimIndex, Packet& accum) const {
-    for (int j = 0; j < m_kernelImpl.dimensions()[DimIndex]; ++j) {
-      const Index input = firstIndex + j * m_indexStride[DimIndex];
-      const Index kernel = firstKernel + j * m_kernelStride[DimIndex];
-      if (DimIndex > 0) {
-        convolvePacket(input, kernel, DimIndex-1, accum);
-      } else {
-        accum = internal::pmadd<Packet>(m_inputImpl.template packet<Unaligned>(input), internal::pset1<Packet>(m_kernel[kernel]), accum);
+    if (DimIndex > 0) {
+      for (int j = 0; j < m_kernelImpl.dimensions()[DimIndex]; ++j) {
+        convolvePacket(firstIndex + j * m_indexStride[DimIndex], firstKernel + j * m_kernelStride[DimIndex], DimIndex-1, accum);
+      }
+    } else {
+      Packet sum = accum;
+      for (int j = 0; j < m_kernelImpl.dimensions()[0]; ++j) {
+        sum = internal::pmadd<Packet>(m_inputImpl.template packet<Unaligned>(firstIndex + j * m_indexStride[0]),
+                                      internal::pset1<Packet>(m_kernel[firstKernel + j * m_kernelStride[0]]), sum);
       }
+      accum = sum;
     }
   }
 
@@ -553,11 +950,13 @@ struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelAr
 
   array<Index, NumKernelDims> m_indexStride;
   array<Index, NumKernelDims> m_kernelStride;
+  array<Index, NumKernelDims> m_indices;
   TensorEvaluator<InputArgType, Device> m_inputImpl;
   TensorEvaluator<KernelArgType, Device> m_kernelImpl;
   Dimensions m_dimensions;
 
   KernelArgType m_kernelArg;
+  Scalar* m_result;
   const Scalar* m_kernel;
   bool m_local_kernel;
   const Device EIGEN_DEVICE_REF m_device;
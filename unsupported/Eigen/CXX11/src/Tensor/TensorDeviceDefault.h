@@ -120,6 +120,17 @@ struct DefaultDevice {
   }
 };
 
+namespace internal {
+
+// Calls f(first, last) on sub-ranges covering [0, n). The ThreadPoolDevice
+// overload runs them concurrently, other devices call f(0, n) on the host.
+template <typename Device, typename Index, typename Func>
+void device_parallel_for(const Device&, Index n, const TensorOpCost&, const Func& f) {
+  f(0, n);
+}
+
+}  // namespace internal
+
 }  // namespace Eigen
 
 #endif // EIGEN_CXX11_TENSOR_TENSOR_DEVICE_DEFAULT_H
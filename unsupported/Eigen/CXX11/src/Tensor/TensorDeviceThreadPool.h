@@ -51,15 +51,26 @@ class Allocator {
   virtual void deallocate(void* buffer) const = 0;
 };
 
+// The time per iteration measured by the adaptive parallelFor, which replaces
+// the estimated cost in the following calls sharing the same feedback (see
+// ThreadPoolDevice::setAdaptiveScheduling()). Zero until the first measurement.
+struct ParallelForFeedback {
+  ParallelForFeedback() : ns_per_item(0) {}
+  std::atomic<double> ns_per_item;
+};
+
 // Build a thread pool device on top the an existing pool of threads.
 struct ThreadPoolDevice {
   // The ownership of the thread pool remains with the caller.
   ThreadPoolDevice(ThreadPoolInterface* pool, int num_cores, Allocator* allocator = nullptr)
-      : pool_(pool), num_threads_(num_cores), allocator_(allocator) { }
+      : pool_(pool), num_threads_(num_cores), allocator_(allocator), adaptive_(false) { }
 
+  // Without allocator, the pages of the buffers are placed by the operating
+  // system when they are first touched, so that the buffers filled by the
+  // threads of a NUMA aware pool use the memory of their node.
   EIGEN_STRONG_INLINE void* allocate(size_t num_bytes) const {
     return allocator_ ? allocator_->allocate(num_bytes)
-        : internal::aligned_malloc(num_bytes);
+                      : internal::aligned_malloc(num_bytes);
   }
 
   EIGEN_STRONG_INLINE void deallocate(void* buffer) const {
@@ -133,12 +144,33 @@ struct ThreadPoolDevice {
     return num_threads_;
   }
 
+  // In the adaptive scheduling mode, parallelFor splits the iteration range
+  // between the threads, which take small blocks from their own range and
+  // steal half of the remaining range of another thread once theirs is empty,
+  // so that unbalanced blocks are redistributed while the loop runs. The time
+  // spent per iteration is measured, and used instead of the cost model by the
+  // next evaluations of the same expression.
+  void setAdaptiveScheduling(bool adaptive) { adaptive_ = adaptive; }
+
+  EIGEN_STRONG_INLINE bool adaptiveScheduling() const { return adaptive_; }
+
   // Number of theads available in the underlying thread pool. This number can
   // be different from the value returned by numThreads().
   EIGEN_STRONG_INLINE int numThreadsInPool() const {
     return pool_->NumThreads();
   }
 
+  // Number of NUMA nodes the threads of the underlying pool are spread over.
+  EIGEN_STRONG_INLINE int numNumaNodes() const {
+    return pool_->NumNumaNodes();
+  }
+
+  // NUMA node of the calling thread if it is a thread of a NUMA aware pool,
+  // -1 otherwise.
+  EIGEN_STRONG_INLINE int numaNode() const {
+    return pool_->CurrentNumaNode();
+  }
+
   EIGEN_STRONG_INLINE size_t firstLevelCacheSize() const {
     return l1CacheSize();
   }
@@ -198,9 +230,27 @@ struct ThreadPoolDevice {
   // size is chosen based on the iteration cost and resulting parallel
   // efficiency. If block_align is not nullptr, it is called to round up the
   // block size.
+  //
+  // In the adaptive scheduling mode, the time per iteration measured on the
+  // previous calls with the same feedback replaces cost, and is updated.
+  void parallelFor(Index n, const TensorOpCost& cost,
+                   std::function<Index(Index)> block_align,
+                   std::function<void(Index, Index)> f,
+                   ParallelForFeedback* feedback) const {
+    if (adaptive_) {
+      parallelForAdaptive(n, cost, std::move(block_align), std::move(f), feedback);
+      return;
+    }
+    parallelFor(n, cost, std::move(block_align), std::move(f));
+  }
+
   void parallelFor(Index n, const TensorOpCost& cost,
                    std::function<Index(Index)> block_align,
                    std::function<void(Index, Index)> f) const {
+    if (adaptive_) {
+      parallelForAdaptive(n, cost, std::move(block_align), std::move(f), nullptr);
+      return;
+    }
     if (EIGEN_PREDICT_FALSE(n <= 0)){
       return;
     // Compute small problems directly in the caller thread.
@@ -321,6 +371,102 @@ struct ThreadPoolDevice {
  private:
   typedef TensorCostModel<ThreadPoolDevice> CostModel;
 
+  // Assumed clock rate to convert measured times into costs.
+  static constexpr double kCyclesPerNanosecond = 3.0;
+
+  // Range [begin, end) of blocks left to the thread using this slot.
+  struct AdaptiveRange {
+    std::mutex mu;
+    Index begin = 0;
+    Index end = 0;
+  };
+
+  void parallelForAdaptive(Index n, const TensorOpCost& cost,
+                           std::function<Index(Index)> block_align,
+                           std::function<void(Index, Index)> f,
+                           ParallelForFeedback* feedback) const {
+    if (EIGEN_PREDICT_FALSE(n <= 0)) return;
+    typedef std::chrono::steady_clock Clock;
+
+    const double measured = feedback ? feedback->ns_per_item.load(std::memory_order_relaxed) : 0.0;
+    const TensorOpCost item_cost =
+        measured > 0 ? TensorOpCost(0, 0, measured * kCyclesPerNanosecond) : cost;
+
+    // Blocks of about CostModel::kTaskSize cycles, which are the unit of work
+    // taken by the threads.
+    Index block_size = numext::mini(
+        n, numext::maxi<Index>(1, static_cast<Index>(1.0 / CostModel::taskSize(1, item_cost))));
+    if (block_align) {
+      block_size = numext::mini(n, block_align(block_size));
+    }
+    const Index block_count = divup(n, block_size);
+    const int threads = static_cast<int>(numext::mini<Index>(
+        block_count, CostModel::numThreads(n, item_cost, static_cast<int>(numThreads()))));
+
+    std::atomic<int64_t> busy_ns(0);
+    if (threads <= 1) {
+      const Clock::time_point start = Clock::now();
+      f(0, n);
+      busy_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    } else {
+      std::unique_ptr<AdaptiveRange[]> ranges(new AdaptiveRange[threads]);
+      for (int t = 0; t < threads; ++t) {
+        ranges[t].begin = block_count * t / threads;
+        ranges[t].end = block_count * (t + 1) / threads;
+      }
+
+      auto work = [&ranges, &busy_ns, &f, threads, block_size, n](int t) {
+        const Clock::time_point start = Clock::now();
+        AdaptiveRange& own = ranges[t];
+        for (;;) {
+          Index block = -1;
+          {
+            std::lock_guard<std::mutex> lock(own.mu);
+            if (own.begin < own.end) block = own.begin++;
+          }
+          if (block < 0) {
+            // Steal the second half of the remaining blocks of another thread.
+            for (int i = 1; i < threads && block < 0; ++i) {
+              AdaptiveRange& victim = ranges[(t + i) % threads];
+              Index first, last;
+              {
+                std::lock_guard<std::mutex> lock(victim.mu);
+                if (victim.begin >= victim.end) continue;
+                last = victim.end;
+                first = victim.end - divup<Index>(victim.end - victim.begin, 2);
+                victim.end = first;
+              }
+              std::lock_guard<std::mutex> lock(own.mu);
+              own.begin = first + 1;
+              own.end = last;
+              block = first;
+            }
+            if (block < 0) break;
+          }
+          f(block * block_size, numext::mini(n, (block + 1) * block_size));
+        }
+        busy_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+      };
+
+      Barrier barrier(static_cast<unsigned int>(threads - 1));
+      for (int t = 1; t < threads; ++t) {
+        pool_->Schedule([&work, &barrier, t]() {
+          work(t);
+          barrier.Notify();
+        });
+      }
+      work(0);
+      barrier.Wait();
+    }
+
+    if (feedback) {
+      const double ns_per_item = static_cast<double>(busy_ns.load()) / static_cast<double>(n);
+      const double previous = feedback->ns_per_item.load(std::memory_order_relaxed);
+      feedback->ns_per_item.store(previous > 0 ? 0.5 * (previous + ns_per_item) : ns_per_item,
+                                  std::memory_order_relaxed);
+    }
+  }
+
   // For parallelForAsync we must keep passed in closures on the heap, and
   // delete them only after `done` callback finished.
   struct ParallelForAsyncContext {
@@ -412,8 +558,17 @@ struct ThreadPoolDevice {
   ThreadPoolInterface* pool_;
   int num_threads_;
   Allocator* allocator_;
+  bool adaptive_;
 };
 
+namespace internal {
+
+template <typename Index, typename Func>
+void device_parallel_for(const ThreadPoolDevice& device, Index n, const TensorOpCost& cost, const Func& f) {
+  device.parallelFor(n, cost, [&f](Index first, Index last) { f(first, last); });
+}
+
+}  // namespace internal
 
 }  // end namespace Eigen
 
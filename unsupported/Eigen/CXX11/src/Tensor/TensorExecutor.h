@@ -339,10 +339,19 @@ class TensorExecutor<Expression, ThreadPoolDevice, Vectorizable, Tiling> {
                          EvalRange::alignBlockSize,
                          [&evaluator](StorageIndex firstIdx, StorageIndex lastIdx) {
                            EvalRange::run(&evaluator, firstIdx, lastIdx);
-                         });
+                         },
+                         &feedback());
     }
     evaluator.cleanup();
   }
+
+ private:
+  // Measured cost of the evaluations of this expression type in the adaptive
+  // scheduling mode.
+  static ParallelForFeedback& feedback() {
+    static ParallelForFeedback feedback;
+    return feedback;
+  }
 };
 
 template <typename Expression, bool Vectorizable>
@@ -393,11 +402,19 @@ class TensorExecutor<Expression, ThreadPoolDevice, Vectorizable,
         evaluator.evalBlock(desc, scratch);
       } else {
         device.parallelFor(tiling.block_mapper.blockCount(), tiling.cost,
-                           eval_block);
+                           nullptr, eval_block, &feedback());
       }
     }
     evaluator.cleanup();
   }
+
+ private:
+  // Measured cost per block of the evaluations of this expression type in the
+  // adaptive scheduling mode.
+  static ParallelForFeedback& feedback() {
+    static ParallelForFeedback feedback;
+    return feedback;
+  }
 };
 
 template <typename Expression, typename DoneCallback, bool Vectorizable,
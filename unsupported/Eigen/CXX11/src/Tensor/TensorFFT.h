@@ -21,7 +21,6 @@ namespace Eigen {
   *
   * TODO:
   * Vectorize the Cooley Tukey and the Bluestein algorithm
-  * Add support for multithreaded evaluation
   * Improve the performance on GPU
   */
 
@@ -82,6 +81,76 @@ struct nested<TensorFFTOp<FFT, XprType, FFTResultType, FFTDirection>, 1, typenam
   typedef TensorFFTOp<FFT, XprType, FFTResultType, FFTDirection> type;
 };
 
+// Tables used by the transforms of the lines of a given length.
+template <typename RealScalar>
+struct TensorFFTPlan {
+  typedef std::complex<RealScalar> ComplexScalar;
+  // Length of the power of two transforms: the line length, or the padding
+  // length of Bluestein's algorithm.
+  Index fft_len;
+  Index log_len;
+  // twiddles[l/2 + k] = exp(-2*pi*sqrt(-1)*k/l) for the powers of two l <= fft_len.
+  std::vector<ComplexScalar> twiddles;
+  // Bluestein's algorithm only: the chirp exp(sqrt(-1)*pi*j^2/line_len), and
+  // the transforms of the sequences the lines are convolved with, indexed by
+  // FFTDirection.
+  std::vector<ComplexScalar> chirp;
+  std::vector<ComplexScalar> chirp_spectrum[2];
+};
+
+// Process wide cache of the TensorFFTPlans, shared by the evaluations of all the
+// FFT expressions. Plans are immutable once built, so several threads can use
+// the same plan concurrently.
+template <typename RealScalar>
+class TensorFFTPlanCache {
+ public:
+  typedef TensorFFTPlan<RealScalar> Plan;
+
+  // Returns the plan for the lines of length line_len, and builds it with
+  // make_plan(line_len) if it isn't in the cache.
+  template <typename MakePlan>
+  static std::shared_ptr<const Plan> get(Index line_len, MakePlan make_plan) {
+    State& state = instance();
+    {
+      std::lock_guard<std::mutex> lock(state.mutex);
+      typename PlanMap::const_iterator it = state.plans.find(line_len);
+      if (it != state.plans.end()) return it->second;
+    }
+
+    // Build the plan without holding the lock.
+    std::shared_ptr<const Plan> plan = std::make_shared<const Plan>(make_plan(line_len));
+    const Index plan_size = static_cast<Index>(plan->twiddles.size() + plan->chirp.size()) + 2 * plan->fft_len;
+    if (plan_size > kMaxCachedSize) return plan;
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.plans.size() >= kMaxCachedPlans || state.cached_size + plan_size > kMaxCachedSize) {
+      state.plans.clear();
+      state.cached_size = 0;
+    }
+    std::pair<typename PlanMap::iterator, bool> inserted = state.plans.insert(std::make_pair(line_len, plan));
+    if (inserted.second) state.cached_size += plan_size;
+    return inserted.first->second;
+  }
+
+ private:
+  typedef std::map<Index, std::shared_ptr<const Plan> > PlanMap;
+  // Bounds on the number of plans, and on their total number of coefficients.
+  static const size_t kMaxCachedPlans = 64;
+  static const Index kMaxCachedSize = Index(1) << 22;
+
+  struct State {
+    State() : cached_size(0) {}
+    std::mutex mutex;
+    PlanMap plans;
+    Index cached_size;
+  };
+
+  static State& instance() {
+    static State state;
+    return state;
+  }
+};
+
 }  // end namespace internal
 
 template <typename FFT, typename XprType, int FFTResultType, int FFTDir>
@@ -215,108 +284,146 @@ struct TensorEvaluator<const TensorFFTOp<FFT, ArgType, FFTResultType, FFTDir>, D
 #endif
 
  private:
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void evalToBuf(EvaluatorPointerType data) {
+  typedef internal::TensorFFTPlan<RealScalar> Plan;
+
+  void evalToBuf(EvaluatorPointerType data) {
     const bool write_to_out = internal::is_same<OutputScalar, ComplexScalar>::value;
     ComplexScalar* buf = write_to_out ? (ComplexScalar*)data : (ComplexScalar*)m_device.allocate(sizeof(ComplexScalar) * m_size);
 
-    for (Index i = 0; i < m_size; ++i) {
-      buf[i] = MakeComplex<internal::is_same<InputScalar, RealScalar>::value>()(m_impl.coeff(i));
-    }
+    internal::device_parallel_for(m_device, m_size, m_impl.costPerCoeff(false) + TensorOpCost(0, sizeof(ComplexScalar), 0),
+                                  [&](Index first, Index last) {
+      for (Index i = first; i < last; ++i) {
+        buf[i] = MakeComplex<internal::is_same<InputScalar, RealScalar>::value>()(m_impl.coeff(i));
+      }
+    });
 
     for (size_t i = 0; i < m_fft.size(); ++i) {
       Index dim = m_fft[i];
       eigen_assert(dim >= 0 && dim < NumDims);
-      Index line_len = m_dimensions[dim];
+      const Index line_len = m_dimensions[dim];
       eigen_assert(line_len >= 1);
-      ComplexScalar* line_buf = (ComplexScalar*)m_device.allocate(sizeof(ComplexScalar) * line_len);
+      const Index stride = m_strides[dim];
       const bool is_power_of_two = isPowerOfTwo(line_len);
-      const Index good_composite = is_power_of_two ? 0 : findGoodComposite(line_len);
-      const Index log_len = is_power_of_two ? getLog2(line_len) : getLog2(good_composite);
-
-      ComplexScalar* a = is_power_of_two ? NULL : (ComplexScalar*)m_device.allocate(sizeof(ComplexScalar) * good_composite);
-      ComplexScalar* b = is_power_of_two ? NULL : (ComplexScalar*)m_device.allocate(sizeof(ComplexScalar) * good_composite);
-      ComplexScalar* pos_j_base_powered = is_power_of_two ? NULL : (ComplexScalar*)m_device.allocate(sizeof(ComplexScalar) * (line_len + 1));
-      if (!is_power_of_two) {
-        // Compute twiddle factors
-        //   t_n = exp(sqrt(-1) * pi * n^2 / line_len)
-        // for n = 0, 1,..., line_len-1.
-        // For n > 2 we use the recurrence t_n = t_{n-1}^2 / t_{n-2} * t_1^2
-
-        // The recurrence is correct in exact arithmetic, but causes
-        // numerical issues for large transforms, especially in
-        // single-precision floating point.
-        //
-        // pos_j_base_powered[0] = ComplexScalar(1, 0);
-        // if (line_len > 1) {
-        //   const ComplexScalar pos_j_base = ComplexScalar(
-        //       numext::cos(M_PI / line_len), numext::sin(M_PI / line_len));
-        //   pos_j_base_powered[1] = pos_j_base;
-        //   if (line_len > 2) {
-        //     const ComplexScalar pos_j_base_sq = pos_j_base * pos_j_base;
-        //     for (int i = 2; i < line_len + 1; ++i) {
-        //       pos_j_base_powered[i] = pos_j_base_powered[i - 1] *
-        //           pos_j_base_powered[i - 1] /
-        //           pos_j_base_powered[i - 2] *
-        //           pos_j_base_sq;
-        //     }
-        //   }
-        // }
-        // TODO(rmlarsen): Find a way to use Eigen's vectorized sin
-        // and cosine functions here.
-        for (int j = 0; j < line_len + 1; ++j) {
-          double arg = ((EIGEN_PI * j) * j) / line_len;
-          std::complex<double> tmp(numext::cos(arg), numext::sin(arg));
-          pos_j_base_powered[j] = static_cast<ComplexScalar>(tmp);
-        }
-      }
+      // The twiddle factors (and the chirp for Bluestein's algorithm) only
+      // depend on the line length, and are shared by all the evaluations.
+      const std::shared_ptr<const Plan> plan = internal::TensorFFTPlanCache<RealScalar>::get(line_len, &makePlan);
+      const Index fft_len = static_cast<Index>(plan->fft_len);
+      const ComplexScalar* twiddles = plan->twiddles.data();
+      const ComplexScalar* chirp = plan->chirp.data();
+      const ComplexScalar* chirp_spectrum = is_power_of_two ? NULL : plan->chirp_spectrum[FFTDir].data();
+
+      // The lines are independent, and are distributed over the threads of
+      // the device. Each range of lines uses its own scratch buffers.
+      const double line_bytes = static_cast<double>(2 * line_len * sizeof(ComplexScalar));
+      const TensorOpCost line_cost(line_bytes, line_bytes, (is_power_of_two ? 5.0 : 10.0) * fft_len * plan->log_len);
+      internal::device_parallel_for(m_device, m_size / line_len, line_cost, [&](Index first, Index last) {
+        ComplexScalar* line_buf = stride == 1 ? NULL : (ComplexScalar*)m_device.allocate(sizeof(ComplexScalar) * line_len);
+        ComplexScalar* a = is_power_of_two ? NULL : (ComplexScalar*)m_device.allocate(sizeof(ComplexScalar) * fft_len);
+
+        for (Index partial_index = first; partial_index < last; ++partial_index) {
+          const Index base_offset = getBaseOffsetFromIndex(partial_index, dim);
+
+          // Contiguous lines are transformed in place, the others are
+          // gathered into line_buf.
+          ComplexScalar* line = stride == 1 ? &buf[base_offset] : line_buf;
+          if (stride != 1) {
+            Index offset = base_offset;
+            for (Index j = 0; j < line_len; ++j, offset += stride) {
+              line_buf[j] = buf[offset];
+            }
+          }
 
-      for (Index partial_index = 0; partial_index < m_size / line_len; ++partial_index) {
-        const Index base_offset = getBaseOffsetFromIndex(partial_index, dim);
-
-        // get data into line_buf
-        const Index stride = m_strides[dim];
-        if (stride == 1) {
-          m_device.memcpy(line_buf, &buf[base_offset], line_len*sizeof(ComplexScalar));
-        } else {
-          Index offset = base_offset;
-          for (int j = 0; j < line_len; ++j, offset += stride) {
-            line_buf[j] = buf[offset];
+          // process the line
+          if (is_power_of_two) {
+            processDataLineCooleyTukey(line, line_len, twiddles);
+          }
+          else {
+            processDataLineBluestein(line, line_len, fft_len, a, twiddles, chirp, chirp_spectrum);
           }
-        }
 
-        // process the line
-        if (is_power_of_two) {
-          processDataLineCooleyTukey(line_buf, line_len, log_len);
-        }
-        else {
-          processDataLineBluestein(line_buf, line_len, good_composite, log_len, a, b, pos_j_base_powered);
+          // write back
+          if (FFTDir == FFT_REVERSE || stride != 1) {
+            Index offset = base_offset;
+            const RealScalar div_factor = RealScalar(1) / RealScalar(line_len);
+            for (Index j = 0; j < line_len; ++j, offset += stride) {
+              buf[offset] = (FFTDir == FFT_FORWARD) ? line[j] : line[j] * div_factor;
+            }
+          }
         }
 
-        // write back
-        if (FFTDir == FFT_FORWARD && stride == 1) {
-          m_device.memcpy(&buf[base_offset], line_buf, line_len*sizeof(ComplexScalar));
-        } else {
-          Index offset = base_offset;
-          const ComplexScalar div_factor =  ComplexScalar(1.0 / line_len, 0);
-          for (int j = 0; j < line_len; ++j, offset += stride) {
-             buf[offset] = (FFTDir == FFT_FORWARD) ? line_buf[j] : line_buf[j] * div_factor;
-          }
+        if (line_buf) m_device.deallocate(line_buf);
+        if (a) m_device.deallocate(a);
+      });
+    }
+
+    if(!write_to_out) {
+      internal::device_parallel_for(m_device, m_size, TensorOpCost(sizeof(ComplexScalar), sizeof(OutputScalar), 0),
+                                    [&](Index first, Index last) {
+        for (Index i = first; i < last; ++i) {
+          data[i] = PartOf<FFTResultType>()(buf[i]);
         }
-      }
-      m_device.deallocate(line_buf);
-      if (!is_power_of_two) {
-        m_device.deallocate(a);
-        m_device.deallocate(b);
-        m_device.deallocate(pos_j_base_powered);
+      });
+      m_device.deallocate(buf);
+    }
+  }
+
+  // Computes the tables used by the transforms of length line_len.
+  static Plan makePlan(Eigen::Index line_len) {
+    Plan plan;
+    const bool is_power_of_two = isPowerOfTwo(line_len);
+    const Index n = static_cast<Index>(line_len);
+    const Index m = is_power_of_two ? n : findGoodComposite(n);
+    plan.fft_len = m;
+    plan.log_len = getLog2(m);
+
+    // twiddles[l/2 + k] = exp(-2*pi*i*k/l) for the powers of two l <= m and
+    // k < l/2. The smaller transforms use a subset of the twiddles of the
+    // largest one.
+    plan.twiddles.resize(numext::maxi<Index>(m, 2));
+    for (Index k = 0; k < m / 2; ++k) {
+      const double arg = (-2 * EIGEN_PI * k) / m;
+      plan.twiddles[m / 2 + k] = static_cast<ComplexScalar>(std::complex<double>(numext::cos(arg), numext::sin(arg)));
+    }
+    for (Index l = m / 2; l >= 2; l /= 2) {
+      for (Index k = 0; k < l / 2; ++k) {
+        plan.twiddles[l / 2 + k] = plan.twiddles[m / 2 + k * (m / l)];
       }
     }
 
-    if(!write_to_out) {
-      for (Index i = 0; i < m_size; ++i) {
-        data[i] = PartOf<FFTResultType>()(buf[i]);
+    if (!is_power_of_two) {
+      // Compute the chirp
+      //   t_n = exp(sqrt(-1) * pi * n^2 / line_len)
+      // for n = 0, 1,..., line_len.
+      // The recurrence t_n = t_{n-1}^2 / t_{n-2} * t_1^2 is correct in exact
+      // arithmetic, but causes numerical issues for large transforms,
+      // especially in single-precision floating point.
+      plan.chirp.resize(n + 1);
+      for (Index j = 0; j < n + 1; ++j) {
+        double arg = ((EIGEN_PI * j) * j) / n;
+        std::complex<double> tmp(numext::cos(arg), numext::sin(arg));
+        plan.chirp[j] = static_cast<ComplexScalar>(tmp);
+      }
+
+      // Transform the chirp that the lines are convolved with in Bluestein's
+      // algorithm, once for each direction. The 1/m scaling of the inverse
+      // transform of the convolution is folded into it.
+      for (int dir = 0; dir < 2; ++dir) {
+        std::vector<ComplexScalar>& b = plan.chirp_spectrum[dir];
+        b.assign(m, ComplexScalar(0, 0));
+        for (Index i = 0; i < n; ++i) {
+          b[i] = dir == FFT_FORWARD ? plan.chirp[i] : numext::conj(plan.chirp[i]);
+        }
+        for (Index i = m - n; i < m; ++i) {
+          b[i] = dir == FFT_FORWARD ? plan.chirp[m - i] : numext::conj(plan.chirp[m - i]);
+        }
+        scramble_FFT(b.data(), m);
+        compute_1D_Butterfly<FFT_FORWARD>(b.data(), m, plan.twiddles.data());
+        for (Index i = 0; i < m; ++i) {
+          b[i] /= RealScalar(m);
+        }
       }
-      m_device.deallocate(buf);
     }
+    return plan;
   }
 
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE static bool isPowerOfTwo(Index x) {
@@ -338,14 +445,17 @@ struct TensorEvaluator<const TensorFFTOp<FFT, ArgType, FFTResultType, FFTDir>, D
   }
 
   // Call Cooley Tukey algorithm directly, data length must be power of 2
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void processDataLineCooleyTukey(ComplexScalar* line_buf, Index line_len, Index log_len) {
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE static void processDataLineCooleyTukey(ComplexScalar* line_buf, Index line_len, const ComplexScalar* twiddles) {
     eigen_assert(isPowerOfTwo(line_len));
     scramble_FFT(line_buf, line_len);
-    compute_1D_Butterfly<FFTDir>(line_buf, line_len, log_len);
+    compute_1D_Butterfly<FFTDir>(line_buf, line_len, twiddles);
   }
 
-  // Call Bluestein's FFT algorithm, m is a good composite number greater than (2 * n - 1), used as the padding length
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void processDataLineBluestein(ComplexScalar* line_buf, Index line_len, Index good_composite, Index log_len, ComplexScalar* a, ComplexScalar* b, const ComplexScalar* pos_j_base_powered) {
+  // Call Bluestein's FFT algorithm, m is a good composite number greater than (2 * n - 1), used as the padding length.
+  // chirp_spectrum is the scaled transform of the chirp sequence the line is convolved with.
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE static void processDataLineBluestein(ComplexScalar* line_buf, Index line_len, Index good_composite, ComplexScalar* a,
+                                                                             const ComplexScalar* twiddles, const ComplexScalar* pos_j_base_powered,
+                                                                             const ComplexScalar* chirp_spectrum) {
     Index n = line_len;
     Index m = good_composite;
     ComplexScalar* data = line_buf;
@@ -362,43 +472,15 @@ struct TensorEvaluator<const TensorFFTOp<FFT, ArgType, FFTResultType, FFTDir>, D
       a[i] = ComplexScalar(0, 0);
     }
 
-    for (Index i = 0; i < n; ++i) {
-      if(FFTDir == FFT_FORWARD) {
-        b[i] = pos_j_base_powered[i];
-      }
-      else {
-        b[i] = numext::conj(pos_j_base_powered[i]);
-      }
-    }
-    for (Index i = n; i < m - n; ++i) {
-      b[i] = ComplexScalar(0, 0);
-    }
-    for (Index i = m - n; i < m; ++i) {
-      if(FFTDir == FFT_FORWARD) {
-        b[i] = pos_j_base_powered[m-i];
-      }
-      else {
-        b[i] = numext::conj(pos_j_base_powered[m-i]);
-      }
-    }
-
     scramble_FFT(a, m);
-    compute_1D_Butterfly<FFT_FORWARD>(a, m, log_len);
-
-    scramble_FFT(b, m);
-    compute_1D_Butterfly<FFT_FORWARD>(b, m, log_len);
+    compute_1D_Butterfly<FFT_FORWARD>(a, m, twiddles);
 
     for (Index i = 0; i < m; ++i) {
-      a[i] *= b[i];
+      a[i] *= chirp_spectrum[i];
     }
 
     scramble_FFT(a, m);
-    compute_1D_Butterfly<FFT_REVERSE>(a, m, log_len);
-
-    //Do the scaling after ifft
-    for (Index i = 0; i < m; ++i) {
-      a[i] /= m;
-    }
+    compute_1D_Butterfly<FFT_REVERSE>(a, m, twiddles);
 
     for (Index i = 0; i < n; ++i) {
       if(FFTDir == FFT_FORWARD) {
@@ -427,14 +509,14 @@ struct TensorEvaluator<const TensorFFTOp<FFT, ArgType, FFTResultType, FFTDir>, D
   }
 
   template <int Dir>
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void butterfly_2(ComplexScalar* data) {
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE static void butterfly_2(ComplexScalar* data) {
     ComplexScalar tmp = data[1];
     data[1] = data[0] - data[1];
     data[0] += tmp;
   }
 
   template <int Dir>
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void butterfly_4(ComplexScalar* data) {
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE static void butterfly_4(ComplexScalar* data) {
     ComplexScalar tmp[4];
     tmp[0] = data[0] + data[1];
     tmp[1] = data[0] - data[1];
@@ -451,7 +533,7 @@ struct TensorEvaluator<const TensorFFTOp<FFT, ArgType, FFTResultType, FFTDir>, D
   }
 
   template <int Dir>
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void butterfly_8(ComplexScalar* data) {
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE static void butterfly_8(ComplexScalar* data) {
     ComplexScalar tmp_1[8];
     ComplexScalar tmp_2[8];
 
@@ -498,52 +580,39 @@ struct TensorEvaluator<const TensorFFTOp<FFT, ArgType, FFTResultType, FFTDir>, D
   }
 
   template <int Dir>
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void butterfly_1D_merge(
-      ComplexScalar* data, Index n, Index n_power_of_2) {
-    // Original code:
-    // RealScalar wtemp = std::sin(M_PI/n);
-    // RealScalar wpi =  -std::sin(2 * M_PI/n);
-    const RealScalar wtemp = m_sin_PI_div_n_LUT[n_power_of_2];
-    const RealScalar wpi = (Dir == FFT_FORWARD)
-                               ? m_minus_sin_2_PI_div_n_LUT[n_power_of_2]
-                               : -m_minus_sin_2_PI_div_n_LUT[n_power_of_2];
-
-    const ComplexScalar wp(wtemp, wpi);
-    const ComplexScalar wp_one = wp + ComplexScalar(1, 0);
-    const ComplexScalar wp_one_2 = wp_one * wp_one;
-    const ComplexScalar wp_one_3 = wp_one_2 * wp_one;
-    const ComplexScalar wp_one_4 = wp_one_3 * wp_one;
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE static void butterfly_1D_merge(
+      ComplexScalar* data, Index n, const ComplexScalar* twiddles) {
+    typedef typename internal::packet_traits<ComplexScalar>::type Packet;
+    const int kPacketSize = internal::unpacket_traits<Packet>::size;
     const Index n2 = n / 2;
-    ComplexScalar w(1.0, 0.0);
-    for (Index i = 0; i < n2; i += 4) {
-       ComplexScalar temp0(data[i + n2] * w);
-       ComplexScalar temp1(data[i + 1 + n2] * w * wp_one);
-       ComplexScalar temp2(data[i + 2 + n2] * w * wp_one_2);
-       ComplexScalar temp3(data[i + 3 + n2] * w * wp_one_3);
-       w = w * wp_one_4;
-
-       data[i + n2] = data[i] - temp0;
-       data[i] += temp0;
-
-       data[i + 1 + n2] = data[i + 1] - temp1;
-       data[i + 1] += temp1;
-
-       data[i + 2 + n2] = data[i + 2] - temp2;
-       data[i + 2] += temp2;
-
-       data[i + 3 + n2] = data[i + 3] - temp3;
-       data[i + 3] += temp3;
+    // twiddles[n2 + i] = exp(-2*pi*sqrt(-1)*i/n), conjugated for the reverse transform.
+    const ComplexScalar* w = twiddles + n2;
+    Index i = 0;
+    if (internal::packet_traits<ComplexScalar>::Vectorizable) {
+      for (; i + kPacketSize <= n2; i += kPacketSize) {
+        Packet wi = internal::ploadu<Packet>(w + i);
+        if (Dir == FFT_REVERSE) wi = internal::pconj(wi);
+        const Packet temp = internal::pmul(internal::ploadu<Packet>(data + i + n2), wi);
+        const Packet di = internal::ploadu<Packet>(data + i);
+        internal::pstoreu(data + i + n2, internal::psub(di, temp));
+        internal::pstoreu(data + i, internal::padd(di, temp));
+      }
+    }
+    for (; i < n2; ++i) {
+      const ComplexScalar temp = data[i + n2] * (Dir == FFT_FORWARD ? w[i] : numext::conj(w[i]));
+      data[i + n2] = data[i] - temp;
+      data[i] += temp;
     }
   }
 
- template <int Dir>
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void compute_1D_Butterfly(
-      ComplexScalar* data, Index n, Index n_power_of_2) {
+  template <int Dir>
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE static void compute_1D_Butterfly(
+      ComplexScalar* data, Index n, const ComplexScalar* twiddles) {
     eigen_assert(isPowerOfTwo(n));
     if (n > 8) {
-      compute_1D_Butterfly<Dir>(data, n / 2, n_power_of_2 - 1);
-      compute_1D_Butterfly<Dir>(data + n / 2, n / 2, n_power_of_2 - 1);
-      butterfly_1D_merge<Dir>(data, n, n_power_of_2);
+      compute_1D_Butterfly<Dir>(data, n / 2, twiddles);
+      compute_1D_Butterfly<Dir>(data + n / 2, n / 2, twiddles);
+      butterfly_1D_merge<Dir>(data, n, twiddles);
     } else if (n == 8) {
       butterfly_8<Dir>(data);
     } else if (n == 4) {
@@ -591,79 +660,6 @@ struct TensorEvaluator<const TensorFFTOp<FFT, ArgType, FFTResultType, FFTDir>, D
   TensorEvaluator<ArgType, Device> m_impl;
   EvaluatorPointerType m_data;
   const Device EIGEN_DEVICE_REF m_device;
-
-  // This will support a maximum FFT size of 2^32 for each dimension
-  // m_sin_PI_div_n_LUT[i] = (-2) * std::sin(M_PI / std::pow(2,i)) ^ 2;
-  const RealScalar m_sin_PI_div_n_LUT[32] = {
-    RealScalar(0.0),
-    RealScalar(-2),
-    RealScalar(-0.999999999999999),
-    RealScalar(-0.292893218813453),
-    RealScalar(-0.0761204674887130),
-    RealScalar(-0.0192147195967696),
-    RealScalar(-0.00481527332780311),
-    RealScalar(-0.00120454379482761),
-    RealScalar(-3.01181303795779e-04),
-    RealScalar(-7.52981608554592e-05),
-    RealScalar(-1.88247173988574e-05),
-    RealScalar(-4.70619042382852e-06),
-    RealScalar(-1.17654829809007e-06),
-    RealScalar(-2.94137117780840e-07),
-    RealScalar(-7.35342821488550e-08),
-    RealScalar(-1.83835707061916e-08),
-    RealScalar(-4.59589268710903e-09),
-    RealScalar(-1.14897317243732e-09),
-    RealScalar(-2.87243293150586e-10),
-    RealScalar( -7.18108232902250e-11),
-    RealScalar(-1.79527058227174e-11),
-    RealScalar(-4.48817645568941e-12),
-    RealScalar(-1.12204411392298e-12),
-    RealScalar(-2.80511028480785e-13),
-    RealScalar(-7.01277571201985e-14),
-    RealScalar(-1.75319392800498e-14),
-    RealScalar(-4.38298482001247e-15),
-    RealScalar(-1.09574620500312e-15),
-    RealScalar(-2.73936551250781e-16),
-    RealScalar(-6.84841378126949e-17),
-    RealScalar(-1.71210344531737e-17),
-    RealScalar(-4.28025861329343e-18)
-  };
-
-  // m_minus_sin_2_PI_div_n_LUT[i] = -std::sin(2 * M_PI / std::pow(2,i));
-  const RealScalar m_minus_sin_2_PI_div_n_LUT[32] = {
-    RealScalar(0.0),
-    RealScalar(0.0),
-    RealScalar(-1.00000000000000e+00),
-    RealScalar(-7.07106781186547e-01),
-    RealScalar(-3.82683432365090e-01),
-    RealScalar(-1.95090322016128e-01),
-    RealScalar(-9.80171403295606e-02),
-    RealScalar(-4.90676743274180e-02),
-    RealScalar(-2.45412285229123e-02),
-    RealScalar(-1.22715382857199e-02),
-    RealScalar(-6.13588464915448e-03),
-    RealScalar(-3.06795676296598e-03),
-    RealScalar(-1.53398018628477e-03),
-    RealScalar(-7.66990318742704e-04),
-    RealScalar(-3.83495187571396e-04),
-    RealScalar(-1.91747597310703e-04),
-    RealScalar(-9.58737990959773e-05),
-    RealScalar(-4.79368996030669e-05),
-    RealScalar(-2.39684498084182e-05),
-    RealScalar(-1.19842249050697e-05),
-    RealScalar(-5.99211245264243e-06),
-    RealScalar(-2.99605622633466e-06),
-    RealScalar(-1.49802811316901e-06),
-    RealScalar(-7.49014056584716e-07),
-    RealScalar(-3.74507028292384e-07),
-    RealScalar(-1.87253514146195e-07),
-    RealScalar(-9.36267570730981e-08),
-    RealScalar(-4.68133785365491e-08),
-    RealScalar(-2.34066892682746e-08),
-    RealScalar(-1.17033446341373e-08),
-    RealScalar(-5.85167231706864e-09),
-    RealScalar(-2.92583615853432e-09)
-  };
 };
 
 }  // end namespace Eigen
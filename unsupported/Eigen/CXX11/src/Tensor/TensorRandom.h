@@ -202,6 +202,41 @@ struct functor_traits<UniformRandomGenerator<Scalar> > {
 
 
 
+// Counter-based uniform generator: the value of the coefficient of index i only
+// depends on the seed and on i, so the tensor is the same whatever the device,
+// the number of threads and the way the evaluation is split. Packets are
+// produced by running the Threefry rounds of all their lanes at once.
+template <typename T> class CounterUniformRandomGenerator {
+ public:
+  static constexpr bool PacketAccess = true;
+
+  // Uses the given "seed" if non-zero, otherwise uses a random seed.
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE CounterUniformRandomGenerator(
+      uint64_t seed = 0) : m_generator(seed ? seed : get_random_seed()) {}
+
+  template<typename Index> EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE
+  T operator()(Index i) const {
+    return m_generator.coeff(static_cast<uint64_t>(i));
+  }
+
+  template<typename Packet, typename Index> EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE
+  Packet packetOp(Index i) const {
+    return m_generator.template packet<Packet>(static_cast<uint64_t>(i), 1);
+  }
+
+ private:
+  counter_random_generator<T, false> m_generator;
+};
+
+template <typename Scalar>
+struct functor_traits<CounterUniformRandomGenerator<Scalar> > {
+  enum {
+    Cost = functor_traits<scalar_counter_random_op<Scalar> >::Cost,
+    PacketAccess = CounterUniformRandomGenerator<Scalar>::PacketAccess
+  };
+};
+
+
 template <typename T> EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE
 T RandomToTypeNormal(uint64_t* state, uint64_t stream) {
   // Use the ratio of uniform method to generate numbers following a normal
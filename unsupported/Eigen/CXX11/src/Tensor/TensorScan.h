@@ -261,6 +261,94 @@ struct ReduceBlock<Self, /*Vectorize=*/true, /*Parallel=*/true> {
   }
 };
 
+// Reduces the coefficients [first, last) of a scan line along the innermost
+// dimension, without finalizing the result.
+template <typename Self, bool Vectorize>
+struct ReduceLineRange {
+  EIGEN_STRONG_INLINE typename Self::CoeffReturnType operator()(
+      Self& self, Index first, Index last) const {
+    typename Self::CoeffReturnType accum = self.accumulator().initialize();
+    for (Index curr = first; curr < last; ++curr) {
+      self.accumulator().reduce(self.inner().coeff(curr), &accum);
+    }
+    return accum;
+  }
+};
+
+template <typename Self>
+struct ReduceLineRange<Self, /*Vectorize=*/true> {
+  EIGEN_STRONG_INLINE typename Self::CoeffReturnType operator()(
+      Self& self, Index first, Index last) const {
+    using Packet = typename Self::PacketReturnType;
+    const int PacketSize = internal::unpacket_traits<Packet>::size;
+    Packet vaccum = self.accumulator().template initializePacket<Packet>();
+    Index curr = first;
+    for (; curr + PacketSize <= last; curr += PacketSize) {
+      self.accumulator().reducePacket(self.inner().template packet<Unaligned>(curr), &vaccum);
+    }
+    typename Self::CoeffReturnType accum = self.accumulator().initialize();
+    for (; curr < last; ++curr) {
+      self.accumulator().reduce(self.inner().coeff(curr), &accum);
+    }
+    return self.accumulator().finalizeBoth(accum, vaccum);
+  }
+};
+
+// Scans the coefficients [first, last) of a scan line along the innermost
+// dimension, starting from the reduction accum of the previous coefficients.
+template <typename Self>
+EIGEN_STRONG_INLINE void ScanLineRange(Self& self, Index first, Index last,
+                                       typename Self::CoeffReturnType accum,
+                                       typename Self::CoeffReturnType* data) {
+  if (self.exclusive()) {
+    for (Index curr = first; curr < last; ++curr) {
+      data[curr] = self.accumulator().finalize(accum);
+      self.accumulator().reduce(self.inner().coeff(curr), &accum);
+    }
+  } else {
+    for (Index curr = first; curr < last; ++curr) {
+      self.accumulator().reduce(self.inner().coeff(curr), &accum);
+      data[curr] = self.accumulator().finalize(accum);
+    }
+  }
+}
+
+// Scans the line along the innermost dimension starting at offset in parallel:
+// the line is split in blocks which are reduced in parallel, the reductions are
+// scanned to get the starting value of each block, and the blocks are then
+// scanned in parallel. This assumes that the reducer is not stateful.
+template <typename Self, bool Vectorize>
+void ParallelScanLine(Self& self, Index offset, Index block_size,
+                      typename Self::CoeffReturnType* data) {
+  using Scalar = typename Self::CoeffReturnType;
+  const Index num_blocks = divup(self.size(), block_size);
+  const TensorOpCost cost(block_size, block_size, 16 * block_size);
+  std::vector<Scalar> totals(num_blocks);
+
+  // The reduction of the last block is not needed.
+  self.device().parallelFor(num_blocks - 1, cost, [&](Index first, Index last) {
+    for (Index block = first; block < last; ++block) {
+      const Index begin = offset + block * block_size;
+      totals[block] = ReduceLineRange<Self, Vectorize>()(self, begin, begin + block_size);
+    }
+  });
+
+  Scalar accum = self.accumulator().initialize();
+  for (Index block = 0; block < num_blocks; ++block) {
+    const Scalar total = totals[block];
+    totals[block] = accum;
+    self.accumulator().reduce(total, &accum);
+  }
+
+  self.device().parallelFor(num_blocks, cost, [&](Index first, Index last) {
+    for (Index block = first; block < last; ++block) {
+      const Index begin = offset + block * block_size;
+      const Index end = offset + numext::mini(self.size(), (block + 1) * block_size);
+      ScanLineRange(self, begin, end, totals[block], data);
+    }
+  });
+}
+
 template <typename Self>
 struct ReduceBlock<Self, /*Vectorize=*/false, /*Parallel=*/true> {
   EIGEN_STRONG_INLINE void operator()(Self& self, Index idx1,
@@ -292,6 +380,20 @@ struct ScanLauncher<Self, Reducer, ThreadPoolDevice, Vectorize> {
     const Index inner_block_size = self.stride() * self.size();
     bool parallelize_by_outer_blocks = (total_size >= (self.stride() * inner_block_size));
 
+    // Fewer scan lines along the innermost dimension than threads: split the
+    // long lines in blocks to use all the threads.
+    const Index kMinScanBlockSize = 16384;
+    if (!reducer_traits<Reducer, ThreadPoolDevice>::IsStateful && self.stride() == 1 &&
+        self.size() >= 2 * kMinScanBlockSize &&
+        total_size / self.size() < self.device().numThreads()) {
+      const Index block_size = AdjustBlockSize(
+          sizeof(Scalar), numext::maxi(kMinScanBlockSize, divup<Index>(self.size(), 4 * self.device().numThreads())));
+      for (Index idx1 = 0; idx1 < total_size; idx1 += self.size()) {
+        ParallelScanLine<Self, Vectorize>(self, idx1, block_size, data);
+      }
+      return;
+    }
+
     if ((parallelize_by_outer_blocks && total_size <= 4096) ||
         (!parallelize_by_outer_blocks && self.stride() < PacketSize)) {
       ScanLauncher<Self, Reducer, DefaultDevice, Vectorize> launcher;
@@ -25,6 +25,14 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
 
   ThreadPoolTempl(int num_threads, bool allow_spinning,
                   Environment env = Environment())
+      : ThreadPoolTempl(num_threads, allow_spinning, false, env) {}
+
+  // If numa_aware is true and the machine has several NUMA nodes, the threads
+  // are spread over the nodes in proportion to their number of CPUs, each
+  // thread is pinned to the CPUs of its node, and the threads steal work from
+  // the threads of their node before stealing from the other nodes.
+  ThreadPoolTempl(int num_threads, bool allow_spinning, bool numa_aware,
+                  Environment env = Environment())
       : env_(env),
         num_threads_(num_threads),
         allow_spinning_(allow_spinning),
@@ -53,9 +61,17 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
 #ifndef EIGEN_THREAD_LOCAL
     init_barrier_.reset(new Barrier(num_threads_));
 #endif
+    if (numa_aware) {
+      AssignNumaNodes();
+    }
     thread_data_.resize(num_threads_);
     for (int i = 0; i < num_threads_; i++) {
-      SetStealPartition(i, EncodePartition(0, num_threads_));
+      if (thread_node_.empty()) {
+        SetStealPartition(i, EncodePartition(0, num_threads_));
+      } else {
+        const int node = thread_node_[i];
+        SetStealPartition(i, EncodePartition(node_begin_[node], node_begin_[node + 1]));
+      }
       thread_data_[i].thread.reset(
           env_.CreateThread([this, i]() { WorkerLoop(i); }));
     }
@@ -154,6 +170,16 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
 
   int NumThreads() const EIGEN_FINAL { return num_threads_; }
 
+  int NumNumaNodes() const EIGEN_OVERRIDE {
+    return thread_node_.empty() ? 1 : static_cast<int>(numa_nodes_.size());
+  }
+
+  int CurrentNumaNode() const EIGEN_OVERRIDE {
+    const int thread_id = CurrentThreadId();
+    if (thread_id < 0 || thread_node_.empty()) return -1;
+    return numa_nodes_[thread_node_[thread_id]].id;
+  }
+
   int CurrentThreadId() const EIGEN_FINAL {
     const PerThread* pt = const_cast<ThreadPoolTempl*>(this)->GetPerThread();
     if (pt->pool == this) {
@@ -198,6 +224,26 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
     return thread_data_[i].steal_partition.load(std::memory_order_relaxed);
   }
 
+  // Spreads the threads over the NUMA nodes in proportion to their number of
+  // CPUs: the threads [node_begin_[k], node_begin_[k + 1]) run on node k.
+  void AssignNumaNodes() {
+    std::vector<internal::NumaNode> nodes = internal::NumaTopology();
+    if (nodes.size() < 2) return;
+    std::size_t total_cpus = 0;
+    for (std::size_t k = 0; k < nodes.size(); ++k) total_cpus += nodes[k].cpus.size();
+    numa_nodes_ = nodes;
+    node_begin_.assign(1, 0);
+    thread_node_.resize(num_threads_);
+    std::size_t cpus = 0;
+    for (std::size_t k = 0; k < nodes.size(); ++k) {
+      cpus += nodes[k].cpus.size();
+      node_begin_.push_back(static_cast<unsigned>(num_threads_ * cpus / total_cpus));
+      for (unsigned i = node_begin_[k]; i < node_begin_[k + 1]; ++i) {
+        thread_node_[i] = static_cast<int>(k);
+      }
+    }
+  }
+
   void ComputeCoprimes(int N, MaxSizeVector<unsigned>* coprimes) {
     for (int i = 1; i <= N; i++) {
       unsigned a = i;
@@ -246,6 +292,10 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
   std::atomic<bool> done_;
   std::atomic<bool> cancelled_;
   EventCount ec_;
+  // NUMA nodes of the threads, empty if the pool is not NUMA aware.
+  std::vector<internal::NumaNode> numa_nodes_;
+  std::vector<unsigned> node_begin_;
+  std::vector<int> thread_node_;
 #ifndef EIGEN_THREAD_LOCAL
   std::unique_ptr<Barrier> init_barrier_;
   std::mutex per_thread_map_mutex_;  // Protects per_thread_map_.
@@ -268,6 +318,9 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
     pt->pool = this;
     pt->rand = GlobalThreadIdHash();
     pt->thread_id = thread_id;
+    if (!thread_node_.empty()) {
+      internal::NumaPinCurrentThread(numa_nodes_[thread_node_[thread_id]].cpus);
+    }
     Queue& q = thread_data_[thread_id].queue;
     EventCount::Waiter* waiter = &waiters_[thread_id];
     // TODO(dvyukov,rmlarsen): The time spent in NonEmptyQueueIndex() is
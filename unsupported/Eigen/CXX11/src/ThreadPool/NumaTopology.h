@@ -0,0 +1,83 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_CXX11_THREADPOOL_NUMA_TOPOLOGY_H
+#define EIGEN_CXX11_THREADPOOL_NUMA_TOPOLOGY_H
+
+#include "./InternalHeaderCheck.h"
+
+namespace Eigen {
+
+namespace internal {
+
+struct NumaNode {
+  int id;                 // Node number used by the operating system.
+  std::vector<int> cpus;  // Logical CPUs of the node.
+};
+
+// Parses a list of ranges such as "0-3,8,10-11".
+inline std::vector<int> ParseNumaList(const std::string& list) {
+  std::vector<int> values;
+  std::size_t pos = 0;
+  while (pos < list.size()) {
+    std::size_t end = list.find(',', pos);
+    if (end == std::string::npos) end = list.size();
+    int first = 0, last = 0;
+    const int fields = std::sscanf(list.substr(pos, end - pos).c_str(), "%d-%d", &first, &last);
+    if (fields >= 1) {
+      if (fields == 1) last = first;
+      for (int value = first; value <= last; ++value) values.push_back(value);
+    }
+    pos = end + 1;
+  }
+  return values;
+}
+
+// Returns the NUMA nodes of the machine which have CPUs, read from sysfs on
+// Linux. Returns an empty vector if the topology is unknown.
+inline std::vector<NumaNode> NumaTopology() {
+  std::vector<NumaNode> nodes;
+#if defined(__linux__)
+  std::ifstream online("/sys/devices/system/node/online");
+  std::string list;
+  if (!std::getline(online, list)) return nodes;
+  const std::vector<int> ids = ParseNumaList(list);
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(ids[i]) + "/cpulist");
+    std::string cpus;
+    if (!std::getline(cpulist, cpus)) continue;
+    NumaNode node;
+    node.id = ids[i];
+    node.cpus = ParseNumaList(cpus);
+    // Memory only nodes can not run threads.
+    if (!node.cpus.empty()) nodes.push_back(node);
+  }
+#endif
+  return nodes;
+}
+
+// Restricts the calling thread to the given CPUs. Returns false if this is not
+// supported.
+inline bool NumaPinCurrentThread(const std::vector<int>& cpus) {
+#if defined(__linux__) && defined(CPU_SET)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (std::size_t i = 0; i < cpus.size(); ++i) {
+    if (cpus[i] >= 0 && cpus[i] < CPU_SETSIZE) CPU_SET(cpus[i], &set);
+  }
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  EIGEN_UNUSED_VARIABLE(cpus);
+  return false;
+#endif
+}
+
+}  // namespace internal
+
+}  // namespace Eigen
+
+#endif  // EIGEN_CXX11_THREADPOOL_NUMA_TOPOLOGY_H
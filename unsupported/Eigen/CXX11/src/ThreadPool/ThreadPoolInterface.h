@@ -42,6 +42,13 @@ class ThreadPoolInterface {
   // from one of the threads in the pool. Returns -1 otherwise.
   virtual int CurrentThreadId() const = 0;
 
+  // Returns the number of NUMA nodes the threads of the pool are spread over.
+  virtual int NumNumaNodes() const { return 1; }
+
+  // Returns the NUMA node of the calling thread if it is one of the threads of
+  // the pool and the pool is NUMA aware. Returns -1 otherwise.
+  virtual int CurrentNumaNode() const { return -1; }
+
   virtual ~ThreadPoolInterface() {}
 };
 
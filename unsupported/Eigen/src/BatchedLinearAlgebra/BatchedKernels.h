@@ -0,0 +1,390 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_BATCHED_KERNELS_H
+#define EIGEN_BATCHED_KERNELS_H
+
+#include "./InternalHeaderCheck.h"
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal Calls \a func(first, last) on ranges of groups covering [0, \a groups), in parallel if
+  * the batch is large enough. \a flops_per_group is the approximate cost of one group. */
+template<typename Functor>
+void batched_parallel_for(Index groups, double flops_per_group, const Functor& func)
+{
+  // Below this many flops per task, handing the task to another thread costs more than it saves.
+  const double kMinTaskFlops = 65536;
+  Index num_tasks = (std::min)(parallel_loop_threads(), groups);
+  num_tasks = (std::min)(num_tasks, (std::max)(Index(1), Index(double(groups) * flops_per_group / kMinTaskFlops)));
+  if(num_tasks <= 1)
+  {
+    func(Index(0), groups);
+    return;
+  }
+  parallelize_tasks(num_tasks, [&](Index t) { func(groups * t / num_tasks, groups * (t + 1) / num_tasks); });
+}
+
+/** \internal Packet loads and stores of the interleaved coefficients of a group of a MatrixBatch. */
+template<typename Scalar> struct batched_group
+{
+  typedef typename MatrixBatch<Scalar>::Packet Packet;
+  enum { LaneCount = MatrixBatch<Scalar>::LaneCount };
+
+  static EIGEN_STRONG_INLINE Packet load(const Scalar* p) { return ploadt<Packet, AlignedMax>(p); }
+  static EIGEN_STRONG_INLINE void store(Scalar* p, const Packet& x) { pstoret<Scalar, Packet, AlignedMax>(p, x); }
+};
+
+/** \internal Computes the RowBlock x ColBlock block of C starting at (\a i0, \a j0) for one group,
+  * keeping the accumulators in registers. */
+template<typename Scalar, int RowBlock, int ColBlock>
+EIGEN_STRONG_INLINE void batched_gemm_block(Index rows, Index depth, Index i0, Index j0,
+                                            const Scalar* a, const Scalar* b, Scalar* c,
+                                            const typename batched_group<Scalar>::Packet& alpha,
+                                            const typename batched_group<Scalar>::Packet& beta, bool beta_is_zero)
+{
+  typedef batched_group<Scalar> G;
+  typedef typename G::Packet Packet;
+  const Index L = G::LaneCount;
+  Packet acc[RowBlock][ColBlock];
+  for(int r = 0; r < RowBlock; ++r)
+    for(int q = 0; q < ColBlock; ++q)
+      acc[r][q] = pset1<Packet>(Scalar(0));
+  for(Index k = 0; k < depth; ++k)
+  {
+    Packet bk[ColBlock];
+    for(int q = 0; q < ColBlock; ++q)
+      bk[q] = G::load(b + ((j0 + q) * depth + k) * L);
+    const Scalar* ak = a + (k * rows + i0) * L;
+    for(int r = 0; r < RowBlock; ++r)
+    {
+      const Packet air = G::load(ak + r * L);
+      for(int q = 0; q < ColBlock; ++q)
+        acc[r][q] = pmadd(air, bk[q], acc[r][q]);
+    }
+  }
+  for(int q = 0; q < ColBlock; ++q)
+    for(int r = 0; r < RowBlock; ++r)
+    {
+      Scalar* cij = c + ((j0 + q) * rows + i0 + r) * L;
+      Packet res = pmul(alpha, acc[r][q]);
+      // like BLAS, C is not read when beta is zero so that it may hold NaNs
+      if(!beta_is_zero)
+        res = pmadd(beta, G::load(cij), res);
+      G::store(cij, res);
+    }
+}
+
+template<typename Scalar, int ColBlock>
+EIGEN_STRONG_INLINE void batched_gemm_cols(Index rows, Index depth, Index j0,
+                                           const Scalar* a, const Scalar* b, Scalar* c,
+                                           const typename batched_group<Scalar>::Packet& alpha,
+                                           const typename batched_group<Scalar>::Packet& beta, bool beta_is_zero)
+{
+  Index i = 0;
+  for(; i + 4 <= rows; i += 4)
+    batched_gemm_block<Scalar, 4, ColBlock>(rows, depth, i, j0, a, b, c, alpha, beta, beta_is_zero);
+  for(; i < rows; ++i)
+    batched_gemm_block<Scalar, 1, ColBlock>(rows, depth, i, j0, a, b, c, alpha, beta, beta_is_zero);
+}
+
+/** \internal Unblocked right-looking LU with partial pivoting of the \a lanes first matrices of a group.
+  * The pivot search and the row swaps differ from one matrix to the other and are done lane by lane,
+  * the elimination, which dominates, works on full packets. */
+template<typename Scalar, typename PivotsType>
+void batched_lu_group(Index n, Scalar* a, Index first, Index lanes, PivotsType& pivots)
+{
+  typedef batched_group<Scalar> G;
+  typedef typename G::Packet Packet;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  const Index L = G::LaneCount;
+  EIGEN_ALIGN_MAX Scalar inv[G::LaneCount];
+  for(Index k = 0; k < n; ++k)
+  {
+    for(Index l = 0; l < L; ++l)
+    {
+      Index p = k;
+      RealScalar biggest = numext::abs(a[(k * n + k) * L + l]);
+      for(Index i = k + 1; i < n; ++i)
+      {
+        const RealScalar score = numext::abs(a[(k * n + i) * L + l]);
+        if(score > biggest)
+        {
+          biggest = score;
+          p = i;
+        }
+      }
+      if(l < lanes)
+        pivots.coeffRef(k, first + l) = static_cast<typename PivotsType::Scalar>(p);
+      if(p != k)
+        for(Index j = 0; j < n; ++j)
+          numext::swap(a[(j * n + k) * L + l], a[(j * n + p) * L + l]);
+      // as in PartialPivLU, a zero column is left as is
+      inv[l] = biggest != RealScalar(0) ? Scalar(1) / a[(k * n + k) * L + l] : Scalar(0);
+    }
+    const Packet pinv = pload<Packet>(inv);
+    Scalar* ak = a + k * n * L;
+    for(Index i = k + 1; i < n; ++i)
+      G::store(ak + i * L, pmul(G::load(ak + i * L), pinv));
+    for(Index j = k + 1; j < n; ++j)
+    {
+      Scalar* aj = a + j * n * L;
+      const Packet akj = G::load(aj + k * L);
+      for(Index i = k + 1; i < n; ++i)
+        G::store(aj + i * L, pnmadd(G::load(ak + i * L), akj, G::load(aj + i * L)));
+    }
+  }
+}
+
+/** \internal Unblocked right-looking Cholesky factorization of a group. Matrices which are not
+  * positive definite are flagged in \a info and factorized as if their failing pivots were one. */
+template<typename Scalar>
+void batched_llt_group(Index n, Scalar* a, Index lanes, ComputationInfo* info)
+{
+  typedef batched_group<Scalar> G;
+  typedef typename G::Packet Packet;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  const Index L = G::LaneCount;
+  EIGEN_ALIGN_MAX Scalar inv[G::LaneCount];
+  for(Index k = 0; k < n; ++k)
+  {
+    Scalar* ak = a + k * n * L;
+    for(Index l = 0; l < L; ++l)
+    {
+      RealScalar d = numext::real(ak[k * L + l]);
+      if(!(d > RealScalar(0)))
+      {
+        if(l < lanes)
+          info[l] = NumericalIssue;
+        d = RealScalar(1);
+      }
+      const RealScalar s = numext::sqrt(d);
+      ak[k * L + l] = Scalar(s);
+      inv[l] = Scalar(RealScalar(1) / s);
+    }
+    const Packet pinv = pload<Packet>(inv);
+    for(Index i = k + 1; i < n; ++i)
+      G::store(ak + i * L, pmul(G::load(ak + i * L), pinv));
+    for(Index j = k + 1; j < n; ++j)
+    {
+      Scalar* aj = a + j * n * L;
+      const Packet ljk = pconj(G::load(ak + j * L));
+      for(Index i = j; i < n; ++i)
+        G::store(aj + i * L, pnmadd(G::load(ak + i * L), ljk, G::load(aj + i * L)));
+    }
+  }
+}
+
+} // end namespace internal
+
+/** \ingroup BatchedLinearAlgebra_Module
+  *
+  * Computes \f$ C_b = \alpha A_b B_b + \beta C_b \f$ for every matrix \c b of the batches.
+  *
+  * All batches must have the same size, \a c must be distinct from \a a and \a b, and as with BLAS
+  * \a c is not read when \a beta is zero.
+  */
+template<typename Scalar>
+void batchedGemm(const Scalar& alpha, const MatrixBatch<Scalar>& a, const MatrixBatch<Scalar>& b,
+                 const Scalar& beta, MatrixBatch<Scalar>& c)
+{
+  typedef internal::batched_group<Scalar> G;
+  typedef typename G::Packet Packet;
+  eigen_assert(a.size() == b.size() && a.size() == c.size());
+  eigen_assert(a.cols() == b.rows() && c.rows() == a.rows() && c.cols() == b.cols());
+  eigen_assert(&c != &a && &c != &b && "batchedGemm does not support aliasing");
+  const Index rows = a.rows(), cols = b.cols(), depth = a.cols();
+  const Packet palpha = internal::pset1<Packet>(alpha);
+  const Packet pbeta = internal::pset1<Packet>(beta);
+  const bool beta_is_zero = beta == Scalar(0);
+  internal::batched_parallel_for(c.groups(), 2.0 * double(rows * cols * depth * G::LaneCount),
+    [&](Index first, Index last) {
+      for(Index g = first; g < last; ++g)
+      {
+        const Scalar* ag = a.groupData(g);
+        const Scalar* bg = b.groupData(g);
+        Scalar* cg = c.groupData(g);
+        Index j = 0;
+        for(; j + 2 <= cols; j += 2)
+          internal::batched_gemm_cols<Scalar, 2>(rows, depth, j, ag, bg, cg, palpha, pbeta, beta_is_zero);
+        for(; j < cols; ++j)
+          internal::batched_gemm_cols<Scalar, 1>(rows, depth, j, ag, bg, cg, palpha, pbeta, beta_is_zero);
+      }
+    });
+}
+
+/** \ingroup BatchedLinearAlgebra_Module
+  *
+  * Computes in place the LU decompositions with partial pivoting \f$ P_b A_b = L_b U_b \f$ of the
+  * square matrices of \a a, with the same storage and pivoting strategy as PartialPivLU.
+  *
+  * On return the column \c b of \a transpositions holds the row interchanges of the matrix \c b, in the
+  * format of Transpositions: the row \c k was swapped with the row \a transpositions(k,b).
+  *
+  * \sa batchedLuSolve(), class PartialPivLU
+  */
+template<typename Scalar, typename StorageIndex>
+void batchedPartialPivLu(MatrixBatch<Scalar>& a, Matrix<StorageIndex,Dynamic,Dynamic>& transpositions)
+{
+  typedef internal::batched_group<Scalar> G;
+  eigen_assert(a.rows() == a.cols());
+  const Index n = a.rows();
+  transpositions.resize(n, a.size());
+  internal::batched_parallel_for(a.groups(), 2.0 / 3.0 * double(n * n * n * G::LaneCount),
+    [&](Index first, Index last) {
+      for(Index g = first; g < last; ++g)
+      {
+        const Index lanes = (std::min<Index>)(G::LaneCount, a.size() - g * G::LaneCount);
+        internal::batched_lu_group(n, a.groupData(g), g * G::LaneCount, lanes, transpositions);
+      }
+    });
+}
+
+/** \ingroup BatchedLinearAlgebra_Module
+  *
+  * Solves in place \f$ A_b X_b = B_b \f$ for every matrix \c b of \a rhs, given the decompositions
+  * \a lu and \a transpositions computed by batchedPartialPivLu().
+  *
+  * \sa batchedPartialPivLu()
+  */
+template<typename Scalar, typename StorageIndex>
+void batchedLuSolve(const MatrixBatch<Scalar>& lu, const Matrix<StorageIndex,Dynamic,Dynamic>& transpositions,
+                    MatrixBatch<Scalar>& rhs)
+{
+  typedef internal::batched_group<Scalar> G;
+  typedef typename G::Packet Packet;
+  const Index L = G::LaneCount;
+  eigen_assert(lu.size() == rhs.size() && lu.rows() == lu.cols() && rhs.rows() == lu.rows());
+  eigen_assert(transpositions.rows() == lu.rows() && transpositions.cols() == lu.size());
+  const Index n = lu.rows(), nrhs = rhs.cols();
+  internal::batched_parallel_for(lu.groups(), 2.0 * double(n * n * nrhs * L),
+    [&](Index first, Index last) {
+      for(Index g = first; g < last; ++g)
+      {
+        const Scalar* a = lu.groupData(g);
+        Scalar* x = rhs.groupData(g);
+        const Index lanes = (std::min<Index>)(L, lu.size() - g * L);
+        for(Index l = 0; l < lanes; ++l)
+          for(Index k = 0; k < n; ++k)
+          {
+            const Index p = transpositions.coeff(k, g * L + l);
+            if(p != k)
+              for(Index j = 0; j < nrhs; ++j)
+                numext::swap(x[(j * n + k) * L + l], x[(j * n + p) * L + l]);
+          }
+        for(Index j = 0; j < nrhs; ++j)
+        {
+          Scalar* xj = x + j * n * L;
+          // forward substitution with the unit lower triangular factor
+          for(Index k = 0; k < n; ++k)
+          {
+            const Packet xk = G::load(xj + k * L);
+            const Scalar* ak = a + k * n * L;
+            for(Index i = k + 1; i < n; ++i)
+              G::store(xj + i * L, internal::pnmadd(G::load(ak + i * L), xk, G::load(xj + i * L)));
+          }
+          // back substitution with the upper triangular factor
+          for(Index k = n - 1; k >= 0; --k)
+          {
+            const Scalar* ak = a + k * n * L;
+            const Packet xk = internal::pdiv(G::load(xj + k * L), G::load(ak + k * L));
+            G::store(xj + k * L, xk);
+            for(Index i = 0; i < k; ++i)
+              G::store(xj + i * L, internal::pnmadd(G::load(ak + i * L), xk, G::load(xj + i * L)));
+          }
+        }
+      }
+    });
+}
+
+/** \ingroup BatchedLinearAlgebra_Module
+  *
+  * Computes in place the Cholesky factorizations \f$ A_b = L_b L_b^* \f$ of the selfadjoint positive
+  * definite matrices of \a a. Only the lower triangular parts are referenced, and on return they hold
+  * the factors \f$ L_b \f$.
+  *
+  * \returns \c Success if all the matrices are positive definite, and \c NumericalIssue otherwise.
+  * If \a info is not null, it is resized to a.size() and receives the status of every matrix.
+  *
+  * \sa batchedLltSolve(), class LLT
+  */
+template<typename Scalar>
+ComputationInfo batchedLlt(MatrixBatch<Scalar>& a, std::vector<ComputationInfo>* info = 0)
+{
+  typedef internal::batched_group<Scalar> G;
+  eigen_assert(a.rows() == a.cols());
+  const Index n = a.rows();
+  std::vector<ComputationInfo> status(a.size(), Success);
+  internal::batched_parallel_for(a.groups(), double(n * n * n * G::LaneCount) / 3.0,
+    [&](Index first, Index last) {
+      for(Index g = first; g < last; ++g)
+      {
+        const Index lanes = (std::min<Index>)(G::LaneCount, a.size() - g * G::LaneCount);
+        internal::batched_llt_group(n, a.groupData(g), lanes, status.data() + g * G::LaneCount);
+      }
+    });
+  ComputationInfo result = Success;
+  for(std::size_t b = 0; b < status.size(); ++b)
+    if(status[b] != Success)
+      result = NumericalIssue;
+  if(info)
+    info->swap(status);
+  return result;
+}
+
+/** \ingroup BatchedLinearAlgebra_Module
+  *
+  * Solves in place \f$ A_b X_b = B_b \f$ for every matrix \c b of \a rhs, given the factors \a llt
+  * computed by batchedLlt().
+  *
+  * \sa batchedLlt()
+  */
+template<typename Scalar>
+void batchedLltSolve(const MatrixBatch<Scalar>& llt, MatrixBatch<Scalar>& rhs)
+{
+  typedef internal::batched_group<Scalar> G;
+  typedef typename G::Packet Packet;
+  const Index L = G::LaneCount;
+  eigen_assert(llt.size() == rhs.size() && llt.rows() == llt.cols() && rhs.rows() == llt.rows());
+  const Index n = llt.rows(), nrhs = rhs.cols();
+  internal::batched_parallel_for(llt.groups(), 2.0 * double(n * n * nrhs * L),
+    [&](Index first, Index last) {
+      for(Index g = first; g < last; ++g)
+      {
+        const Scalar* a = llt.groupData(g);
+        Scalar* x = rhs.groupData(g);
+        for(Index j = 0; j < nrhs; ++j)
+        {
+          Scalar* xj = x + j * n * L;
+          // L y = b
+          for(Index k = 0; k < n; ++k)
+          {
+            const Scalar* ak = a + k * n * L;
+            const Packet xk = internal::pdiv(G::load(xj + k * L), G::load(ak + k * L));
+            G::store(xj + k * L, xk);
+            for(Index i = k + 1; i < n; ++i)
+              G::store(xj + i * L, internal::pnmadd(G::load(ak + i * L), xk, G::load(xj + i * L)));
+          }
+          // L^* x = y, reading L by columns
+          for(Index k = n - 1; k >= 0; --k)
+          {
+            const Scalar* ak = a + k * n * L;
+            Packet acc = G::load(xj + k * L);
+            for(Index i = k + 1; i < n; ++i)
+              acc = internal::pnmadd(internal::pconj(G::load(ak + i * L)), G::load(xj + i * L), acc);
+            G::store(xj + k * L, internal::pdiv(acc, G::load(ak + k * L)));
+          }
+        }
+      }
+    });
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_BATCHED_KERNELS_H
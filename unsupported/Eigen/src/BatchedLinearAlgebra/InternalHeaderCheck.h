@@ -0,0 +1,3 @@
+#ifndef EIGEN_BATCHED_LINEAR_ALGEBRA_MODULE_H
+#error "Please include unsupported/Eigen/BatchedLinearAlgebra instead of including headers inside the src directory directly."
+#endif
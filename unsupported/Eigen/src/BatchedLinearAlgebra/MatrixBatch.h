@@ -0,0 +1,164 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_MATRIX_BATCH_H
+#define EIGEN_MATRIX_BATCH_H
+
+#include "./InternalHeaderCheck.h"
+
+namespace Eigen {
+
+/** \ingroup BatchedLinearAlgebra_Module
+  *
+  * \class MatrixBatch
+  *
+  * \brief A batch of matrices of the same size stored interleaved across SIMD lanes
+  *
+  * \tparam Scalar_ the scalar type of the matrices
+  *
+  * The batch is split into groups of LaneCount consecutive matrices, LaneCount being the
+  * number of scalars of a SIMD packet. Within a group the coefficients are stored column-major
+  * and the LaneCount matrices are interleaved coefficient by coefficient, that is the
+  * coefficient (i,j) of the matrix \c b is stored at
+  * \code (b / LaneCount) * rows * cols * LaneCount + (j * rows + i) * LaneCount + b % LaneCount \endcode
+  * A packet loaded from this storage holds the same coefficient of LaneCount matrices, which is
+  * what the batched kernels work on. The last group is padded with zero matrices.
+  *
+  * Use pack() and unpack() to convert from and to contiguous or strided arrays of column-major
+  * matrices, or matrix() and setMatrix() to access a single matrix.
+  *
+  * \sa batchedGemm(), batchedPartialPivLu(), batchedLlt()
+  */
+template<typename Scalar_> class MatrixBatch
+{
+  public:
+    typedef Scalar_ Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef Eigen::Index Index;
+    typedef typename internal::packet_traits<Scalar>::type Packet;
+    typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+    enum {
+      LaneCount = internal::unpacket_traits<Packet>::size
+    };
+
+    /** Default constructor, an empty batch */
+    MatrixBatch() : m_size(0), m_rows(0), m_cols(0) {}
+
+    /** Constructs a batch of \a size zero matrices of size \a rows x \a cols */
+    MatrixBatch(Index size, Index rows, Index cols) : m_size(0), m_rows(0), m_cols(0)
+    {
+      resize(size, rows, cols);
+    }
+
+    /** Resizes the batch to \a size matrices of size \a rows x \a cols, all set to zero */
+    void resize(Index size, Index rows, Index cols)
+    {
+      eigen_assert(size >= 0 && rows >= 0 && cols >= 0);
+      m_size = size;
+      m_rows = rows;
+      m_cols = cols;
+      m_data.setZero(groups() * groupSize());
+    }
+
+    /** \returns the number of matrices */
+    Index size() const { return m_size; }
+    /** \returns the number of rows of each matrix */
+    Index rows() const { return m_rows; }
+    /** \returns the number of columns of each matrix */
+    Index cols() const { return m_cols; }
+    /** \returns the number of groups of LaneCount interleaved matrices */
+    Index groups() const { return (m_size + LaneCount - 1) / LaneCount; }
+    /** \returns the number of scalars of a group */
+    Index groupSize() const { return m_rows * m_cols * LaneCount; }
+
+    /** \returns a pointer to the interleaved coefficients of the group \a g */
+    Scalar* groupData(Index g) { return m_data.data() + g * groupSize(); }
+    const Scalar* groupData(Index g) const { return m_data.data() + g * groupSize(); }
+
+    /** \returns the coefficient (\a i, \a j) of the matrix \a b */
+    Scalar& operator()(Index b, Index i, Index j)
+    {
+      eigen_assert(b >= 0 && b < m_size && i >= 0 && i < m_rows && j >= 0 && j < m_cols);
+      return m_data.coeffRef(index(b, i, j));
+    }
+    const Scalar& operator()(Index b, Index i, Index j) const
+    {
+      eigen_assert(b >= 0 && b < m_size && i >= 0 && i < m_rows && j >= 0 && j < m_cols);
+      return m_data.coeff(index(b, i, j));
+    }
+
+    /** \returns a copy of the matrix \a b */
+    MatrixType matrix(Index b) const
+    {
+      MatrixType m(m_rows, m_cols);
+      for(Index j = 0; j < m_cols; ++j)
+        for(Index i = 0; i < m_rows; ++i)
+          m(i, j) = (*this)(b, i, j);
+      return m;
+    }
+
+    /** Sets the matrix \a b to \a m, which must have the size of the matrices of the batch */
+    template<typename Derived>
+    void setMatrix(Index b, const MatrixBase<Derived>& m)
+    {
+      eigen_assert(m.rows() == m_rows && m.cols() == m_cols);
+      for(Index j = 0; j < m_cols; ++j)
+        for(Index i = 0; i < m_rows; ++i)
+          (*this)(b, i, j) = m.coeff(i, j);
+    }
+
+    /** Copies size() column-major matrices into the batch. The matrix \c b starts at
+      * \a data + \c b * \a matrixStride and its columns are \a outerStride scalars apart,
+      * which defaults to rows(). */
+    void pack(const Scalar* data, Index matrixStride, Index outerStride = -1)
+    {
+      if(outerStride < 0) outerStride = m_rows;
+      eigen_assert(outerStride >= m_rows);
+      for(Index g = 0; g < groups(); ++g)
+      {
+        const Index lanes = (std::min<Index>)(LaneCount, m_size - g * LaneCount);
+        const Scalar* src = data + g * LaneCount * matrixStride;
+        Scalar* dst = groupData(g);
+        for(Index j = 0; j < m_cols; ++j)
+          for(Index i = 0; i < m_rows; ++i, dst += LaneCount)
+            for(Index l = 0; l < lanes; ++l)
+              dst[l] = src[l * matrixStride + j * outerStride + i];
+      }
+    }
+
+    /** Copies the matrices of the batch to \a data, with the layout described in pack() */
+    void unpack(Scalar* data, Index matrixStride, Index outerStride = -1) const
+    {
+      if(outerStride < 0) outerStride = m_rows;
+      eigen_assert(outerStride >= m_rows);
+      for(Index g = 0; g < groups(); ++g)
+      {
+        const Index lanes = (std::min<Index>)(LaneCount, m_size - g * LaneCount);
+        const Scalar* src = groupData(g);
+        Scalar* dst = data + g * LaneCount * matrixStride;
+        for(Index j = 0; j < m_cols; ++j)
+          for(Index i = 0; i < m_rows; ++i, src += LaneCount)
+            for(Index l = 0; l < lanes; ++l)
+              dst[l * matrixStride + j * outerStride + i] = src[l];
+      }
+    }
+
+  protected:
+    Index index(Index b, Index i, Index j) const
+    {
+      return (b / LaneCount) * groupSize() + (j * m_rows + i) * LaneCount + b % LaneCount;
+    }
+
+    Matrix<Scalar,Dynamic,1> m_data;
+    Index m_size;
+    Index m_rows;
+    Index m_cols;
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_MATRIX_BATCH_H
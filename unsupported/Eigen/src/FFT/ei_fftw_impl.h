@@ -187,6 +187,27 @@ namespace internal {
         m_plans.clear();
       }
 
+      // the fftw plans depend on the alignment of the buffers, and are created on their first use
+      inline
+      void warmup(int) {}
+
+      // batched transforms, one signal at a time
+      template <typename Dst, typename Src>
+      inline
+      void fwd_batch(Dst * dst, Index dst_stride, Index dst_dist, const Src * src, Index src_stride, Index src_dist, int nfft, Index howmany)
+      {
+        fft_batch_by_signal(dst, dst_stride, dst_dist, src, src_stride, src_dist, nfft, howmany,
+                            [this](Dst * out, const Src * in, int n) { fwd(out, in, n); });
+      }
+
+      template <typename Dst, typename Src>
+      inline
+      void inv_batch(Dst * dst, Index dst_stride, Index dst_dist, const Src * src, Index src_stride, Index src_dist, int nfft, Index howmany)
+      {
+        fft_batch_by_signal(dst, dst_stride, dst_dist, src, src_stride, src_dist, nfft, howmany,
+                            [this](Dst * out, const Src * in, int n) { inv(out, in, n); });
+      }
+
       // complex-to-complex forward FFT
       inline
       void fwd( Complex * dst,const Complex *src,int nfft)
@@ -16,6 +16,28 @@ namespace internal {
   // This FFT implementation was derived from kissfft http:sourceforge.net/projects/kissfft
   // Copyright 2003-2009 Mark Borgerding
 
+// The k-th point of a batch of complex signals, one signal per lane of the Packet, with the real
+// and imaginary parts in separate packets so that the butterflies need no shuffles.
+template <typename Packet>
+struct kiss_cpx_lanes
+{
+  typedef typename unpacket_traits<Packet>::type Scalar;
+  typedef std::complex<Scalar> Complex;
+  kiss_cpx_lanes() {}
+  kiss_cpx_lanes(const Packet& r, const Packet& i) : re(r), im(i) {}
+  kiss_cpx_lanes& operator+=(const kiss_cpx_lanes& b) { re = padd(re,b.re); im = padd(im,b.im); return *this; }
+  kiss_cpx_lanes& operator*=(const Scalar& b) { re = pmul(re,pset1<Packet>(b)); im = pmul(im,pset1<Packet>(b)); return *this; }
+  friend kiss_cpx_lanes operator+(const kiss_cpx_lanes& a, const kiss_cpx_lanes& b) { return kiss_cpx_lanes(padd(a.re,b.re), padd(a.im,b.im)); }
+  friend kiss_cpx_lanes operator-(const kiss_cpx_lanes& a, const kiss_cpx_lanes& b) { return kiss_cpx_lanes(psub(a.re,b.re), psub(a.im,b.im)); }
+  friend kiss_cpx_lanes operator*(const kiss_cpx_lanes& a, const Scalar& b) { kiss_cpx_lanes r(a); return r *= b; }
+  friend kiss_cpx_lanes operator*(const kiss_cpx_lanes& a, const Complex& b)
+  {
+    const Packet br = pset1<Packet>(b.real()), bi = pset1<Packet>(b.imag());
+    return kiss_cpx_lanes(psub(pmul(a.re,br), pmul(a.im,bi)), pmadd(a.re,bi,pmul(a.im,br)));
+  }
+  Packet re, im;
+};
+
 template <typename Scalar_>
 struct kiss_cpx_fft
 {
@@ -24,7 +46,6 @@ struct kiss_cpx_fft
   std::vector<Complex> m_twiddles;
   std::vector<int> m_stageRadix;
   std::vector<int> m_stageRemainder;
-  std::vector<Complex> m_scratchBuf;
   bool m_inverse;
 
   inline void make_twiddles(int nfft, bool inverse)
@@ -87,19 +108,19 @@ struct kiss_cpx_fft
       n /= p;
       m_stageRadix.push_back(p);
       m_stageRemainder.push_back(n);
-      if ( p > 5 )
-        m_scratchBuf.resize(p); // scratchbuf will be needed in bfly_generic
     }while(n>1);
   }
 
-  template <typename Src_>
+  // The transforms work on values of type T, which is either Complex or, for the batched
+  // transforms, an Array of Complex holding the same coefficient of several signals.
+  template <typename T, typename Src_>
     inline
-    void work( int stage,Complex * xout, const Src_ * xin, size_t fstride,size_t in_stride)
+    void work( int stage,T * xout, const Src_ * xin, size_t fstride,size_t in_stride) const
     {
       int p = m_stageRadix[stage];
       int m = m_stageRemainder[stage];
-      Complex * Fout_beg = xout;
-      Complex * Fout_end = xout + p*m;
+      T * Fout_beg = xout;
+      T * Fout_end = xout + p*m;
 
       if (m>1) {
         do{
@@ -128,21 +149,30 @@ struct kiss_cpx_fft
       }
     }
 
+  // x * -i and x * i
+  static inline Complex mul_neg_i(const Complex& x) { return Complex(x.imag(), -x.real()); }
+  static inline Complex mul_i(const Complex& x) { return Complex(-x.imag(), x.real()); }
+  template <typename Packet>
+  static inline kiss_cpx_lanes<Packet> mul_neg_i(const kiss_cpx_lanes<Packet>& x) { return kiss_cpx_lanes<Packet>(x.im, pnegate(x.re)); }
+  template <typename Packet>
+  static inline kiss_cpx_lanes<Packet> mul_i(const kiss_cpx_lanes<Packet>& x) { return kiss_cpx_lanes<Packet>(pnegate(x.im), x.re); }
+
+  template <typename T>
   inline
-    void bfly2( Complex * Fout, const size_t fstride, int m)
+    void bfly2( T * Fout, const size_t fstride, int m) const
     {
       for (int k=0;k<m;++k) {
-        Complex t = Fout[m+k] * m_twiddles[k*fstride];
+        T t = Fout[m+k] * m_twiddles[k*fstride];
         Fout[m+k] = Fout[k] - t;
         Fout[k] += t;
       }
     }
 
+  template <typename T>
   inline
-    void bfly4( Complex * Fout, const size_t fstride, const size_t m)
+    void bfly4( T * Fout, const size_t fstride, const size_t m) const
     {
-      Complex scratch[6];
-      int negative_if_inverse = m_inverse * -2 +1;
+      T scratch[6];
       for (size_t k=0;k<m;++k) {
         scratch[0] = Fout[k+m] * m_twiddles[k*fstride];
         scratch[1] = Fout[k+2*m] * m_twiddles[k*fstride*2];
@@ -152,7 +182,7 @@ struct kiss_cpx_fft
         Fout[k] += scratch[1];
         scratch[3] = scratch[0] + scratch[2];
         scratch[4] = scratch[0] - scratch[2];
-        scratch[4] = Complex( scratch[4].imag()*negative_if_inverse , -scratch[4].real()* negative_if_inverse );
+        scratch[4] = m_inverse ? mul_i(scratch[4]) : mul_neg_i(scratch[4]);
 
         Fout[k+2*m]  = Fout[k] - scratch[3];
         Fout[k] += scratch[3];
@@ -161,13 +191,14 @@ struct kiss_cpx_fft
       }
     }
 
+  template <typename T>
   inline
-    void bfly3( Complex * Fout, const size_t fstride, const size_t m)
+    void bfly3( T * Fout, const size_t fstride, const size_t m) const
     {
       size_t k=m;
       const size_t m2 = 2*m;
-      Complex *tw1,*tw2;
-      Complex scratch[5];
+      const Complex *tw1,*tw2;
+      T scratch[5];
       Complex epi3;
       epi3 = m_twiddles[fstride*m];
 
@@ -181,23 +212,24 @@ struct kiss_cpx_fft
         scratch[0]=scratch[1]-scratch[2];
         tw1 += fstride;
         tw2 += fstride*2;
-        Fout[m] = Complex( Fout->real() - Scalar(.5)*scratch[3].real() , Fout->imag() - Scalar(.5)*scratch[3].imag() );
+        Fout[m] = *Fout - scratch[3] * Scalar(.5);
         scratch[0] *= epi3.imag();
         *Fout += scratch[3];
-        Fout[m2] = Complex(  Fout[m].real() + scratch[0].imag() , Fout[m].imag() - scratch[0].real() );
-        Fout[m] += Complex( -scratch[0].imag(),scratch[0].real() );
+        Fout[m2] = Fout[m] + mul_neg_i(scratch[0]);
+        Fout[m] += mul_i(scratch[0]);
         ++Fout;
       }while(--k);
     }
 
+  template <typename T>
   inline
-    void bfly5( Complex * Fout, const size_t fstride, const size_t m)
+    void bfly5( T * Fout, const size_t fstride, const size_t m) const
     {
-      Complex *Fout0,*Fout1,*Fout2,*Fout3,*Fout4;
+      T *Fout0,*Fout1,*Fout2,*Fout3,*Fout4;
       size_t u;
-      Complex scratch[13];
-      Complex * twiddles = &m_twiddles[0];
-      Complex *tw;
+      T scratch[13];
+      const Complex * twiddles = &m_twiddles[0];
+      const Complex *tw;
       Complex ya,yb;
       ya = twiddles[fstride*m];
       yb = twiddles[fstride*2*m];
@@ -225,29 +257,14 @@ struct kiss_cpx_fft
         *Fout0 +=  scratch[7];
         *Fout0 +=  scratch[8];
 
-        scratch[5] = scratch[0] + Complex(
-            (scratch[7].real()*ya.real() ) + (scratch[8].real() *yb.real() ),
-            (scratch[7].imag()*ya.real()) + (scratch[8].imag()*yb.real())
-            );
-
-        scratch[6] = Complex(
-            (scratch[10].imag()*ya.imag()) + (scratch[9].imag()*yb.imag()),
-            -(scratch[10].real()*ya.imag()) - (scratch[9].real()*yb.imag())
-            );
+        scratch[5] = scratch[0] + (scratch[7]*ya.real() + scratch[8]*yb.real());
+        scratch[6] = mul_neg_i(scratch[10]*ya.imag() + scratch[9]*yb.imag());
 
         *Fout1 = scratch[5] - scratch[6];
         *Fout4 = scratch[5] + scratch[6];
 
-        scratch[11] = scratch[0] +
-          Complex(
-              (scratch[7].real()*yb.real()) + (scratch[8].real()*ya.real()),
-              (scratch[7].imag()*yb.real()) + (scratch[8].imag()*ya.real())
-              );
-
-        scratch[12] = Complex(
-            -(scratch[10].imag()*yb.imag()) + (scratch[9].imag()*ya.imag()),
-            (scratch[10].real()*yb.imag()) - (scratch[9].real()*ya.imag())
-            );
+        scratch[11] = scratch[0] + (scratch[7]*yb.real() + scratch[8]*ya.real());
+        scratch[12] = mul_neg_i(scratch[9]*ya.imag() - scratch[10]*yb.imag());
 
         *Fout2=scratch[11]+scratch[12];
         *Fout3=scratch[11]-scratch[12];
@@ -257,19 +274,21 @@ struct kiss_cpx_fft
     }
 
   /* perform the butterfly for one stage of a mixed radix FFT */
+  template <typename T>
   inline
     void bfly_generic(
-        Complex * Fout,
+        T * Fout,
         const size_t fstride,
         int m,
         int p
-        )
+        ) const
     {
       int u,k,q1,q;
-      Complex * twiddles = &m_twiddles[0];
-      Complex t;
+      const Complex * twiddles = &m_twiddles[0];
+      T t;
       int Norig = static_cast<int>(m_twiddles.size());
-      Complex * scratchbuf = &m_scratchBuf[0];
+      // the plans are shared between threads, so the scratch buffer is local
+      ei_declare_aligned_stack_constructed_variable(T,scratchbuf,p,0);
 
       for ( u=0; u<m; ++u ) {
         k=u;
@@ -294,6 +313,65 @@ struct kiss_cpx_fft
     }
 };
 
+/** \internal
+  * Process wide LRU cache of the kissfft plans and real twiddles, shared by all the kissfft_impl
+  * objects and protected by a mutex. Cached objects are immutable, and stay alive as long as a
+  * kissfft_impl uses them, even after they have been evicted.
+  */
+template <typename T>
+class kissfft_shared_cache
+{
+  public:
+  /** \returns the object cached under \a key, and creates it with \a make() if it is not in the cache. */
+  template <typename Make>
+  static std::shared_ptr<const T> get(int key, const Make& make)
+  {
+    State& state = instance();
+    {
+      std::lock_guard<std::mutex> lock(state.mutex);
+      typename IndexMap::iterator it = state.index.find(key);
+      if (it != state.index.end()) {
+        // move the entry to the front of the LRU list
+        state.entries.splice(state.entries.begin(), state.entries, it->second);
+        return it->second->second;
+      }
+    }
+
+    // build the object without holding the lock
+    std::shared_ptr<const T> value = std::make_shared<const T>(make());
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    typename IndexMap::iterator it = state.index.find(key);
+    if (it != state.index.end())
+      return it->second->second; // another thread created it in the meantime
+    state.entries.push_front(Entry(key, value));
+    state.index[key] = state.entries.begin();
+    if (state.entries.size() > EIGEN_FFT_PLAN_CACHE_SIZE) {
+      state.index.erase(state.entries.back().first);
+      state.entries.pop_back();
+    }
+    return value;
+  }
+
+  protected:
+  typedef std::pair<int, std::shared_ptr<const T> > Entry;
+  typedef std::list<Entry> EntryList;
+  typedef std::map<int, typename EntryList::iterator> IndexMap;
+
+  struct State
+  {
+    std::mutex mutex;
+    EntryList entries; // most recently used first
+    IndexMap index;
+  };
+
+  static State& instance()
+  {
+    static State state;
+    return state;
+  }
+};
+
 template <typename Scalar_>
 struct kissfft_impl
 {
@@ -306,6 +384,19 @@ struct kissfft_impl
     m_realTwiddles.clear();
   }
 
+  // creates the plans and twiddles used by the transforms of size nfft
+  inline
+    void warmup(int nfft)
+    {
+      get_plan(nfft,false);
+      get_plan(nfft,true);
+      if ( (nfft&1) == 0 ) {
+        get_plan(nfft>>1,false);
+        get_plan(nfft>>1,true);
+        real_twiddles(nfft>>1);
+      }
+    }
+
   inline
     void fwd( Complex * dst,const Complex *src,int nfft)
     {
@@ -337,30 +428,20 @@ struct kissfft_impl
   inline
     void fwd( Complex * dst,const Scalar * src,int nfft) 
     {
-      if ( nfft&3  ) {
+      if ( nfft&1  ) {
         // use generic mode for odd
         m_tmpBuf1.resize(nfft);
         get_plan(nfft,false).work(0, &m_tmpBuf1[0], src, 1,1);
         std::copy(m_tmpBuf1.begin(),m_tmpBuf1.begin()+(nfft>>1)+1,dst );
       }else{
         int ncfft = nfft>>1;
-        int ncfft2 = nfft>>2;
-        Complex * rtw = real_twiddles(ncfft2);
+        const Complex * rtw = real_twiddles(ncfft);
 
         // use optimized mode for even real
         fwd( dst, reinterpret_cast<const Complex*> (src), ncfft);
         Complex dc(dst[0].real() +  dst[0].imag());
         Complex nyquist(dst[0].real() -  dst[0].imag());
-        int k;
-        for ( k=1;k <= ncfft2 ; ++k ) {
-          Complex fpk = dst[k];
-          Complex fpnk = conj(dst[ncfft-k]);
-          Complex f1k = fpk + fpnk;
-          Complex f2k = fpk - fpnk;
-          Complex tw= f2k * rtw[k-1];
-          dst[k] =  (f1k + tw) * Scalar(.5);
-          dst[ncfft-k] =  conj(f1k -tw)*Scalar(.5);
-        }
+        real_split(dst, dst, rtw, ncfft, false, Scalar(.5));
         dst[0] = dc;
         dst[ncfft] = nyquist;
       }
@@ -377,7 +458,7 @@ struct kissfft_impl
   inline
     void inv( Scalar * dst,const Complex * src,int nfft) 
     {
-      if (nfft&3) {
+      if (nfft&1) {
         m_tmpBuf1.resize(nfft);
         m_tmpBuf2.resize(nfft);
         std::copy(src,src+(nfft>>1)+1,m_tmpBuf1.begin() );
@@ -387,62 +468,236 @@ struct kissfft_impl
         for (int k=0;k<nfft;++k)
           dst[k] = m_tmpBuf2[k].real();
       }else{
-        // optimized version for multiple of 4
+        // optimized version for even sizes
         int ncfft = nfft>>1;
-        int ncfft2 = nfft>>2;
-        Complex * rtw = real_twiddles(ncfft2);
+        const Complex * rtw = real_twiddles(ncfft);
         m_tmpBuf1.resize(ncfft);
         m_tmpBuf1[0] = Complex( src[0].real() + src[ncfft].real(), src[0].real() - src[ncfft].real() );
-        for (int k = 1; k <= ncfft / 2; ++k) {
-          Complex fk = src[k];
-          Complex fnkc = conj(src[ncfft-k]);
-          Complex fek = fk + fnkc;
-          Complex tmp = fk - fnkc;
-          Complex fok = tmp * conj(rtw[k-1]);
-          m_tmpBuf1[k] = fek + fok;
-          m_tmpBuf1[ncfft-k] = conj(fek - fok);
-        }
+        real_split(&m_tmpBuf1[0], src, rtw, ncfft, true, Scalar(1));
         get_plan(ncfft,true).work(0, reinterpret_cast<Complex*>(dst), &m_tmpBuf1[0], 1,1);
       }
     }
 
+  // batched transforms of howmany signals of nfft points, the k-th point of the b-th signal
+  // being at src[b*src_dist + k*src_stride] (and likewise for dst)
+  template <typename Dst, typename Src>
+  inline
+    void fwd_batch(Dst * dst, Index dst_stride, Index dst_dist, const Src * src, Index src_stride, Index src_dist, int nfft, Index howmany)
+    {
+      batch(false, dst, dst_stride, dst_dist, src, src_stride, src_dist, nfft, howmany);
+    }
+
+  template <typename Dst, typename Src>
+  inline
+    void inv_batch(Dst * dst, Index dst_stride, Index dst_dist, const Src * src, Index src_stride, Index src_dist, int nfft, Index howmany)
+    {
+      batch(true, dst, dst_stride, dst_dist, src, src_stride, src_dist, nfft, howmany);
+    }
+
   protected:
   typedef kiss_cpx_fft<Scalar> PlanData;
-  typedef std::map<int,PlanData> PlanMap;
+  typedef std::vector<Complex> RealTwiddles;
+  // the plans and twiddles of the process wide cache used by this object
+  typedef std::map<int,std::shared_ptr<const PlanData> > PlanMap;
 
   PlanMap m_plans;
-  std::map<int, std::vector<Complex> > m_realTwiddles;
+  std::map<int, std::shared_ptr<const RealTwiddles> > m_realTwiddles;
   std::vector<Complex> m_tmpBuf1;
   std::vector<Complex> m_tmpBuf2;
 
   inline
     int PlanKey(int nfft, bool isinverse) const { return (nfft<<1) | int(isinverse); }
 
+  // The batched transforms work on BatchLanes signals at once, the k-th point of the signals being
+  // stored in the k-th coefficient of a BatchBuffer. Pairs of real signals are stored as the real
+  // and imaginary parts of a complex signal.
+  typedef typename packet_traits<Scalar>::type BatchPacket;
+  enum { BatchLanes = unpacket_traits<BatchPacket>::size };
+  typedef kiss_cpx_lanes<BatchPacket> BatchValue;
+  typedef std::vector<BatchValue, aligned_allocator<BatchValue> > BatchBuffer;
+
+  template <typename Dst, typename Src>
+  inline
+    void batch(bool inverse, Dst * dst, Index dst_stride, Index dst_dist, const Src * src, Index src_stride, Index src_dist, int nfft, Index howmany)
+    {
+      const bool real = NumTraits<Src>::IsComplex == 0 || NumTraits<Dst>::IsComplex == 0;
+      const Index group_size = real ? 2*BatchLanes : BatchLanes;
+      const Index groups = (howmany + group_size - 1) / group_size;
+      const Index tasks = numext::mini(numext::mini(groups, parallel_loop_threads()), howmany*Index(nfft)/32768 + 1);
+      // the plan is looked up before the tasks start, since get_plan() is not thread-safe
+      const PlanData & plan = get_plan(nfft,inverse);
+      parallelize_tasks(tasks, [&](Index t) {
+        BatchBuffer in(nfft), out(nfft);
+        for (Index g = groups*t/tasks; g < groups*(t+1)/tasks; ++g) {
+          const Index first = g*group_size;
+          const Index count = numext::mini(group_size, howmany-first);
+          load_batch(&in[0], src + first*src_dist, src_stride, src_dist, nfft, count, NumTraits<Dst>::IsComplex == 0);
+          plan.work(0, &out[0], &in[0], 1, 1);
+          store_batch(dst + first*dst_dist, dst_stride, dst_dist, &out[0], nfft, count, NumTraits<Src>::IsComplex == 0);
+        }
+      });
+    }
+
+  // complex signals, or the half spectra of real signals
+  inline
+    void load_batch(BatchValue * in, const Complex * src, Index stride, Index dist, int nfft, Index count, bool half_spectrum) const
+    {
+      EIGEN_ALIGN_MAX Scalar re[BatchLanes], im[BatchLanes];
+      for (int k=0;k<nfft;++k) {
+        if (!half_spectrum) {
+          for (Index l=0;l<BatchLanes;++l) {
+            const Complex x = l<count ? src[l*dist + k*stride] : Complex(0);
+            re[l] = x.real();
+            im[l] = x.imag();
+          }
+        } else {
+          // rebuild the conjugate-symmetric spectra, with real DC and Nyquist bins, and put the
+          // second signal of each pair in the imaginary part of the inverse transform
+          const int kk = 2*k <= nfft ? k : nfft-k;
+          const bool realbin = k==0 || 2*k==nfft;
+          const Scalar sign = kk!=k ? Scalar(-1) : Scalar(1);
+          for (Index l=0;l<BatchLanes;++l) {
+            const Complex x = 2*l<count ? src[2*l*dist + kk*stride] : Complex(0);
+            const Complex y = 2*l+1<count ? src[(2*l+1)*dist + kk*stride] : Complex(0);
+            const Scalar xi = realbin ? Scalar(0) : sign*x.imag();
+            const Scalar yi = realbin ? Scalar(0) : sign*y.imag();
+            re[l] = x.real() - yi;
+            im[l] = xi + y.real();
+          }
+        }
+        in[k] = BatchValue(pload<BatchPacket>(re), pload<BatchPacket>(im));
+      }
+    }
+
+  // pairs of real signals
+  inline
+    void load_batch(BatchValue * in, const Scalar * src, Index stride, Index dist, int nfft, Index count, bool) const
+    {
+      EIGEN_ALIGN_MAX Scalar re[BatchLanes], im[BatchLanes];
+      for (int k=0;k<nfft;++k) {
+        for (Index l=0;l<BatchLanes;++l) {
+          re[l] = 2*l<count ? src[2*l*dist + k*stride] : Scalar(0);
+          im[l] = 2*l+1<count ? src[(2*l+1)*dist + k*stride] : Scalar(0);
+        }
+        in[k] = BatchValue(pload<BatchPacket>(re), pload<BatchPacket>(im));
+      }
+    }
+
+  // complex transforms, or the half spectra of pairs of real signals
   inline
-    PlanData & get_plan(int nfft, bool inverse)
+    void store_batch(Complex * dst, Index stride, Index dist, const BatchValue * out, int nfft, Index count, bool real_input) const
+    {
+      EIGEN_ALIGN_MAX Scalar re[BatchLanes], im[BatchLanes];
+      if (!real_input) {
+        for (int k=0;k<nfft;++k) {
+          pstore(re, out[k].re);
+          pstore(im, out[k].im);
+          for (Index l=0;l<count;++l)
+            dst[l*dist + k*stride] = Complex(re[l], im[l]);
+        }
+        return;
+      }
+      // split the transform Z of x+i*y into X(k) = (Z(k) + conj(Z(-k)))/2 and Y(k) = (Z(k) - conj(Z(-k)))/(2i)
+      EIGEN_ALIGN_MAX Scalar yre[BatchLanes], yim[BatchLanes];
+      const BatchPacket half = pset1<BatchPacket>(Scalar(.5));
+      for (int k=0;k<=nfft/2;++k) {
+        const BatchValue & z = out[k];
+        const BatchValue & zn = out[k==0 ? 0 : nfft-k];
+        pstore(re, pmul(padd(z.re,zn.re),half));
+        pstore(im, pmul(psub(z.im,zn.im),half));
+        pstore(yre, pmul(padd(z.im,zn.im),half));
+        pstore(yim, pmul(psub(zn.re,z.re),half));
+        for (Index l=0;2*l<count;++l) {
+          dst[2*l*dist + k*stride] = Complex(re[l], im[l]);
+          if (2*l+1<count)
+            dst[(2*l+1)*dist + k*stride] = Complex(yre[l], yim[l]);
+        }
+      }
+    }
+
+  // pairs of real signals, from the real and imaginary parts
+  inline
+    void store_batch(Scalar * dst, Index stride, Index dist, const BatchValue * out, int nfft, Index count, bool) const
+    {
+      EIGEN_ALIGN_MAX Scalar re[BatchLanes], im[BatchLanes];
+      for (int k=0;k<nfft;++k) {
+        pstore(re, out[k].re);
+        pstore(im, out[k].im);
+        for (Index l=0;2*l<count;++l) {
+          dst[2*l*dist + k*stride] = re[l];
+          if (2*l+1<count)
+            dst[(2*l+1)*dist + k*stride] = im[l];
+        }
+      }
+    }
+
+
+  inline
+    const PlanData & get_plan(int nfft, bool inverse)
     {
       // TODO look for PlanKey(nfft, ! inverse) and conjugate the twiddles
-      PlanData & pd = m_plans[ PlanKey(nfft,inverse) ];
-      if ( pd.m_twiddles.size() == 0 ) {
-        pd.make_twiddles(nfft,inverse);
-        pd.factorize(nfft);
+      std::shared_ptr<const PlanData> & pd = m_plans[ PlanKey(nfft,inverse) ];
+      if ( !pd ) {
+        pd = kissfft_shared_cache<PlanData>::get(PlanKey(nfft,inverse), [nfft,inverse]() {
+          PlanData plan;
+          plan.make_twiddles(nfft,inverse);
+          plan.factorize(nfft);
+          return plan;
+        });
       }
-      return pd;
+      return *pd;
     }
 
+  // the twiddles exp(-i*pi*(k/ncfft+1/2)) of the real transforms of size 2*ncfft, for 0<k<=ncfft/2
   inline
-    Complex * real_twiddles(int ncfft2)
+    const Complex * real_twiddles(int ncfft)
     {
-      using std::acos;
-      std::vector<Complex> & twidref = m_realTwiddles[ncfft2];// creates new if not there
-      if ( (int)twidref.size() != ncfft2 ) {
-        twidref.resize(ncfft2);
-        int ncfft= ncfft2<<1;
-        Scalar pi =  acos( Scalar(-1) );
-        for (int k=1;k<=ncfft2;++k) 
-          twidref[k-1] = exp( Complex(0,-pi * (Scalar(k) / ncfft + Scalar(.5)) ) );
+      std::shared_ptr<const RealTwiddles> & twidref = m_realTwiddles[ncfft];// creates new if not there
+      if ( !twidref ) {
+        twidref = kissfft_shared_cache<RealTwiddles>::get(ncfft, [ncfft]() {
+          using std::acos;
+          RealTwiddles twiddles(numext::maxi(ncfft>>1,1));
+          Scalar pi =  acos( Scalar(-1) );
+          for (int k=1;k<=(ncfft>>1);++k) 
+            twiddles[k-1] = exp( Complex(0,-pi * (Scalar(k) / ncfft + Scalar(.5)) ) );
+          return twiddles;
+        });
+      }
+      return &(*twidref)[0];
+    }
+
+  // Recombines the transform of a real signal of size 2*ncfft, computed as a complex signal of
+  // size ncfft, with the packed spectrum in src (forward), or the other way round (inverse):
+  // dst[k] = scale*(f1 + f2*w) and dst[ncfft-k] = scale*conj(f1 - f2*w) for 0<k<=ncfft/2, with
+  // f1, f2 = src[k] +/- conj(src[ncfft-k]), and w = rtw[k-1] or its conjugate. dst may be src.
+  static inline
+    void real_split(Complex * dst, const Complex * src, const Complex * rtw, int ncfft, bool conj_twiddles, Scalar scale)
+    {
+      typedef typename packet_traits<Complex>::type Packet;
+      enum { PacketSize = unpacket_traits<Packet>::size };
+      const Packet pscale = pset1<Packet>(Complex(scale));
+      int k = 1;
+      // the packets of the two halves must not overlap for the in-place forward split
+      for (; 2*(k+PacketSize-1) < ncfft; k += PacketSize) {
+        const int nk = ncfft-k-PacketSize+1;
+        const Packet fk = ploadu<Packet>(src+k);
+        const Packet fnkc = pconj(preverse(ploadu<Packet>(src+nk)));
+        Packet w = ploadu<Packet>(rtw+k-1);
+        if (conj_twiddles)
+          w = pconj(w);
+        const Packet f1 = padd(fk, fnkc);
+        const Packet tw = pmul(psub(fk, fnkc), w);
+        pstoreu(dst+k, pmul(padd(f1, tw), pscale));
+        pstoreu(dst+nk, preverse(pconj(pmul(psub(f1, tw), pscale))));
+      }
+      for (; k <= ncfft/2; ++k) {
+        const Complex fk = src[k];
+        const Complex fnkc = conj(src[ncfft-k]);
+        const Complex f1 = fk + fnkc;
+        const Complex tw = (fk - fnkc) * (conj_twiddles ? conj(rtw[k-1]) : rtw[k-1]);
+        dst[k] = (f1 + tw) * scale;
+        dst[ncfft-k] = conj(f1 - tw) * scale;
       }
-      return &twidref[0];
     }
 };
 
@@ -20,6 +20,22 @@ struct pocketfft_impl
 
   inline void clear() {}
 
+  // pocketfft caches its plans internally
+  inline void warmup(int) {}
+
+  // batched transforms, one signal at a time
+  template <typename Dst, typename Src>
+  inline void fwd_batch(Dst* dst, Index dst_stride, Index dst_dist, const Src* src, Index src_stride, Index src_dist, int nfft, Index howmany){
+    fft_batch_by_signal(dst, dst_stride, dst_dist, src, src_stride, src_dist, nfft, howmany,
+                        [this](Dst* out, const Src* in, int n) { fwd(out, in, n); });
+  }
+
+  template <typename Dst, typename Src>
+  inline void inv_batch(Dst* dst, Index dst_stride, Index dst_dist, const Src* src, Index src_stride, Index src_dist, int nfft, Index howmany){
+    fft_batch_by_signal(dst, dst_stride, dst_dist, src, src_stride, src_dist, nfft, howmany,
+                        [this](Dst* out, const Src* in, int n) { inv(out, in, n); });
+  }
+
   inline void fwd(Complex* dst, const Scalar* src, int nfft){
     const shape_t  shape_{ static_cast<size_t>(nfft) };
     const shape_t  axes_{ 0 };
@@ -0,0 +1,178 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_GEMM_THREADPOOL
+#include "main.h"
+#include <Eigen/LU>
+#include <Eigen/Cholesky>
+#include <unsupported/Eigen/BatchedLinearAlgebra>
+
+template<typename Scalar>
+void test_matrix_batch_layout()
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  const Index size = internal::random<Index>(1, 40);
+  const Index rows = internal::random<Index>(1, 9), cols = internal::random<Index>(1, 9);
+  const Index outer = rows + internal::random<Index>(0, 3);
+  const Index stride = outer * cols + internal::random<Index>(0, 5);
+
+  Matrix<Scalar,Dynamic,1> data = Matrix<Scalar,Dynamic,1>::Random(stride * size);
+  MatrixBatch<Scalar> batch(size, rows, cols);
+  batch.pack(data.data(), stride, outer);
+  for(Index b = 0; b < size; ++b)
+  {
+    MatrixType ref = Map<MatrixType, 0, OuterStride<> >(data.data() + b * stride, rows, cols, OuterStride<>(outer));
+    VERIFY_IS_EQUAL(batch.matrix(b), ref);
+  }
+
+  Matrix<Scalar,Dynamic,1> copy = Matrix<Scalar,Dynamic,1>::Zero(stride * size);
+  batch.unpack(copy.data(), stride, outer);
+  for(Index b = 0; b < size; ++b)
+    VERIFY_IS_EQUAL((Map<MatrixType, 0, OuterStride<> >(copy.data() + b * stride, rows, cols, OuterStride<>(outer))),
+                    (Map<MatrixType, 0, OuterStride<> >(data.data() + b * stride, rows, cols, OuterStride<>(outer))));
+
+  MatrixType m = MatrixType::Random(rows, cols);
+  batch.setMatrix(size - 1, m);
+  VERIFY_IS_EQUAL(batch.matrix(size - 1), m);
+  VERIFY_IS_EQUAL(batch(size - 1, rows - 1, cols - 1), m(rows - 1, cols - 1));
+}
+
+template<typename Scalar>
+void test_batched_gemm(Index size, Index rows, Index cols, Index depth)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  MatrixBatch<Scalar> a(size, rows, depth), b(size, depth, cols), c(size, rows, cols), d(size, rows, cols);
+  std::vector<MatrixType> c_ref(size);
+  for(Index k = 0; k < size; ++k)
+  {
+    a.setMatrix(k, MatrixType::Random(rows, depth));
+    b.setMatrix(k, MatrixType::Random(depth, cols));
+    c.setMatrix(k, MatrixType::Random(rows, cols));
+    d.setMatrix(k, MatrixType::Constant(rows, cols, std::numeric_limits<typename NumTraits<Scalar>::Real>::quiet_NaN()));
+    c_ref[k] = c.matrix(k);
+  }
+  const Scalar alpha = internal::random<Scalar>(), beta = internal::random<Scalar>();
+  batchedGemm(alpha, a, b, beta, c);
+  batchedGemm(alpha, a, b, Scalar(0), d);
+  for(Index k = 0; k < size; ++k)
+  {
+    MatrixType ab = a.matrix(k) * b.matrix(k);
+    VERIFY_IS_APPROX(c.matrix(k), (alpha * ab + beta * c_ref[k]).eval());
+    VERIFY_IS_APPROX(d.matrix(k), (alpha * ab).eval());
+  }
+}
+
+template<typename Scalar>
+void test_batched_lu(Index size, Index n, Index nrhs)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  MatrixBatch<Scalar> a(size, n, n), rhs(size, n, nrhs);
+  std::vector<MatrixType> a_ref(size), rhs_ref(size);
+  for(Index k = 0; k < size; ++k)
+  {
+    a_ref[k] = MatrixType::Random(n, n);
+    rhs_ref[k] = MatrixType::Random(n, nrhs);
+    a.setMatrix(k, a_ref[k]);
+    rhs.setMatrix(k, rhs_ref[k]);
+  }
+  // a singular matrix gets the same factors as PartialPivLU
+  if(n > 1)
+  {
+    a_ref[0].col(n / 2).setZero();
+    a.setMatrix(0, a_ref[0]);
+  }
+
+  Matrix<int,Dynamic,Dynamic> transpositions;
+  batchedPartialPivLu(a, transpositions);
+  VERIFY_IS_EQUAL(transpositions.rows(), n);
+  VERIFY_IS_EQUAL(transpositions.cols(), size);
+  batchedLuSolve(a, transpositions, rhs);
+  for(Index k = 0; k < size; ++k)
+  {
+    PartialPivLU<MatrixType> lu(a_ref[k]);
+    VERIFY_IS_APPROX(a.matrix(k), lu.matrixLU());
+    Transpositions<Dynamic> tr(n);
+    tr.indices() = transpositions.col(k);
+    VERIFY_IS_EQUAL(PermutationMatrix<Dynamic>(tr).indices(), lu.permutationP().indices());
+    if(k > 0 || n == 1)
+      VERIFY_IS_APPROX(rhs.matrix(k), lu.solve(rhs_ref[k]));
+  }
+}
+
+template<typename Scalar>
+void test_batched_llt(Index size, Index n, Index nrhs)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  MatrixBatch<Scalar> a(size, n, n), rhs(size, n, nrhs);
+  std::vector<MatrixType> a_ref(size), rhs_ref(size);
+  for(Index k = 0; k < size; ++k)
+  {
+    MatrixType m = MatrixType::Random(n, n);
+    a_ref[k] = m * m.adjoint() + MatrixType::Identity(n, n);
+    rhs_ref[k] = MatrixType::Random(n, nrhs);
+    a.setMatrix(k, a_ref[k]);
+    rhs.setMatrix(k, rhs_ref[k]);
+  }
+  // one matrix which is not positive definite
+  const Index bad = internal::random<Index>(0, size - 1);
+  a.setMatrix(bad, (-a_ref[bad]).eval());
+
+  std::vector<ComputationInfo> info;
+  VERIFY_IS_EQUAL(batchedLlt(a, &info), NumericalIssue);
+  VERIFY_IS_EQUAL(Index(info.size()), size);
+  batchedLltSolve(a, rhs);
+  for(Index k = 0; k < size; ++k)
+  {
+    if(k == bad)
+    {
+      VERIFY_IS_EQUAL(info[k], NumericalIssue);
+      continue;
+    }
+    VERIFY_IS_EQUAL(info[k], Success);
+    LLT<MatrixType> llt(a_ref[k]);
+    MatrixType l = a.matrix(k).template triangularView<Lower>();
+    VERIFY_IS_APPROX(l, MatrixType(llt.matrixL()));
+    VERIFY_IS_APPROX(rhs.matrix(k), llt.solve(rhs_ref[k]));
+  }
+
+  for(Index k = 0; k < size; ++k)
+    a.setMatrix(k, a_ref[k]);
+  VERIFY_IS_EQUAL(batchedLlt(a), Success);
+}
+
+template<typename Scalar>
+void test_batched(Index size, Index n)
+{
+  test_batched_gemm<Scalar>(size, n, n, n);
+  test_batched_gemm<Scalar>(size, internal::random<Index>(1, n), internal::random<Index>(1, n), internal::random<Index>(1, n));
+  test_batched_lu<Scalar>(size, n, internal::random<Index>(1, 3));
+  test_batched_llt<Scalar>(size, n, internal::random<Index>(1, 3));
+}
+
+// Large batches are split over the threads of the pool.
+template<typename Scalar>
+void test_batched_threaded(int num_threads)
+{
+  ThreadPool pool(num_threads);
+  setGemmThreadPool(&pool);
+  test_batched<Scalar>(internal::random<Index>(500, 1000), internal::random<Index>(8, 24));
+  setGemmThreadPool(nullptr);
+}
+
+EIGEN_DECLARE_TEST(batched_linear_algebra)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( test_matrix_batch_layout<float>() ));
+    CALL_SUBTEST_1(( test_matrix_batch_layout<std::complex<double> >() ));
+    CALL_SUBTEST_2(( test_batched<float>(internal::random<Index>(1, 40), internal::random<Index>(1, 12)) ));
+    CALL_SUBTEST_3(( test_batched<double>(internal::random<Index>(1, 40), internal::random<Index>(1, 12)) ));
+    CALL_SUBTEST_4(( test_batched<std::complex<float> >(internal::random<Index>(1, 40), internal::random<Index>(1, 12)) ));
+    CALL_SUBTEST_5(( test_batched<std::complex<double> >(internal::random<Index>(1, 40), internal::random<Index>(1, 12)) ));
+    CALL_SUBTEST_6(( test_batched_threaded<double>(internal::random<int>(2, 8)) ));
+  }
+  CALL_SUBTEST_3(( test_batched<double>(37, 64) ));
+}
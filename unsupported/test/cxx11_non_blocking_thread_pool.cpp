@@ -169,6 +169,37 @@ static void test_pool_partitions() {
   phase = 2;
 }
 
+static void test_numa_pool() {
+  const std::vector<int> list = internal::ParseNumaList("0-3,8,10-11");
+  const int expected[] = {0, 1, 2, 3, 8, 10, 11};
+  VERIFY_IS_EQUAL(list.size(), 7u);
+  for (int i = 0; i < 7; ++i) VERIFY_IS_EQUAL(list[i], expected[i]);
+
+  const int kThreads = 4;
+  ThreadPool tp(kThreads, true, /*numa_aware=*/true);
+  VERIFY_GE(tp.NumNumaNodes(), 1);
+  VERIFY_IS_EQUAL(tp.CurrentNumaNode(), -1);
+
+  // The workers run on a node when the pool spans several ones.
+  std::vector<int> nodes;
+  const std::vector<internal::NumaNode> topology = internal::NumaTopology();
+  for (const internal::NumaNode& node : topology) nodes.push_back(node.id);
+  std::atomic<int> done(0);
+  for (int i = 0; i < 100; ++i) {
+    tp.Schedule([&]() {
+      const int node = tp.CurrentNumaNode();
+      if (tp.NumNumaNodes() > 1) {
+        VERIFY(std::find(nodes.begin(), nodes.end(), node) != nodes.end());
+      } else {
+        VERIFY_IS_EQUAL(node, -1);
+      }
+      ++done;
+    });
+  }
+  while (done != 100) {
+  }
+}
+
 
 EIGEN_DECLARE_TEST(cxx11_non_blocking_thread_pool)
 {
@@ -177,4 +208,5 @@ EIGEN_DECLARE_TEST(cxx11_non_blocking_thread_pool)
   CALL_SUBTEST(test_parallelism(false));
   CALL_SUBTEST(test_cancel());
   CALL_SUBTEST(test_pool_partitions());
+  CALL_SUBTEST(test_numa_pool());
 }
@@ -137,6 +137,58 @@ static void test_strides() {
                                input(12)*kernel(2)));
 }
 
+// Large kernels are evaluated by the im2col or the FFT algorithms, depending on their sizes: compare the result
+// with a naive evaluation.
+template <typename Scalar, int DataLayout, int NumKernelDims>
+static void test_large_kernel(const Eigen::array<Eigen::Index, 3>& input_dims,
+                              const Eigen::array<Eigen::Index, NumKernelDims>& kernel_dims,
+                              const Eigen::array<Eigen::Index, NumKernelDims>& dims) {
+  typedef Eigen::Index Index;
+  Tensor<Scalar, 3, DataLayout> input(input_dims);
+  Tensor<Scalar, NumKernelDims, DataLayout> kernel(kernel_dims);
+  input.setRandom();
+  kernel.setRandom();
+
+  Eigen::array<Index, 3> result_dims = input_dims;
+  for (int i = 0; i < NumKernelDims; ++i) result_dims[dims[i]] -= kernel_dims[i] - 1;
+  Tensor<Scalar, 3, DataLayout> expected(result_dims);
+  expected.setZero();
+  for (Index k = 0; k < kernel.size(); ++k) {
+    Eigen::array<Index, NumKernelDims> k_idx;
+    Index rem = k;
+    for (int i = 0; i < NumKernelDims; ++i) {
+      k_idx[i] = rem % kernel_dims[i];
+      rem /= kernel_dims[i];
+    }
+    Eigen::array<Index, 3> offset;
+    offset.fill(0);
+    for (int i = 0; i < NumKernelDims; ++i) offset[dims[i]] = k_idx[i];
+    expected += input.slice(offset, result_dims) * kernel(k_idx);
+  }
+
+  Tensor<Scalar, 3, DataLayout> result = input.convolve(kernel, dims);
+  VERIFY_IS_EQUAL(result.dimensions(), expected.dimensions());
+  typedef Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, 1> > VectorMap;
+  VERIFY_IS_APPROX(VectorMap(result.data(), result.size()), VectorMap(expected.data(), expected.size()));
+
+  // as a sub-expression
+  Tensor<Scalar, 3, DataLayout> sum = input.convolve(kernel, dims) + expected;
+  VERIFY_IS_APPROX(VectorMap(sum.data(), sum.size()), Scalar(2) * VectorMap(expected.data(), expected.size()));
+}
+
+template <typename Scalar, int DataLayout>
+static void test_large_kernels() {
+  typedef Eigen::array<Eigen::Index, 1> Dims1;
+  typedef Eigen::array<Eigen::Index, 2> Dims2;
+  typedef Eigen::array<Eigen::Index, 3> Dims3;
+  test_large_kernel<Scalar, DataLayout, 1>(Dims3{{20000, 2, 1}}, Dims1{{80}}, Dims1{{0}});
+  test_large_kernel<Scalar, DataLayout, 1>(Dims3{{3, 10000, 2}}, Dims1{{300}}, Dims1{{1}});
+  test_large_kernel<Scalar, DataLayout, 1>(Dims3{{2, 3, 30000}}, Dims1{{1000}}, Dims1{{2}});
+  test_large_kernel<Scalar, DataLayout, 1>(Dims3{{300, 40, 20}}, Dims1{{200}}, Dims1{{0}});
+  test_large_kernel<Scalar, DataLayout, 2>(Dims3{{300, 3, 250}}, Dims2{{12, 16}}, Dims2{{0, 2}});
+  test_large_kernel<Scalar, DataLayout, 2>(Dims3{{2, 400, 300}}, Dims2{{30, 25}}, Dims2{{2, 1}});
+}
+
 EIGEN_DECLARE_TEST(cxx11_tensor_convolution)
 {
   CALL_SUBTEST(test_evals<ColMajor>());
@@ -147,4 +199,7 @@ EIGEN_DECLARE_TEST(cxx11_tensor_convolution)
   CALL_SUBTEST(test_modes<RowMajor>());
   CALL_SUBTEST(test_strides<ColMajor>());
   CALL_SUBTEST(test_strides<RowMajor>());
+  CALL_SUBTEST(( test_large_kernels<float, ColMajor>() ));
+  CALL_SUBTEST(( test_large_kernels<double, RowMajor>() ));
+  CALL_SUBTEST(( test_large_kernels<std::complex<float>, ColMajor>() ));
 }
@@ -72,6 +72,39 @@ static void test_custom()
   }
 }
 
+template<typename Scalar>
+static void test_counter()
+{
+  typedef internal::CounterUniformRandomGenerator<Scalar> Generator;
+  Tensor<Scalar, 2> t(37, 19);
+  t = t.random(Generator(1234));
+
+  // Same seed, same tensor; each coefficient only depends on its index.
+  Tensor<Scalar, 2> u(37, 19);
+  u = u.random(Generator(1234));
+  Generator gen(1234);
+  for (int i = 0; i < t.size(); ++i) {
+    VERIFY_IS_EQUAL(t.data()[i], u.data()[i]);
+    VERIFY_IS_EQUAL(t.data()[i], gen(i));
+    VERIFY(t.data()[i] >= Scalar(0) && t.data()[i] < Scalar(1));
+  }
+
+  // Slices start at unaligned indices.
+  Tensor<Scalar, 1> v(t.size() - 3);
+  v = Tensor<Scalar, 1>(t.size()).random(Generator(1234)).slice(
+      Eigen::array<Index, 1>{{3}}, Eigen::array<Index, 1>{{t.size() - 3}});
+  for (int i = 0; i < v.size(); ++i) {
+    VERIFY_IS_EQUAL(v(i), t.data()[i + 3]);
+  }
+
+  u = u.random(Generator(4321));
+  int same = 0;
+  for (int i = 0; i < t.size(); ++i) {
+    same += t.data()[i] == u.data()[i];
+  }
+  VERIFY(same < t.size() / 10);
+}
+
 EIGEN_DECLARE_TEST(cxx11_tensor_random)
 {
   CALL_SUBTEST((test_default<float>()));
@@ -82,5 +115,8 @@ EIGEN_DECLARE_TEST(cxx11_tensor_random)
   CALL_SUBTEST((test_normal<Eigen::half>()));
   CALL_SUBTEST((test_default<Eigen::bfloat16>()));
   CALL_SUBTEST((test_normal<Eigen::bfloat16>()));
+  CALL_SUBTEST((test_counter<float>()));
+  CALL_SUBTEST((test_counter<double>()));
+  CALL_SUBTEST((test_counter<Eigen::half>()));
   CALL_SUBTEST(test_custom());
 }
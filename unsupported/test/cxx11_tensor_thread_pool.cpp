@@ -602,6 +602,229 @@ void test_multithreaded_reductions() {
 }
 
 
+template<int DataLayout>
+void test_multithreaded_large_convolution() {
+  const int num_threads = internal::random<int>(3, 11);
+  ThreadPool thread_pool(num_threads);
+  Eigen::ThreadPoolDevice thread_pool_device(&thread_pool, num_threads);
+
+  // Large enough kernels for the evaluator to use the im2col or the FFT path.
+  Tensor<float, 2, DataLayout> input(2000, 40);
+  Tensor<float, 1, DataLayout> kernel(300);
+  input.setRandom();
+  kernel.setRandom();
+  Eigen::array<ptrdiff_t, 1> dims;
+  dims[0] = 0;
+
+  Tensor<float, 2, DataLayout> result(1701, 40);
+  result = input.convolve(kernel, dims);
+  Tensor<float, 2, DataLayout> result_tp(1701, 40);
+  result_tp.device(thread_pool_device) = input.convolve(kernel, dims);
+
+  for (int i = 0; i < 1701; ++i) {
+    for (int j = 0; j < 40; ++j) {
+      VERIFY_IS_APPROX(result(i, j), result_tp(i, j));
+    }
+  }
+
+  Tensor<float, 2, DataLayout> image(300, 250);
+  Tensor<float, 2, DataLayout> filter(20, 30);
+  image.setRandom();
+  filter.setRandom();
+  Eigen::array<ptrdiff_t, 2> dims2;
+  dims2[0] = 0;
+  dims2[1] = 1;
+
+  Tensor<float, 2, DataLayout> result2 = image.convolve(filter, dims2);
+  Tensor<float, 2, DataLayout> result2_tp(281, 221);
+  result2_tp.device(thread_pool_device) = image.convolve(filter, dims2);
+
+  for (int i = 0; i < 281; ++i) {
+    for (int j = 0; j < 221; ++j) {
+      VERIFY_IS_APPROX(result2(i, j), result2_tp(i, j));
+    }
+  }
+}
+
+
+template<int DataLayout>
+void test_multithreaded_fft() {
+  const int num_threads = internal::random<int>(3, 11);
+  ThreadPool thread_pool(num_threads);
+  Eigen::ThreadPoolDevice thread_pool_device(&thread_pool, num_threads);
+
+  // Power of two and Bluestein line lengths, along contiguous and strided dimensions.
+  Tensor<float, 3, DataLayout> input(32, 23, 40);
+  input.setRandom();
+  Eigen::array<int, 3> fft_dims;
+  fft_dims[0] = 0;
+  fft_dims[1] = 1;
+  fft_dims[2] = 2;
+
+  Tensor<std::complex<float>, 3, DataLayout> spectrum = input.template fft<BothParts, FFT_FORWARD>(fft_dims);
+  Tensor<std::complex<float>, 3, DataLayout> spectrum_tp(32, 23, 40);
+  spectrum_tp.device(thread_pool_device) = input.template fft<BothParts, FFT_FORWARD>(fft_dims);
+  for (int i = 0; i < spectrum.size(); ++i) {
+    VERIFY_IS_EQUAL(spectrum(i), spectrum_tp(i));
+  }
+
+  Tensor<float, 3, DataLayout> output_tp(32, 23, 40);
+  output_tp.device(thread_pool_device) = spectrum_tp.template fft<RealPart, FFT_REVERSE>(fft_dims);
+  VERIFY_IS_APPROX(VectorXf::Map(input.data(), input.size()), VectorXf::Map(output_tp.data(), output_tp.size()));
+}
+
+template<int DataLayout>
+void test_multithreaded_scan() {
+  const int num_threads = internal::random<int>(3, 11);
+  ThreadPool thread_pool(num_threads);
+  Eigen::ThreadPoolDevice thread_pool_device(&thread_pool, num_threads);
+
+  // Fewer long scan lines along the innermost dimension than threads.
+  const int size = internal::random<int>(100000, 200000);
+  const int lines = 2;
+  const int axis = DataLayout == ColMajor ? 0 : 1;
+  Eigen::array<Index, 2> dims;
+  dims[axis] = size;
+  dims[1 - axis] = lines;
+  Tensor<int, 2, DataLayout> input(dims);
+  Tensor<float, 2, DataLayout> input_f(dims);
+  for (Index i = 0; i < input.size(); ++i) {
+    input.data()[i] = internal::random<int>(-100, 100);
+  }
+  input_f.setRandom();
+
+  for (int exclusive = 0; exclusive < 2; ++exclusive) {
+    Tensor<int, 2, DataLayout> sum = input.cumsum(axis, exclusive);
+    Tensor<int, 2, DataLayout> sum_tp(dims);
+    sum_tp.device(thread_pool_device) = input.cumsum(axis, exclusive);
+
+    Tensor<float, 2, DataLayout> max = input_f.scan(axis, internal::MaxReducer<float>(), exclusive);
+    Tensor<float, 2, DataLayout> max_tp(dims);
+    max_tp.device(thread_pool_device) = input_f.scan(axis, internal::MaxReducer<float>(), exclusive);
+    for (Index i = 0; i < input.size(); ++i) {
+      VERIFY_IS_EQUAL(sum(i), sum_tp(i));
+      VERIFY_IS_EQUAL(max(i), max_tp(i));
+    }
+  }
+}
+
+template<int DataLayout>
+void test_adaptive_scheduling() {
+  const int num_threads = internal::random<int>(3, 11);
+  ThreadPool thread_pool(num_threads);
+  Eigen::ThreadPoolDevice device(&thread_pool, num_threads);
+  device.setAdaptiveScheduling(true);
+  VERIFY(device.adaptiveScheduling());
+
+  // Every index is evaluated exactly once, in blocks starting at multiples of
+  // the alignment, including for very unbalanced blocks.
+  const Index n = internal::random<Index>(1000, 100000);
+  std::vector<std::atomic<int> > visits(n);
+  for (Index i = 0; i < n; ++i) visits[i] = 0;
+  ParallelForFeedback feedback;
+  for (int run = 0; run < 3; ++run) {
+    std::atomic<bool> aligned(true);
+    device.parallelFor(n, TensorOpCost(4, 4, 200),
+        [](Index size) { return divup<Index>(size, 16) * 16; },
+        [&](Index first, Index last) {
+          if (first % 16 != 0) aligned = false;
+          for (Index i = first; i < last; ++i) {
+            if (i % 1000 == 0) std::this_thread::sleep_for(std::chrono::microseconds(50));
+            ++visits[i];
+          }
+        }, &feedback);
+    VERIFY(aligned);
+    VERIFY(feedback.ns_per_item.load() > 0);
+  }
+  for (Index i = 0; i < n; ++i) {
+    VERIFY_IS_EQUAL(visits[i].load(), 3);
+  }
+
+  // Expressions evaluated twice, the second time with the measured cost.
+  Tensor<float, 3, DataLayout> in1(40, 50, 70);
+  Tensor<float, 3, DataLayout> in2(40, 50, 70);
+  in1.setRandom();
+  in2.setRandom();
+  Tensor<float, 3, DataLayout> out(40, 50, 70);
+  Tensor<float, 3, DataLayout> bcast(40, 50, 70);
+  Eigen::array<Index, 3> bcast_factors;
+  bcast_factors[0] = 1;
+  bcast_factors[1] = 50;
+  bcast_factors[2] = 1;
+  for (int run = 0; run < 2; ++run) {
+    out.device(device) = (in1 + in2 * 3.14f).exp();
+    bcast.device(device) = in1.slice(Eigen::array<Index, 3>{0, 0, 0}, Eigen::array<Index, 3>{40, 1, 70}).broadcast(bcast_factors);
+    for (int i = 0; i < 40; ++i) {
+      for (int j = 0; j < 50; ++j) {
+        for (int k = 0; k < 70; ++k) {
+          VERIFY_IS_APPROX(out(i, j, k), std::exp(in1(i, j, k) + in2(i, j, k) * 3.14f));
+          VERIFY_IS_EQUAL(bcast(i, j, k), in1(i, 0, k));
+        }
+      }
+    }
+  }
+}
+
+// Forwards to a pool, pretending that its threads run on two NUMA nodes.
+class TwoNodePool : public ThreadPoolInterface {
+ public:
+  explicit TwoNodePool(ThreadPoolInterface* pool) : pool_(pool) {}
+  void Schedule(std::function<void()> fn) override { pool_->Schedule(std::move(fn)); }
+  int NumThreads() const override { return pool_->NumThreads(); }
+  int CurrentThreadId() const override { return pool_->CurrentThreadId(); }
+  int NumNumaNodes() const override { return 2; }
+  int CurrentNumaNode() const override { return pool_->CurrentThreadId() < 0 ? -1 : 0; }
+
+ private:
+  ThreadPoolInterface* pool_;
+};
+
+template<int DataLayout>
+void test_numa_contraction() {
+  // Few threads, so that the contractions below are sharded by one dimension
+  // only.
+  const int num_threads = 2;
+  ThreadPool thread_pool(num_threads);
+  TwoNodePool numa_pool(&thread_pool);
+  Eigen::ThreadPoolDevice device(&numa_pool, num_threads);
+  VERIFY_IS_EQUAL(device.numNumaNodes(), 2);
+  VERIFY_IS_EQUAL(device.numaNode(), -1);
+
+  // Buffers allocated and filled by the threads of the pool.
+  std::atomic<int> allocated(0);
+  device.parallelFor(4, TensorOpCost(1e6, 1e6, 1e6), [&](Index first, Index last) {
+    for (Index i = first; i < last; ++i) {
+      float* buffer = static_cast<float*>(device.allocate(1 << 20));
+      std::fill(buffer, buffer + (1 << 18), 1.0f);
+      device.deallocate(buffer);
+      ++allocated;
+    }
+  });
+  VERIFY_IS_EQUAL(allocated.load(), 4);
+
+  // Contractions sharded by one dimension only use thread local packing
+  // buffers, which are allocated by their threads with several nodes.
+  typedef Tensor<float, 1>::DimensionPair DimPair;
+  Eigen::array<DimPair, 1> dims({{DimPair(1, 0)}});
+  const int sizes[][3] = {{2, 10000, 2}, {100000, 32, 64}, {64, 32, 100000}};
+  for (const auto& size : sizes) {
+    Tensor<float, 2, DataLayout> left(size[0], size[1]);
+    Tensor<float, 2, DataLayout> right(size[1], size[2]);
+    left.setRandom();
+    right.setRandom();
+    left += left.constant(1.5f);
+    right += right.constant(1.5f);
+
+    Tensor<float, 2, DataLayout> st_result = left.contract(right, dims);
+    Tensor<float, 2, DataLayout> tp_result(size[0], size[2]);
+    tp_result.device(device) = left.contract(right, dims);
+    for (Index i = 0; i < st_result.size(); i++) {
+      VERIFY_IS_APPROX(st_result.data()[i], tp_result.data()[i]);
+    }
+  }
+}
+
+
 void test_memcpy() {
 
   for (int i = 0; i < 5; ++i) {
@@ -629,6 +852,23 @@ void test_multithread_random()
   t.device(device) = t.random<Eigen::internal::NormalRandomGenerator<float>>();
 }
 
+void test_multithread_counter_random()
+{
+  // The counter-based generator gives the same tensor on any number of threads.
+  typedef Eigen::internal::CounterUniformRandomGenerator<float> Generator;
+  Tensor<float, 1> expected(1 << 20);
+  expected = expected.random(Generator(17));
+  for (int num_threads : {1, 3, 8}) {
+    Eigen::ThreadPool tp(num_threads);
+    Eigen::ThreadPoolDevice device(&tp, num_threads);
+    Tensor<float, 1> t(1 << 20);
+    t.device(device) = t.random(Generator(17));
+    for (int i = 0; i < t.size(); ++i) {
+      VERIFY_IS_EQUAL(t(i), expected(i));
+    }
+  }
+}
+
 template<int DataLayout>
 void test_multithread_shuffle(Allocator* allocator)
 {
@@ -710,12 +950,28 @@ EIGEN_DECLARE_TEST(cxx11_tensor_thread_pool)
 
   CALL_SUBTEST_10(test_memcpy());
   CALL_SUBTEST_10(test_multithread_random());
+  CALL_SUBTEST_10(test_multithread_counter_random());
 
   TestAllocator test_allocator;
   CALL_SUBTEST_11(test_multithread_shuffle<ColMajor>(NULL));
   CALL_SUBTEST_11(test_multithread_shuffle<RowMajor>(&test_allocator));
   CALL_SUBTEST_11(test_threadpool_allocate(&test_allocator));
 
+  CALL_SUBTEST_12(test_multithreaded_large_convolution<ColMajor>());
+  CALL_SUBTEST_12(test_multithreaded_large_convolution<RowMajor>());
+
+  CALL_SUBTEST_13(test_multithreaded_fft<ColMajor>());
+  CALL_SUBTEST_13(test_multithreaded_fft<RowMajor>());
+
+  CALL_SUBTEST_14(test_multithreaded_scan<ColMajor>());
+  CALL_SUBTEST_14(test_multithreaded_scan<RowMajor>());
+
+  CALL_SUBTEST_15(test_adaptive_scheduling<ColMajor>());
+  CALL_SUBTEST_15(test_adaptive_scheduling<RowMajor>());
+
+  CALL_SUBTEST_16(test_numa_contraction<ColMajor>());
+  CALL_SUBTEST_16(test_numa_contraction<RowMajor>());
+
   // Force CMake to split this test.
-  // EIGEN_SUFFIXES;1;2;3;4;5;6;7;8;9;10;11
+  // EIGEN_SUFFIXES;1;2;3;4;5;6;7;8;9;10;11;12;13;14;15;16
 }
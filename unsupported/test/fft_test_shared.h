@@ -8,6 +8,7 @@
 // with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include "main.h"
+#include <thread>
 #include <unsupported/Eigen/FFT>
 
 template <typename T>
@@ -196,6 +197,105 @@ void test_complex2d() {
   VERIFY((dst - dst2).norm() < test_precision<T>());
 }
 
+template <typename T>
+void test_batch(int nfft, int howmany) {
+  typedef typename FFT<T>::Complex Complex;
+  typedef Matrix<Complex, Dynamic, Dynamic> ComplexMatrix;
+  typedef Matrix<T, Dynamic, Dynamic> RealMatrix;
+  typedef Matrix<Complex, Dynamic, 1> ComplexVector;
+  typedef Matrix<T, Dynamic, 1> RealVector;
+  FFT<T> fft;
+
+  // complex columns, against the transforms of the columns one by one
+  ComplexMatrix src = ComplexMatrix::Random(nfft, howmany);
+  ComplexMatrix freq, back;
+  fft.fwdColwise(freq, src);
+  VERIFY_IS_EQUAL(freq.rows(), nfft);
+  for (int j = 0; j < howmany; ++j) {
+    ComplexVector col = src.col(j), ref;
+    fft.fwd(ref, col);
+    VERIFY(T(dif_rmse(ref, ComplexVector(freq.col(j)))) < test_precision<T>());
+  }
+  fft.invColwise(back, freq);
+  VERIFY((back - src).norm() <= test_precision<T>() * src.norm());
+
+  // rows of a strided, row-major block
+  Matrix<Complex, Dynamic, Dynamic, RowMajor> big = Matrix<Complex, Dynamic, Dynamic, RowMajor>::Random(2 * howmany + 1, 3 * nfft);
+  Map<const Matrix<Complex, Dynamic, Dynamic, RowMajor>, 0, Stride<Dynamic, Dynamic> > rows(
+      big.data() + 1, howmany, nfft, Stride<Dynamic, Dynamic>(2 * big.outerStride(), 3));
+  ComplexMatrix row_freq;
+  fft.fwdRowwise(row_freq, rows);
+  for (int i = 0; i < howmany; ++i) {
+    ComplexVector row = rows.row(i).transpose(), ref;
+    fft.fwd(ref, row);
+    VERIFY(T(dif_rmse(ref, ComplexVector(row_freq.row(i).transpose()))) < test_precision<T>());
+  }
+
+  // real columns, with and without HalfSpectrum
+  RealMatrix real_src = RealMatrix::Random(nfft, howmany), real_back;
+  fft.fwdColwise(freq, real_src);
+  VERIFY_IS_EQUAL(freq.rows(), nfft);
+  for (int j = 0; j < howmany; ++j) {
+    RealVector col = real_src.col(j);
+    ComplexVector ref;
+    fft.fwd(ref, col);
+    VERIFY(T(dif_rmse(ref, ComplexVector(freq.col(j)))) < test_precision<T>());
+  }
+  fft.invColwise(real_back, freq);
+  VERIFY((real_back - real_src).norm() <= test_precision<T>() * real_src.norm());
+
+  fft.SetFlag(fft.HalfSpectrum);
+  fft.fwdRowwise(freq, real_src.transpose());
+  VERIFY_IS_EQUAL(freq.cols(), nfft / 2 + 1);
+  if (nfft % 2 == 0) {
+    fft.invRowwise(real_back, freq);
+    VERIFY((real_back.transpose() - real_src).norm() <= test_precision<T>() * real_src.norm());
+  }
+}
+
+// Transforms many sizes from several threads, each with its own FFT objects, so that the plans
+// of the shared cache get created, used and evicted concurrently.
+template <typename T>
+void test_shared_plans() {
+  typedef typename FFT<T>::Complex Complex;
+  const int num_threads = 4;
+  const int num_sizes = 2 * EIGEN_FFT_PLAN_CACHE_SIZE;
+
+  FFT<T> warm;
+  warm.warmup(2 * 3 * 4 * 5);
+
+  std::vector<long double> errors(num_threads, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.push_back(std::thread([&errors, num_sizes, t]() {
+      for (int i = 0; i < num_sizes; ++i) {
+        const int nfft = 2 + 2 * ((i * 7 + t * 13) % num_sizes);
+        FFT<T> fft;
+        vector<Complex> in(nfft), freq, out;
+        vector<T> real_in(nfft), real_out;
+        for (int k = 0; k < nfft; ++k) {
+          in[k] = Complex(T(k % 7) - T(3), T(k % 5) - T(2));
+          real_in[k] = T(k % 11) - T(5);
+        }
+        fft.fwd(freq, in);
+        fft.inv(out, freq);
+        errors[t] = (std::max)(errors[t], dif_rmse(in, out));
+        fft.fwd(freq, real_in);
+        fft.inv(real_out, freq);
+        errors[t] = (std::max)(errors[t], dif_rmse(real_in, real_out));
+      }
+    }));
+  }
+  for (int t = 0; t < num_threads; ++t) threads[t].join();
+  for (int t = 0; t < num_threads; ++t) VERIFY(T(errors[t]) < test_precision<T>());
+
+  // The warmed up plans must still give the right transform.
+  vector<Complex> in(2 * 3 * 4 * 5), freq;
+  for (size_t k = 0; k < in.size(); ++k) in[k] = RandomCpx<T>();
+  warm.fwd(freq, in);
+  VERIFY(T(fft_rmse(freq, in)) < test_precision<T>());
+}
+
 inline void test_return_by_value(int len) {
   VectorXf in;
   VectorXf in1;
@@ -239,6 +339,23 @@ EIGEN_DECLARE_TEST(FFTW) {
   CALL_SUBTEST(test_scalar<double>(256));
   CALL_SUBTEST(test_scalar<float>(2 * 3 * 4 * 5 * 7));
   CALL_SUBTEST(test_scalar<double>(2 * 3 * 4 * 5 * 7));
+  CALL_SUBTEST(test_scalar<float>(2));
+  CALL_SUBTEST(test_scalar<double>(2));
+  CALL_SUBTEST(test_scalar<float>(2 * 3 * 5 * 7));
+  CALL_SUBTEST(test_scalar<double>(2 * 3 * 5 * 7));
+
+  CALL_SUBTEST(test_batch<float>(32, 17));
+  CALL_SUBTEST(test_batch<double>(32, 17));
+  CALL_SUBTEST(test_batch<float>(2 * 3 * 5 * 7, 9));
+  CALL_SUBTEST(test_batch<double>(2 * 3 * 5 * 7, 9));
+  CALL_SUBTEST(test_batch<float>(45, 30));
+  CALL_SUBTEST(test_batch<double>(11 * 13, 5));
+  CALL_SUBTEST(test_batch<float>(1, 3));
+
+#if !defined EIGEN_FFTW_DEFAULT && !defined EIGEN_POCKETFFT_DEFAULT && !defined EIGEN_MKL_DEFAULT
+  CALL_SUBTEST(test_shared_plans<float>());
+  CALL_SUBTEST(test_shared_plans<double>());
+#endif
 
 #if defined EIGEN_HAS_FFTWL || defined EIGEN_POCKETFFT_DEFAULT
   CALL_SUBTEST(test_complex<long double>(32));